@@ -1,10 +1,114 @@
 #include "binaryninjaapi.h"
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
 #include <string>
+#include <thread>
+#ifndef WIN32
+	#include <time.h>
+#endif
 
 using namespace BinaryNinja;
 using namespace std;
 
 
+namespace BinaryNinja
+{
+	struct ActivityProfile
+	{
+		string name;
+		atomic<uint64_t> invocations = 0;
+		atomic<uint64_t> wallTimeNs = 0;
+		atomic<uint64_t> cpuTimeNs = 0;
+		atomic<uint64_t> maxWallTimeNs = 0;
+		atomic<uint64_t> wallTimeHistogram[ActivityTimingStatistics::HistogramBuckets] = {};
+
+		mutex functionMutex;
+		unordered_map<uint64_t, ActivityFunctionTiming> functions;
+	};
+}
+
+
+namespace
+{
+	struct ActivityTraceEvent
+	{
+		ActivityProfile* profile;
+		uint64_t function;
+		uint64_t startNs;
+		uint64_t wallTimeNs;
+		uint64_t cpuTimeNs;
+		uint32_t thread;
+	};
+
+	struct ActivityProfilerState
+	{
+		atomic<bool> enabled = false;
+		atomic<bool> functionStatisticsEnabled = false;
+		atomic<bool> traceEnabled = false;
+
+		// Profiles are never freed so that Activity objects can cache a pointer to theirs
+		mutex profileMutex;
+		map<string, unique_ptr<ActivityProfile>> profiles;
+
+		mutex traceMutex;
+		vector<ActivityTraceEvent> traceEvents;
+		size_t maxTraceEvents = 0;
+		chrono::steady_clock::time_point traceEpoch = chrono::steady_clock::now();
+		atomic<uint32_t> nextThread = 1;
+	};
+}
+
+
+// This is a static in the statically linked API library, so every plugin (and the host, if it uses the C++ API) gets
+// its own profiler state. The core has no registry that modules could share it through.
+static ActivityProfilerState& GetProfilerState()
+{
+	static ActivityProfilerState* state = new ActivityProfilerState;
+	return *state;
+}
+
+
+static uint64_t GetThreadCpuTimeNs()
+{
+#ifdef WIN32
+	FILETIME creationTime, exitTime, kernelTime, userTime;
+	if (!GetThreadTimes(GetCurrentThread(), &creationTime, &exitTime, &kernelTime, &userTime))
+		return 0;
+	uint64_t kernel = ((uint64_t)kernelTime.dwHighDateTime << 32) | kernelTime.dwLowDateTime;
+	uint64_t user = ((uint64_t)userTime.dwHighDateTime << 32) | userTime.dwLowDateTime;
+	return (kernel + user) * 100;
+#else
+	timespec ts;
+	if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) != 0)
+		return 0;
+	return (uint64_t)ts.tv_sec * 1000000000 + (uint64_t)ts.tv_nsec;
+#endif
+}
+
+
+static uint32_t GetTraceThreadId()
+{
+	thread_local uint32_t thread = GetProfilerState().nextThread.fetch_add(1);
+	return thread;
+}
+
+
+static ActivityTimingStatistics GetProfileStatistics(const ActivityProfile& profile)
+{
+	ActivityTimingStatistics result;
+	result.name = profile.name;
+	result.invocations = profile.invocations.load(memory_order_relaxed);
+	result.wallTimeNs = profile.wallTimeNs.load(memory_order_relaxed);
+	result.cpuTimeNs = profile.cpuTimeNs.load(memory_order_relaxed);
+	result.maxWallTimeNs = profile.maxWallTimeNs.load(memory_order_relaxed);
+	for (size_t i = 0; i < ActivityTimingStatistics::HistogramBuckets; i++)
+		result.wallTimeHistogram[i] = profile.wallTimeHistogram[i].load(memory_order_relaxed);
+	return result;
+}
+
+
 Activity::Activity(const string& configuration, const std::function<void(Ref<AnalysisContext> analysisContext)>& action) : m_action(action)
 {
 	// LogError("API-Side Activity Constructed!");
@@ -25,12 +129,90 @@ Activity::~Activity()
 }
 
 
+ActivityProfile* Activity::GetProfile()
+{
+	ActivityProfile* profile = m_profile.load(memory_order_acquire);
+	if (profile)
+		return profile;
+
+	string name = GetName();
+	ActivityProfilerState& state = GetProfilerState();
+	{
+		unique_lock<mutex> lock(state.profileMutex);
+		unique_ptr<ActivityProfile>& entry = state.profiles[name];
+		if (!entry)
+		{
+			entry = make_unique<ActivityProfile>();
+			entry->name = name;
+		}
+		profile = entry.get();
+	}
+	m_profile.store(profile, memory_order_release);
+	return profile;
+}
+
+
 void Activity::Run(void* ctxt, BNAnalysisContext* analysisContext)
 {
 	// LogError("API-Side Activity Run!");
 	Activity* activity = (Activity*)ctxt;
 	Ref<AnalysisContext> ac = new AnalysisContext(BNNewAnalysisContextReference(analysisContext));
+
+	ActivityProfilerState& state = GetProfilerState();
+	if (!state.enabled.load(memory_order_relaxed))
+	{
+		activity->m_action(ac);
+		return;
+	}
+
+	ActivityProfile* profile = activity->GetProfile();
+	chrono::steady_clock::time_point wallStart = chrono::steady_clock::now();
+	uint64_t cpuStart = GetThreadCpuTimeNs();
 	activity->m_action(ac);
+	uint64_t cpuTime = GetThreadCpuTimeNs() - cpuStart;
+	chrono::steady_clock::time_point wallEnd = chrono::steady_clock::now();
+	uint64_t wallTime = (uint64_t)chrono::duration_cast<chrono::nanoseconds>(wallEnd - wallStart).count();
+
+	profile->invocations.fetch_add(1, memory_order_relaxed);
+	profile->wallTimeNs.fetch_add(wallTime, memory_order_relaxed);
+	profile->cpuTimeNs.fetch_add(cpuTime, memory_order_relaxed);
+	uint64_t maxWallTime = profile->maxWallTimeNs.load(memory_order_relaxed);
+	while (wallTime > maxWallTime && !profile->maxWallTimeNs.compare_exchange_weak(maxWallTime, wallTime, memory_order_relaxed))
+		;
+	size_t bucket = 0;
+	for (uint64_t us = wallTime / 1000; us > 1 && bucket < ActivityTimingStatistics::HistogramBuckets - 1; us >>= 1)
+		bucket++;
+	profile->wallTimeHistogram[bucket].fetch_add(1, memory_order_relaxed);
+
+	bool functionStatistics = state.functionStatisticsEnabled.load(memory_order_relaxed);
+	bool trace = state.traceEnabled.load(memory_order_relaxed);
+	if (!functionStatistics && !trace)
+		return;
+
+	Ref<Function> func = ac->GetFunction();
+	uint64_t function = func ? func->GetStart() : 0;
+	if (functionStatistics && func)
+	{
+		unique_lock<mutex> lock(profile->functionMutex);
+		ActivityFunctionTiming& timing = profile->functions[function];
+		timing.function = function;
+		timing.invocations++;
+		timing.wallTimeNs += wallTime;
+		timing.cpuTimeNs += cpuTime;
+	}
+
+	if (trace)
+	{
+		uint32_t thread = GetTraceThreadId();
+		unique_lock<mutex> lock(state.traceMutex);
+		if (state.traceEvents.size() < state.maxTraceEvents)
+		{
+			uint64_t start = 0;
+			if (wallStart > state.traceEpoch)
+				start = (uint64_t)chrono::duration_cast<chrono::nanoseconds>(wallStart - state.traceEpoch).count();
+			state.traceEvents.push_back({profile, func ? function : UINT64_MAX, start, wallTime, cpuTime, thread});
+		}
+	}
 }
 
 
@@ -42,3 +224,177 @@ string Activity::GetName() const
 	BNFreeString(name);
 	return result;
 }
+
+
+void ActivityProfiler::SetEnabled(bool enabled)
+{
+	GetProfilerState().enabled = enabled;
+}
+
+
+bool ActivityProfiler::IsEnabled()
+{
+	return GetProfilerState().enabled;
+}
+
+
+void ActivityProfiler::SetFunctionStatisticsEnabled(bool enabled)
+{
+	GetProfilerState().functionStatisticsEnabled = enabled;
+}
+
+
+bool ActivityProfiler::IsFunctionStatisticsEnabled()
+{
+	return GetProfilerState().functionStatisticsEnabled;
+}
+
+
+void ActivityProfiler::SetTraceEnabled(bool enabled, size_t maxEvents)
+{
+	ActivityProfilerState& state = GetProfilerState();
+	unique_lock<mutex> lock(state.traceMutex);
+	state.maxTraceEvents = maxEvents;
+	state.traceEnabled = enabled;
+}
+
+
+bool ActivityProfiler::IsTraceEnabled()
+{
+	return GetProfilerState().traceEnabled;
+}
+
+
+vector<ActivityTimingStatistics> ActivityProfiler::GetStatistics()
+{
+	ActivityProfilerState& state = GetProfilerState();
+	vector<ActivityTimingStatistics> result;
+	{
+		unique_lock<mutex> lock(state.profileMutex);
+		result.reserve(state.profiles.size());
+		for (auto& [name, profile] : state.profiles)
+		{
+			ActivityTimingStatistics statistics = GetProfileStatistics(*profile);
+			if (statistics.invocations != 0)
+				result.push_back(std::move(statistics));
+		}
+	}
+	sort(result.begin(), result.end(), [](const ActivityTimingStatistics& a, const ActivityTimingStatistics& b) {
+		return a.wallTimeNs > b.wallTimeNs;
+	});
+	return result;
+}
+
+
+optional<ActivityTimingStatistics> ActivityProfiler::GetStatistics(const string& activity)
+{
+	ActivityProfilerState& state = GetProfilerState();
+	unique_lock<mutex> lock(state.profileMutex);
+	auto i = state.profiles.find(activity);
+	if (i == state.profiles.end() || i->second->invocations.load(memory_order_relaxed) == 0)
+		return nullopt;
+	return GetProfileStatistics(*i->second);
+}
+
+
+vector<ActivityFunctionTiming> ActivityProfiler::GetFunctionStatistics(const string& activity)
+{
+	ActivityProfilerState& state = GetProfilerState();
+	ActivityProfile* profile;
+	{
+		unique_lock<mutex> lock(state.profileMutex);
+		auto i = state.profiles.find(activity);
+		if (i == state.profiles.end())
+			return {};
+		profile = i->second.get();
+	}
+
+	vector<ActivityFunctionTiming> result;
+	{
+		unique_lock<mutex> lock(profile->functionMutex);
+		result.reserve(profile->functions.size());
+		for (auto& [function, timing] : profile->functions)
+			result.push_back(timing);
+	}
+	sort(result.begin(), result.end(), [](const ActivityFunctionTiming& a, const ActivityFunctionTiming& b) {
+		return a.wallTimeNs > b.wallTimeNs;
+	});
+	return result;
+}
+
+
+string ActivityProfiler::GetChromeTrace()
+{
+	ActivityProfilerState& state = GetProfilerState();
+	vector<ActivityTraceEvent> events;
+	{
+		unique_lock<mutex> lock(state.traceMutex);
+		events = state.traceEvents;
+	}
+
+	// Activity names are quoted once rather than for every event
+	unordered_map<ActivityProfile*, string> names;
+	string result = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+	char buffer[256];
+	for (size_t i = 0; i < events.size(); i++)
+	{
+		const ActivityTraceEvent& event = events[i];
+		auto name = names.find(event.profile);
+		if (name == names.end())
+			name = names.emplace(event.profile, Json::valueToQuotedString(event.profile->name.c_str())).first;
+
+		if (i != 0)
+			result.push_back(',');
+		result += "{\"name\":";
+		result += name->second;
+		snprintf(buffer, sizeof(buffer),
+			",\"cat\":\"activity\",\"ph\":\"X\",\"pid\":1,\"tid\":%" PRIu32 ",\"ts\":%.3f,\"dur\":%.3f,\"args\":{\"cpu_us\":%.3f",
+			event.thread, event.startNs / 1000.0, event.wallTimeNs / 1000.0, event.cpuTimeNs / 1000.0);
+		result += buffer;
+		if (event.function != UINT64_MAX)
+		{
+			snprintf(buffer, sizeof(buffer), ",\"function\":\"0x%" PRIx64 "\"", event.function);
+			result += buffer;
+		}
+		result += "}}";
+	}
+	result += "]}";
+	return result;
+}
+
+
+bool ActivityProfiler::WriteChromeTrace(const string& path)
+{
+	string trace = GetChromeTrace();
+	FILE* fp = fopen(path.c_str(), "wb");
+	if (!fp)
+		return false;
+	bool ok = fwrite(trace.data(), 1, trace.size(), fp) == trace.size();
+	if (fclose(fp) != 0)
+		ok = false;
+	return ok;
+}
+
+
+void ActivityProfiler::Reset()
+{
+	ActivityProfilerState& state = GetProfilerState();
+	{
+		unique_lock<mutex> lock(state.profileMutex);
+		for (auto& [name, profile] : state.profiles)
+		{
+			profile->invocations = 0;
+			profile->wallTimeNs = 0;
+			profile->cpuTimeNs = 0;
+			profile->maxWallTimeNs = 0;
+			for (auto& count : profile->wallTimeHistogram)
+				count = 0;
+			unique_lock<mutex> functionLock(profile->functionMutex);
+			profile->functions.clear();
+		}
+	}
+
+	unique_lock<mutex> lock(state.traceMutex);
+	state.traceEvents.clear();
+	state.traceEpoch = chrono::steady_clock::now();
+}
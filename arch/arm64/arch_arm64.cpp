@@ -267,19 +267,22 @@ class Arm64Architecture : public Architecture
 	size_t m_bits;
 	bool m_onlyDisassembleOnAlignedAddresses;
 	bool m_preferIntrinsics;
+	DecodeCache<Instruction, 4> m_decodeCache;
 
 	virtual bool Disassemble(const uint8_t* data, uint64_t addr, size_t maxLen, Instruction& result)
 	{
-		(void)addr;
 		(void)maxLen;
-		memset(&result, 0, sizeof(result));
-
 		if (m_onlyDisassembleOnAlignedAddresses && (addr % 4 != 0))
+		{
+			memset(&result, 0, sizeof(result));
 			return false;
+		}
 
-		if (aarch64_decompose(*(uint32_t*)data, &result, addr) != 0)
-			return false;
-		return true;
+		return m_decodeCache.Decode(data, addr, 4, result,
+			[](const uint8_t* bytes, uint64_t address, size_t, Instruction& instr) {
+				memset(&instr, 0, sizeof(instr));
+				return aarch64_decompose(*(uint32_t*)bytes, &instr, address) == 0;
+			});
 	}
 
 
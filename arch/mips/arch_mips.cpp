@@ -182,13 +182,16 @@ protected:
 	size_t m_bits;
 	BNEndianness m_endian;
 	uint32_t m_decomposeFlags;
+	DecodeCache<Instruction, 4> m_decodeCache;
 
 	virtual bool Disassemble(const uint8_t* data, uint64_t addr, size_t maxLen, Instruction& result)
 	{
-		memset(&result, 0, sizeof(result));
-		if (mips_decompose((uint32_t*)data, maxLen,  &result, m_bits == 64 ? MIPS_64 : MIPS_32, addr, m_endian, m_decomposeFlags) != 0)
-			return false;
-		return true;
+		return m_decodeCache.Decode(data, addr, maxLen, result,
+			[this](const uint8_t* bytes, uint64_t address, size_t len, Instruction& instr) {
+				memset(&instr, 0, sizeof(instr));
+				return mips_decompose((uint32_t*)bytes, len, &instr, m_bits == 64 ? MIPS_64 : MIPS_32, address,
+					m_endian, m_decomposeFlags) == 0;
+			});
 	}
 
 	virtual size_t GetAddressSize() const override
@@ -21,6 +21,7 @@
 #define _CRT_SECURE_NO_WARNINGS
 #include <cstdio>
 #include <cstdint>
+#include <cstring>
 #include <inttypes.h>
 #include <vector>
 #include "binaryninjaapi.h"
@@ -264,6 +265,63 @@ bool Architecture::GetInstructionInfoCallback(
 }
 
 
+BNInstructionTextToken* InstructionTextToken::CreatePackedInstructionTextTokenList(
+    const vector<InstructionTextToken>& tokens)
+{
+	// The block holds the token array, then the type name arrays of every token, then every string
+	size_t nameCount = 0;
+	size_t stringSize = 0;
+	for (auto& token : tokens)
+	{
+		stringSize += token.text.size() + 1;
+		nameCount += token.typeNames.size();
+		for (auto& name : token.typeNames)
+			stringSize += name.size() + 1;
+	}
+
+	size_t tokenSize = sizeof(BNInstructionTextToken) * tokens.size();
+	size_t nameSize = sizeof(char*) * nameCount;
+	uint8_t* block = new uint8_t[tokenSize + nameSize + stringSize];
+	BNInstructionTextToken* result = (BNInstructionTextToken*)block;
+	char** names = (char**)(block + tokenSize);
+	char* strings = (char*)(block + tokenSize + nameSize);
+
+	auto packString = [&](const string& str) {
+		char* packed = strings;
+		memcpy(packed, str.c_str(), str.size() + 1);
+		strings += str.size() + 1;
+		return packed;
+	};
+
+	for (size_t i = 0; i < tokens.size(); i++)
+	{
+		const InstructionTextToken& token = tokens[i];
+		BNInstructionTextToken* converted = new (&result[i]) BNInstructionTextToken;
+		converted->type = token.type;
+		converted->text = packString(token.text);
+		converted->value = token.value;
+		converted->width = token.width;
+		converted->size = token.size;
+		converted->operand = token.operand;
+		converted->context = token.context;
+		converted->confidence = token.confidence;
+		converted->address = token.address;
+		converted->typeNames = names;
+		for (auto& name : token.typeNames)
+			*(names++) = packString(name);
+		converted->namesCount = token.typeNames.size();
+		converted->exprIndex = token.exprIndex;
+	}
+	return result;
+}
+
+
+void InstructionTextToken::FreePackedInstructionTextTokenList(BNInstructionTextToken* tokens)
+{
+	delete[] (uint8_t*)tokens;
+}
+
+
 bool Architecture::GetInstructionTextCallback(
     void* ctxt, const uint8_t* data, uint64_t addr, size_t* len, BNInstructionTextToken** result, size_t* count)
 {
@@ -279,21 +337,14 @@ bool Architecture::GetInstructionTextCallback(
 	}
 
 	*count = tokens.size();
-	*result = InstructionTextToken::CreateInstructionTextTokenList(tokens);
+	*result = InstructionTextToken::CreatePackedInstructionTextTokenList(tokens);
 	return true;
 }
 
 
-void Architecture::FreeInstructionTextCallback(BNInstructionTextToken* tokens, size_t count)
+void Architecture::FreeInstructionTextCallback(BNInstructionTextToken* tokens, size_t)
 {
-	for (size_t i = 0; i < count; i++)
-	{
-		BNFreeString(tokens[i].text);
-		for (size_t j = 0; j < tokens[j].namesCount; j++)
-			BNFreeString(tokens[i].typeNames[j]);
-		delete[] tokens[i].typeNames;
-	}
-	delete[] tokens;
+	InstructionTextToken::FreePackedInstructionTextTokenList(tokens);
 }
 
 
@@ -2466,7 +2517,7 @@ vector<DisassemblyTextLine> DisassemblyTextRenderer::PostProcessInstructionTextL
 		inLines[i].addr = lines[i].addr;
 		inLines[i].instrIndex = lines[i].instrIndex;
 		inLines[i].highlight = lines[i].highlight;
-		inLines[i].tokens = InstructionTextToken::CreateInstructionTextTokenList(lines[i].tokens);
+		inLines[i].tokens = InstructionTextToken::CreatePackedInstructionTextTokenList(lines[i].tokens);
 		inLines[i].count = lines[i].tokens.size();
 		inLines[i].tags = Tag::CreateTagList(lines[i].tags, &inLines[i].tagCount);
 	}
@@ -2478,7 +2529,7 @@ vector<DisassemblyTextLine> DisassemblyTextRenderer::PostProcessInstructionTextL
 
 	for (size_t i = 0; i < lines.size(); i++)
 	{
-		InstructionTextToken::FreeInstructionTextTokenList(inLines[i].tokens, inLines[i].count);
+		InstructionTextToken::FreePackedInstructionTextTokenList(inLines[i].tokens);
 		Tag::FreeTagList(inLines[i].tags, inLines[i].tagCount);
 	}
 	delete[] inLines;
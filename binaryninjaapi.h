@@ -27,7 +27,10 @@
 	#define FMT_UNICODE 0
 #endif
 #include <cstddef>
+#include <cstring>
+#include <algorithm>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <map>
 #include <unordered_map>
@@ -35,7 +38,9 @@
 #include <exception>
 #include <functional>
 #include <set>
+#include <iterator>
 #include <mutex>
+#include <new>
 #include <atomic>
 #include <memory>
 #include <cstdint>
@@ -149,6 +154,8 @@ namespace BinaryNinja {
 
 		T* GetObject() const { return m_object; }
 
+		static T* NewCoreReference(T* obj) { return AddObjectReference(obj); }
+
 		static T* GetObject(CoreRefCountObject* obj)
 		{
 			if (!obj)
@@ -192,6 +199,10 @@ namespace BinaryNinja {
 
 		void AddRefForCallback() { AddRefInternal(); }
 		void ReleaseForCallback() { ReleaseInternal(); }
+
+		// Used by lists that own the wrapper's storage, so that a temporary Ref to the wrapper never deletes it. The
+		// wrapper does not hold a core reference of its own, the list releases it together with the storage.
+		void AddRefForArray() { AddRefInternal(); }
 	};
 
 	/*!
@@ -384,6 +395,172 @@ namespace BinaryNinja {
 		T* GetPtr() const { return m_obj; }
 	};
 
+	/*! A non-owning handle to an object held by a list such as CoreObjectArray
+
+		Copying a BorrowedRef does not touch any reference counts. The object lives in storage owned by the list it was
+		obtained from and is destroyed with it, so Retain() is the only way to keep the object beyond that. A BorrowedRef
+		does not convert to a Ref, and a Ref made from GetPtr() must not outlive the list. Passing GetPtr() to a call
+		that only uses the object for its duration is safe.
+
+		\ingroup refcount
+	*/
+	template <class T>
+	class BorrowedRef
+	{
+		T* m_obj;
+
+	public:
+		BorrowedRef() : m_obj(nullptr) {}
+		explicit BorrowedRef(T* obj) : m_obj(obj) {}
+		explicit operator T*() const { return m_obj; }
+		explicit operator bool() const { return m_obj != nullptr; }
+		T* operator->() const { return m_obj; }
+		T& operator*() const { return *m_obj; }
+		bool operator!() const { return m_obj == nullptr; }
+		bool operator==(const T* obj) const { return T::GetObject(m_obj) == T::GetObject(obj); }
+		bool operator==(const Ref<T>& obj) const { return T::GetObject(m_obj) == T::GetObject(obj.GetPtr()); }
+		bool operator!=(const T* obj) const { return T::GetObject(m_obj) != T::GetObject(obj); }
+		bool operator!=(const Ref<T>& obj) const { return T::GetObject(m_obj) != T::GetObject(obj.GetPtr()); }
+		T* GetPtr() const { return m_obj; }
+
+		/*! Create an owning reference that outlives the list this handle was borrowed from
+
+			\return A new wrapper holding its own core reference
+		*/
+		Ref<T> Retain() const
+		{
+			if (!m_obj)
+				return nullptr;
+			return new T(T::NewCoreReference(m_obj->GetObject()));
+		}
+	};
+
+	/*! Owns a list of core objects returned by a single core call
+
+		The core list already holds one reference per element, so the wrappers are constructed in place in a single
+		allocation and handed out as BorrowedRef without any per-element reference counting. The core list and all
+		wrappers are released together when the array is destroyed.
+
+		\ingroup refcount
+	*/
+	template <class T, class CoreT, void (*FreeList)(CoreT**, size_t)>
+	class CoreObjectArray
+	{
+		CoreT** m_list = nullptr;
+		size_t m_count = 0;
+		T* m_items = nullptr;
+
+		void Clear()
+		{
+			if (m_items)
+			{
+				for (size_t i = 0; i < m_count; i++)
+					m_items[i].~T();
+				::operator delete(static_cast<void*>(m_items));
+				m_items = nullptr;
+			}
+			if (m_list)
+				FreeList(m_list, m_count);
+			m_list = nullptr;
+			m_count = 0;
+		}
+
+	public:
+		class const_iterator
+		{
+			T* m_pos;
+
+		public:
+			using iterator_category = std::random_access_iterator_tag;
+			using value_type = BorrowedRef<T>;
+			using difference_type = std::ptrdiff_t;
+			using pointer = void;
+			using reference = BorrowedRef<T>;
+
+			explicit const_iterator(T* pos) : m_pos(pos) {}
+			BorrowedRef<T> operator*() const { return BorrowedRef<T>(m_pos); }
+			BorrowedRef<T> operator[](difference_type n) const { return BorrowedRef<T>(m_pos + n); }
+			const_iterator& operator++() { ++m_pos; return *this; }
+			const_iterator operator++(int) { const_iterator result = *this; ++m_pos; return result; }
+			const_iterator& operator--() { --m_pos; return *this; }
+			const_iterator operator--(int) { const_iterator result = *this; --m_pos; return result; }
+			const_iterator& operator+=(difference_type n) { m_pos += n; return *this; }
+			const_iterator& operator-=(difference_type n) { m_pos -= n; return *this; }
+			const_iterator operator+(difference_type n) const { return const_iterator(m_pos + n); }
+			const_iterator operator-(difference_type n) const { return const_iterator(m_pos - n); }
+			difference_type operator-(const const_iterator& other) const { return m_pos - other.m_pos; }
+			bool operator==(const const_iterator& other) const { return m_pos == other.m_pos; }
+			bool operator!=(const const_iterator& other) const { return m_pos != other.m_pos; }
+			bool operator<(const const_iterator& other) const { return m_pos < other.m_pos; }
+		};
+
+		CoreObjectArray() = default;
+
+		/*! Take ownership of a list returned by the core
+
+			\param list List of core objects, freed with \c FreeList when the array is destroyed
+			\param count Number of objects in \c list
+		*/
+		CoreObjectArray(CoreT** list, size_t count) : m_list(list), m_count(list ? count : 0)
+		{
+			if (m_count == 0)
+				return;
+			m_items = static_cast<T*>(::operator new(sizeof(T) * m_count));
+			for (size_t i = 0; i < m_count; i++)
+			{
+				T* item = new (&m_items[i]) T(m_list[i]);
+				item->AddRefForArray();
+			}
+		}
+
+		CoreObjectArray(const CoreObjectArray&) = delete;
+		CoreObjectArray& operator=(const CoreObjectArray&) = delete;
+
+		CoreObjectArray(CoreObjectArray&& other) noexcept :
+		    m_list(other.m_list), m_count(other.m_count), m_items(other.m_items)
+		{
+			other.m_list = nullptr;
+			other.m_count = 0;
+			other.m_items = nullptr;
+		}
+
+		CoreObjectArray& operator=(CoreObjectArray&& other) noexcept
+		{
+			if (this != &other)
+			{
+				Clear();
+				m_list = other.m_list;
+				m_count = other.m_count;
+				m_items = other.m_items;
+				other.m_list = nullptr;
+				other.m_count = 0;
+				other.m_items = nullptr;
+			}
+			return *this;
+		}
+
+		~CoreObjectArray() { Clear(); }
+
+		size_t size() const { return m_count; }
+		bool empty() const { return m_count == 0; }
+		BorrowedRef<T> operator[](size_t i) const { return BorrowedRef<T>(&m_items[i]); }
+		const_iterator begin() const { return const_iterator(m_items); }
+		const_iterator end() const { return const_iterator(m_items + m_count); }
+
+		/*! Copy the contents into independently owned references
+
+			\return A vector of references that remain valid after this array is destroyed
+		*/
+		std::vector<Ref<T>> ToVector() const
+		{
+			std::vector<Ref<T>> result;
+			result.reserve(m_count);
+			for (size_t i = 0; i < m_count; i++)
+				result.push_back(BorrowedRef<T>(&m_items[i]).Retain());
+			return result;
+		}
+	};
+
 	/*!
 		\ingroup confidence
 	*/
@@ -553,7 +730,11 @@ namespace BinaryNinja {
 		static BNLogLevel GetLogLevelCallback(void* ctxt);
 
 	  public:
-		virtual ~LogListener() {}
+		/*! A listener that is still registered when it is destroyed unregisters itself. Messages may be delivered
+			on other threads until that happens, so listeners that are destroyed while other threads are logging
+			should be unregistered before destruction begins.
+		*/
+		virtual ~LogListener();
 
 		static void RegisterLogListener(LogListener* listener);
 		static void UnregisterLogListener(LogListener* listener);
@@ -564,6 +745,85 @@ namespace BinaryNinja {
 		virtual BNLogLevel GetLogLevel() { return WarningLog; }
 	};
 
+	/*! AsyncLogListener is a LogListener that moves message delivery off of the logging thread. Messages are copied
+		into a bounded ring buffer and handed to LogMessages in batches on a dedicated drain thread, so a slow
+		listener does not stall the threads that are logging.
+
+		Register and unregister it like any other LogListener. Derived classes must call Stop() in their destructor,
+		after unregistering and before any state used by LogMessages is destroyed. Destroying a listener whose drain
+		thread is still running aborts the process, since the thread could otherwise call into the destroyed class.
+
+		\ingroup logging
+	*/
+	class AsyncLogListener : public LogListener
+	{
+	  public:
+		struct Message
+		{
+			size_t session;
+			BNLogLevel level;
+			std::string msg;
+			std::string loggerName;
+			size_t tid;
+		};
+
+		enum OverflowPolicy
+		{
+			DropOnOverflow,  //! Discard messages that do not fit in the buffer and count them as dropped
+			BlockOnOverflow  //! Block the logging thread until the drain thread frees space in the buffer
+		};
+
+	  private:
+		struct Queue;
+		std::unique_ptr<Queue> m_queue;
+
+		void StartDrainThread();
+		void DrainThread();
+
+	  public:
+		/*! Create the listener. The drain thread is started by the first logged message, so LogMessages is never
+			called before the derived class is constructed. Derived classes must call Stop from their destructor so
+			that it is not called while they are being destroyed either.
+
+			\param capacity Number of messages the ring buffer holds, rounded up to a power of two
+			\param policy What to do with messages logged while the buffer is full
+			\param maxBatchSize Maximum number of messages passed to a single LogMessages call
+		*/
+		AsyncLogListener(size_t capacity = 4096, OverflowPolicy policy = DropOnOverflow, size_t maxBatchSize = 256);
+		virtual ~AsyncLogListener();
+
+		void LogMessage(size_t session, BNLogLevel level, const std::string& msg, const std::string& logger_name = "",
+			size_t tid = 0) final;
+
+		/*! Flushes pending messages. Derived classes overriding this should call it before closing their sink.
+		*/
+		void CloseLog() override;
+
+		/*! Receives a batch of messages in the order they were logged. Always called on the drain thread.
+
+			\param messages Messages logged since the previous batch
+		*/
+		virtual void LogMessages(const std::vector<Message>& messages) = 0;
+
+		/*! Block until every message logged before this call has been passed to LogMessages. Returns immediately when
+			called from the drain thread.
+		*/
+		void Flush();
+
+		/*! Deliver pending messages and stop the drain thread. Messages logged afterwards are dropped.
+		*/
+		void Stop();
+
+		size_t GetCapacity() const;
+		OverflowPolicy GetOverflowPolicy() const;
+
+		/*! Get the number of messages discarded because the buffer was full or the listener was stopped
+
+			\return Number of dropped messages
+		*/
+		uint64_t GetDroppedMessageCount() const;
+	};
+
 	class Architecture;
 	class BackgroundTask;
 	class Platform;
@@ -830,6 +1090,49 @@ namespace BinaryNinja {
 	*/
 	void CloseLogs();
 
+	/*! Declares the lowest log level needed by log sinks that were not registered through this API, such as the UI
+	    log view or listeners registered from Python. Messages below both this level and the level of every listener,
+	    stdout, stderr or file sink registered through this API are discarded before they are formatted.
+
+	    The core cannot report the levels of the sinks it knows about, so level gating is opt-in: the default is
+	    DebugLog, and until this is raised every message is delivered and IsLogLevelEnabled, BN_LOG and
+	    BN_LOGGER_LOG never skip anything. Hosts that own all of their log sinks, such as headless tools, can raise it
+	    so that disabled messages cost a single comparison.
+
+	    The level is kept by the statically linked API library, so it only applies to the module that sets it. A
+	    plugin, including each of the bundled view loaders, keeps delivering every message unless it declares a level
+	    of its own.
+
+	    @threadsafe
+
+	    \ingroup logging
+
+		\param level lowest level required by externally registered log sinks
+	*/
+	void SetExternalLogLevel(BNLogLevel level);
+
+	/*! Get the cached minimum level a message needs in order to be delivered to any log sink
+
+	    @threadsafe
+
+	    \ingroup logging
+
+		\return The effective minimum log level
+	*/
+	BNLogLevel GetMinimumLogLevel();
+
+	/*! Whether messages at the given level will be delivered to any log sink. This only reads a cached value and is
+	    cheap enough to guard expensive log message construction.
+
+	    @threadsafe
+
+	    \ingroup logging
+
+		\param level Level of the message
+		\return Whether a message at `level` would be logged
+	*/
+	bool IsLogLevelEnabled(BNLogLevel level);
+
 	class FileMetadata;
 	class BinaryView;
 	/*! Logger is a class allowing scoped logging to the console
@@ -1057,11 +1360,44 @@ namespace BinaryNinja {
 			*/
 			size_t GetSessionId();
 
+			/*! Whether messages at the given level will be logged
+
+	    			@threadsafe
+
+				\param level Level of the message
+				\return Whether a message at `level` would be logged
+			*/
+			bool IsLevelEnabled(BNLogLevel level);
+
 			void Indent();
 			void Dedent();
 			void ResetIndent();
 	};
 
+	/*! Logs with BinaryNinja::Log only if `level` is enabled. The format arguments are not evaluated otherwise, which
+	    makes this suitable for messages inside hot loops.
+
+	    \ingroup logging
+	*/
+#define BN_LOG(level, ...) \
+	do \
+	{ \
+		if (BinaryNinja::IsLogLevelEnabled(level)) \
+			BinaryNinja::Log(level, __VA_ARGS__); \
+	} while (0)
+
+	/*! Logs through `logger` only if `level` is enabled. Neither the logger expression nor the format arguments are
+	    evaluated otherwise.
+
+	    \ingroup logging
+	*/
+#define BN_LOGGER_LOG(logger, level, ...) \
+	do \
+	{ \
+		if (BinaryNinja::IsLogLevelEnabled(level)) \
+			(logger)->Log(level, __VA_ARGS__); \
+	} while (0)
+
 	/*! A class allowing registering and retrieving Loggers
 
 		\see BinaryView::CreateLogger
@@ -2243,6 +2579,86 @@ namespace BinaryNinja {
 		bool XzDecompress(DataBuffer& output) const;
 	};
 
+	/*! DataBufferView is a read-only, reference counted view over a range of bytes that is owned elsewhere.
+
+		Slicing a DataBufferView never copies: every slice shares ownership of the same underlying storage, which
+		stays alive until the last view referencing it is destroyed. This allows parsers to walk large tables
+		through sub-views without additional heap traffic.
+
+		\ingroup databuffer
+	*/
+	class DataBufferView
+	{
+		std::shared_ptr<const void> m_owner;
+		const uint8_t* m_data = nullptr;
+		size_t m_length = 0;
+
+	  public:
+		DataBufferView() = default;
+
+		/*! Create a view that takes ownership of a DataBuffer. The buffer contents are not copied.
+
+			\param buf DataBuffer to take ownership of
+		*/
+		DataBufferView(DataBuffer&& buf);
+
+		/*! Create a view over memory kept alive by \c owner
+
+			\param owner Object that owns the memory, held for the lifetime of the view and all of its slices
+			\param data Start of the range
+			\param len Length of the range
+		*/
+		DataBufferView(std::shared_ptr<const void> owner, const void* data, size_t len);
+
+		/*! Create a view that borrows memory without owning it. The caller must keep the memory alive and
+			unmodified for as long as the view or any of its slices are in use.
+
+			\param data Start of the range
+			\param len Length of the range
+		*/
+		static DataBufferView Borrow(const void* data, size_t len);
+
+		/*! Create a view over a range of a BinaryView. The range is read once; slices of the returned view
+			do not copy again.
+
+			\param view BinaryView to read from
+			\param offset Start address of the range
+			\param len Length of the range
+			\return View over the bytes read, which may be shorter than \c len if the range is not fully readable
+		*/
+		static DataBufferView FromBinaryView(BinaryView* view, uint64_t offset, size_t len);
+
+		const void* GetData() const { return m_data; }
+		const void* GetDataAt(size_t offset) const { return m_data + offset; }
+		size_t GetLength() const { return m_length; }
+		bool IsEmpty() const { return m_length == 0; }
+
+		const uint8_t* begin() const { return m_data; }
+		const uint8_t* end() const { return m_data + m_length; }
+
+		const uint8_t& operator[](size_t offset) const { return m_data[offset]; }
+
+		/*! Get a sub-view of this view without copying. The range is clamped to the bounds of this view.
+
+			\param start Offset of the slice within this view
+			\param len Length of the slice
+			\return A view sharing ownership of the same storage
+		*/
+		DataBufferView GetSlice(size_t start, size_t len) const;
+
+		/*! Get the contents of this view as a string_view, valid as long as this view is alive
+
+			\return string_view over the bytes of this view
+		*/
+		std::string_view ToStringView() const { return std::string_view((const char*)m_data, m_length); }
+
+		/*! Copy the contents of this view into a new DataBuffer
+
+			\return DataBuffer with a copy of the bytes of this view
+		*/
+		DataBuffer ToDataBuffer() const;
+	};
+
 	/*! TemporaryFile is used for creating temporary files, stored (temporarily) in the system's default temporary file
 	 		directory.
 
@@ -2408,6 +2824,18 @@ namespace BinaryNinja {
 		    BNInstructionTextToken* tokens, size_t count);
 		static std::vector<InstructionTextToken> ConvertInstructionTextTokenList(
 		    const BNInstructionTextToken* tokens, size_t count);
+
+		/*! Create a token list whose tokens, type name arrays and strings share a single allocation
+
+			Only use this for lists that are freed by the API itself with FreePackedInstructionTextTokenList, lists
+			handed to the core for it to free must come from CreateInstructionTextTokenList.
+
+			\param tokens Tokens to convert
+			\return Token list to be freed with FreePackedInstructionTextTokenList
+		*/
+		static BNInstructionTextToken* CreatePackedInstructionTextTokenList(
+		    const std::vector<InstructionTextToken>& tokens);
+		static void FreePackedInstructionTextTokenList(BNInstructionTextToken* tokens);
 	};
 
 	class UndoEntry;
@@ -3724,6 +4152,106 @@ namespace BinaryNinja {
 		}
 	};
 
+	/*! BatchedBinaryDataNotification coalesces function, data variable and symbol notifications and delivers them in
+		batches instead of one virtual call per event.
+
+		Events of each kind are accumulated per view and de-duplicated: a function or symbol appears at most once per
+		batch, and a data variable appears once with its most recent value. Pending events are delivered at each
+		notification barrier, once \c maxBatchSize events are pending, or once the oldest pending event is older than
+		\c maxDelayMs. Within a view, added batches are delivered before updated batches, which are delivered before
+		removed batches. An object added after being removed (or removed after being added) causes the earlier batch
+		to be delivered first, so the final state is always correct.
+
+		Other notification types requested in the constructor are delivered one at a time as usual. Pending events
+		are discarded on destruction; derived classes that need them should call Flush() after unregistering.
+
+		\ingroup binaryview
+	*/
+	class BatchedBinaryDataNotification : public BinaryDataNotification
+	{
+		struct Batches;
+		std::unique_ptr<Batches> m_batches;
+
+		void Deliver(bool wait);
+
+	  public:
+		static constexpr NotificationTypes BatchedNotifications = FunctionUpdates | DataVariableUpdates | SymbolUpdates;
+
+		/*! Create a batched notification
+
+			\param notifications Notifications to subscribe to, \c NotificationBarrier is always included
+			\param maxBatchSize Number of pending events that triggers delivery
+			\param maxDelayMs Maximum time in milliseconds an event is held before delivery
+		*/
+		BatchedBinaryDataNotification(NotificationTypes notifications = BatchedNotifications,
+		    size_t maxBatchSize = 1024, uint64_t maxDelayMs = 100);
+		virtual ~BatchedBinaryDataNotification();
+
+		/*! Deliver all pending events before returning */
+		void Flush();
+
+		size_t GetMaxBatchSize() const;
+		uint64_t GetMaxDelay() const;
+
+		uint64_t OnNotificationBarrier(BinaryView* view) override;
+
+		void OnAnalysisFunctionAdded(BinaryView* view, Function* func) final;
+		void OnAnalysisFunctionRemoved(BinaryView* view, Function* func) final;
+		void OnAnalysisFunctionUpdated(BinaryView* view, Function* func) final;
+		void OnDataVariableAdded(BinaryView* view, const DataVariable& var) final;
+		void OnDataVariableRemoved(BinaryView* view, const DataVariable& var) final;
+		void OnDataVariableUpdated(BinaryView* view, const DataVariable& var) final;
+		void OnSymbolAdded(BinaryView* view, Symbol* sym) final;
+		void OnSymbolRemoved(BinaryView* view, Symbol* sym) final;
+		void OnSymbolUpdated(BinaryView* view, Symbol* sym) final;
+
+		virtual void OnAnalysisFunctionsAdded(BinaryView* view, const std::vector<Ref<Function>>& funcs)
+		{
+			(void)view;
+			(void)funcs;
+		}
+		virtual void OnAnalysisFunctionsRemoved(BinaryView* view, const std::vector<Ref<Function>>& funcs)
+		{
+			(void)view;
+			(void)funcs;
+		}
+		virtual void OnAnalysisFunctionsUpdated(BinaryView* view, const std::vector<Ref<Function>>& funcs)
+		{
+			(void)view;
+			(void)funcs;
+		}
+		virtual void OnDataVariablesAdded(BinaryView* view, const std::vector<DataVariable>& vars)
+		{
+			(void)view;
+			(void)vars;
+		}
+		virtual void OnDataVariablesRemoved(BinaryView* view, const std::vector<DataVariable>& vars)
+		{
+			(void)view;
+			(void)vars;
+		}
+		virtual void OnDataVariablesUpdated(BinaryView* view, const std::vector<DataVariable>& vars)
+		{
+			(void)view;
+			(void)vars;
+		}
+		virtual void OnSymbolsAdded(BinaryView* view, const std::vector<Ref<Symbol>>& syms)
+		{
+			(void)view;
+			(void)syms;
+		}
+		virtual void OnSymbolsRemoved(BinaryView* view, const std::vector<Ref<Symbol>>& syms)
+		{
+			(void)view;
+			(void)syms;
+		}
+		virtual void OnSymbolsUpdated(BinaryView* view, const std::vector<Ref<Symbol>>& syms)
+		{
+			(void)view;
+			(void)syms;
+		}
+	};
+
 	/*!
 		\ingroup fileaccessor
 	*/
@@ -3765,9 +4293,69 @@ namespace BinaryNinja {
 		virtual size_t Write(uint64_t offset, const void* src, size_t len) override;
 	};
 
+	/*! A FileAccessor that serves reads directly from a memory mapping of a file on disk
+
+		The file is opened and mapped read-only. Written pages are copied into a sparse overlay that later reads are
+		served from, and are never written back to the file. Sequential access is detected from the read pattern and the
+		operating system is hinted to read ahead accordingly.
+
+		@threadsafe
+
+		\ingroup fileaccessor
+	*/
+	class MappedFileAccessor : public FileAccessor
+	{
+		struct MappedFile;
+		std::unique_ptr<MappedFile> m_file;
+
+	  public:
+		struct ResidencyStats
+		{
+			uint64_t pageSize = 0;
+			uint64_t totalPages = 0;
+			uint64_t residentPages = 0;
+			uint64_t modifiedPages = 0;
+		};
+
+		/*! Map a file for reading
+
+			\param path Path of the file to map, check IsValid to see whether mapping succeeded
+		*/
+		MappedFileAccessor(const std::string& path);
+		virtual ~MappedFileAccessor();
+
+		MappedFileAccessor(const MappedFileAccessor&) = delete;
+		MappedFileAccessor& operator=(const MappedFileAccessor&) = delete;
+
+		virtual bool IsValid() const override;
+		virtual uint64_t GetLength() const override;
+		virtual size_t Read(void* dest, uint64_t offset, size_t len) override;
+		virtual size_t Write(uint64_t offset, const void* src, size_t len) override;
+
+		/*! Whether any data has been written to the overlay
+
+			\return True if Write has modified any page of the mapping
+		*/
+		bool IsModified() const;
+
+		/*! Query how much of the mapping is currently resident in memory
+
+			\param stats Filled with page counts for the mapping
+			\return False if residency information is not available on this platform
+		*/
+		bool GetResidencyStats(ResidencyStats& stats) const;
+	};
+
 	class Function;
 	class BasicBlock;
 
+	/*!
+		\ingroup refcount
+	*/
+	using FunctionArray = CoreObjectArray<Function, BNFunction, BNFreeFunctionList>;
+	using SymbolArray = CoreObjectArray<Symbol, BNSymbol, BNFreeSymbolList>;
+	using BasicBlockArray = CoreObjectArray<BasicBlock, BNBasicBlock, BNFreeBasicBlockList>;
+
 	/*!
 
 		\ingroup namelist
@@ -3960,6 +4548,31 @@ namespace BinaryNinja {
 		static Ref<Symbol> ImportedFunctionFromImportAddressSymbol(Symbol* sym, uint64_t addr);
 	};
 
+	/*! Plain description of a symbol for \c BinaryView::DefineAutoSymbols
+
+		Unlike \c Symbol this does not own a core object, so large tables of symbols can be prepared without creating
+		a reference counted object per entry.
+
+		\ingroup types
+	*/
+	struct SymbolSpec
+	{
+		BNSymbolType type = DataSymbol;
+		std::string shortName;
+		std::string fullName;  //!< Defaults to \c shortName when empty
+		std::string rawName;  //!< Defaults to \c shortName when empty
+		uint64_t address = 0;
+		BNSymbolBinding binding = NoBinding;
+		NameSpace nameSpace = NameSpace(DEFAULT_INTERNAL_NAMESPACE);
+		uint64_t ordinal = 0;
+		Ref<Type> variableType;  //!< Type of the variable or function, used when a platform is given
+
+		SymbolSpec() = default;
+		SymbolSpec(BNSymbolType type, const std::string& name, uint64_t address, BNSymbolBinding binding = NoBinding) :
+		    type(type), shortName(name), address(address), binding(binding)
+		{}
+	};
+
 	struct FunctionViewType
 	{
 		BNFunctionGraphType type;
@@ -4831,6 +5444,38 @@ namespace BinaryNinja {
 		*/
 		DataBuffer ReadBuffer(uint64_t offset, size_t len);
 
+		/*! One range of a ReadMany request
+		*/
+		struct ReadRange
+		{
+			uint64_t address;
+			size_t length;
+			void* dest;
+			size_t bytesRead = 0;
+
+			ReadRange() : address(0), length(0), dest(nullptr) {}
+			ReadRange(uint64_t addr, size_t len, void* d) : address(addr), length(len), dest(d) {}
+			bool Succeeded() const { return bytesRead == length; }
+		};
+
+		/*! ReadMany reads a batch of unrelated ranges, filling each range's destination and \c bytesRead
+
+			Nearby ranges are coalesced into a single read, so a table of small reads costs far fewer core calls than
+			calling Read in a loop. A range that is only partially backed reports the number of bytes that were read.
+
+		    \param ranges Ranges to read, in any order
+		    \param count Number of ranges
+		    \return Number of ranges that were read completely
+		*/
+		size_t ReadMany(ReadRange* ranges, size_t count);
+
+		/*! ReadMany reads a batch of unrelated ranges, filling each range's destination and \c bytesRead
+
+		    \param ranges Ranges to read, in any order
+		    \return Number of ranges that were read completely
+		*/
+		size_t ReadMany(std::vector<ReadRange>& ranges);
+
 		/*! Write writes `len` bytes data at address `dest` to virtual address `offset`
 
 			\param offset virtual address to write to
@@ -5205,6 +5850,25 @@ namespace BinaryNinja {
 		*/
 		std::vector<Ref<Function>> GetAnalysisFunctionList();
 
+		/*! Get the functions within this BinaryView as a single array-owning list
+
+			Elements are handed out as BorrowedRef and are only valid for the lifetime of the returned array.
+
+		    \return FunctionArray of Functions within the BinaryView
+		*/
+		FunctionArray GetAnalysisFunctionArray();
+
+		/*! Visit each function within this BinaryView without creating a wrapper object for each of them
+
+			Walks the array returned by GetAnalysisFunctionArray. The core returns the whole list in one call, so
+			the array is not paged. The function passed to \c callback is borrowed from that array and is only
+			valid for the duration of the call, use BorrowedRef::Retain to keep it.
+
+			\param callback Called for each function, return false to stop early
+			\return false if \c callback stopped the iteration, true otherwise
+		*/
+		bool ForEachAnalysisFunction(const std::function<bool(BorrowedRef<Function> func)>& callback);
+
 		/*! Check whether the BinaryView has any functions defined
 
 		    \return Whether the BinaryView has any functions defined
@@ -5289,6 +5953,26 @@ namespace BinaryNinja {
 		*/
 		std::vector<ReferenceSource> GetCodeReferences(uint64_t addr, uint64_t len);
 
+		/*! Visit each reference made from code (instructions) to a virtual address without building a list of them
+
+			Consecutive references from the same function share a single \c Function object.
+
+			\param addr Address to check
+			\param callback Called for each reference, return false to stop early
+			\return false if \c callback stopped the iteration, true otherwise
+		*/
+		bool ForEachCodeReference(uint64_t addr, const std::function<bool(const ReferenceSource& ref)>& callback);
+
+		/*! Visit each reference made from code (instructions) to a range of addresses without building a list of them
+
+			\param addr Start of the range to check
+			\param len Length of the range
+			\param callback Called for each reference, return false to stop early
+			\return false if \c callback stopped the iteration, true otherwise
+		*/
+		bool ForEachCodeReference(
+		    uint64_t addr, uint64_t len, const std::function<bool(const ReferenceSource& ref)>& callback);
+
 		/*! Get code references made by a particular "ReferenceSource"
 
 			A ReferenceSource contains a given function, architecture of that function, and an address within it.
@@ -5325,6 +6009,23 @@ namespace BinaryNinja {
 		*/
 		std::vector<uint64_t> GetDataReferences(uint64_t addr, uint64_t len);
 
+		/*! Visit each reference made by data ('DataVariables') to a virtual address without copying them into a list
+
+			\param addr Address to check
+			\param callback Called with the address of each reference, return false to stop early
+			\return false if \c callback stopped the iteration, true otherwise
+		*/
+		bool ForEachDataReference(uint64_t addr, const std::function<bool(uint64_t ref)>& callback);
+
+		/*! Visit each reference made by data ('DataVariables') to a range of addresses without copying them into a list
+
+			\param addr Start of the range to check
+			\param len Length of the range
+			\param callback Called with the address of each reference, return false to stop early
+			\return false if \c callback stopped the iteration, true otherwise
+		*/
+		bool ForEachDataReference(uint64_t addr, uint64_t len, const std::function<bool(uint64_t ref)>& callback);
+
 		/*! Get references made by data ('DataVariables') located at a virtual address.
 
 		    \param src reference source
@@ -5571,6 +6272,50 @@ namespace BinaryNinja {
 		*/
 		std::vector<Ref<Symbol>> GetSymbols(uint64_t start, uint64_t len, const NameSpace& nameSpace = NameSpace());
 
+		/*! Retrieves the symbols as a single array-owning list
+
+			Elements are handed out as BorrowedRef and are only valid for the lifetime of the returned array.
+
+			\param nameSpace The optional namespace of the symbols to retrieve
+			\return SymbolArray of symbols
+		*/
+		SymbolArray GetSymbolArray(const NameSpace& nameSpace = NameSpace());
+
+		/*! Retrieves the symbols in a given range as a single array-owning list
+
+			\param start Virtual address start of the range
+			\param len Length of the range
+			\param nameSpace The optional namespace of the symbols to retrieve
+			\return SymbolArray of symbols in the range
+		*/
+		SymbolArray GetSymbolArray(uint64_t start, uint64_t len, const NameSpace& nameSpace = NameSpace());
+
+		/*! Visit each Symbol without creating a wrapper object for each of them
+
+			Walks the array returned by GetSymbolArray. The core returns the whole list in one call, so the array
+			is not paged. The symbol passed to \c callback is borrowed from that array and is only valid for the
+			duration of the call, use BorrowedRef::Retain to keep it.
+
+			\param callback Called for each symbol, return false to stop early
+			\param nameSpace The optional namespace of the symbols to visit
+			\return false if \c callback stopped the iteration, true otherwise
+		*/
+		bool ForEachSymbol(
+		    const std::function<bool(BorrowedRef<Symbol> sym)>& callback, const NameSpace& nameSpace = NameSpace());
+
+		/*! Visit each Symbol in a given range without creating a wrapper object for each of them
+
+			The symbol passed to \c callback is borrowed in the same way as for the overload without a range.
+
+			\param start Virtual address start of the range
+			\param len Length of the range
+			\param callback Called for each symbol, return false to stop early
+			\param nameSpace The optional namespace of the symbols to visit
+			\return false if \c callback stopped the iteration, true otherwise
+		*/
+		bool ForEachSymbol(uint64_t start, uint64_t len, const std::function<bool(BorrowedRef<Symbol> sym)>& callback,
+		    const NameSpace& nameSpace = NameSpace());
+
 		/*! Retrieves a list of all Symbol objects of the provided symbol type
 
 			\param type The symbol type
@@ -5614,6 +6359,31 @@ namespace BinaryNinja {
 		*/
 		Ref<Symbol> DefineAutoSymbolAndVariableOrFunction(Ref<Platform> platform, Ref<Symbol> sym, Ref<Type> type);
 
+		/*! Defines a list of "Auto" symbols
+
+			This is equivalent to calling \c DefineAutoSymbol (or \c DefineAutoSymbolAndVariableOrFunction when
+			\c platform is given) for each entry in order, without creating a \c Symbol object per entry. Callers
+			defining many symbols should still do so between \c BeginBulkModifySymbols and \c EndBulkModifySymbols.
+
+			\param symbols Symbols to define
+			\param platform Optional platform, when given a variable or function is defined alongside each symbol
+		*/
+		void DefineAutoSymbols(const std::vector<SymbolSpec>& symbols, Ref<Platform> platform = nullptr);
+
+		/*! Resolves and defines a list of "Auto" symbols
+
+			\c resolve is called once for each index in <tt>[0, count)</tt>, concurrently on the worker thread pool and the
+			calling thread, to fill in the symbol at that index. Entries for which \c resolve returns false are skipped. Symbols are then defined
+			in index order as with \c DefineAutoSymbols. This is intended for loaders that need to demangle large
+			symbol tables.
+
+			\param count Number of symbols to resolve
+			\param resolve Callback to fill in the symbol for an index, must be thread safe
+			\param platform Optional platform, when given a variable or function is defined alongside each symbol
+		*/
+		void DefineAutoSymbols(size_t count, const std::function<bool(size_t index, SymbolSpec& symbol)>& resolve,
+		    Ref<Platform> platform = nullptr);
+
 		/*! Undefine an automatically defined symbol
 
 			\param sym The symbol to undefine
@@ -7255,6 +8025,22 @@ namespace BinaryNinja {
 		Ref<BinaryView> m_view;
 		BNBinaryReader* m_stream;
 
+		// Read-ahead window, only used when buffering is enabled with SetBufferSize
+		std::vector<uint8_t> m_buffer;
+		uint64_t m_bufferStart = 0;
+		size_t m_bufferLength = 0;
+		uint64_t m_bufferGeneration = 0;
+		uint64_t m_offset = 0;
+		BNEndianness m_endian;
+		size_t m_addressSize = 0;
+
+		bool IsBuffered() const { return !m_buffer.empty(); }
+		void SyncPosition() const;
+		bool FillBuffer(size_t minLength);
+		bool BufferedRead(void* dest, size_t len);
+		template <typename T>
+		bool BufferedReadValue(T& result, BNEndianness endian);
+
 	  public:
 		/*! Create a BinaryReader instance given a BinaryView and endianness.
 
@@ -7556,10 +8342,37 @@ namespace BinaryNinja {
 		*/
 		void SetVirtualBase(uint64_t base);
 
-		/*! Whether the current cursor position is at the end of the file.
+		/*! Whether the current cursor position is at the end of the file.
+
+		*/
+		bool IsEndOfFile() const;
+
+		/*! Enable or disable buffered reading.
+
+			When a buffer size is set, the reader fetches a window of that many bytes with a single read from
+			the view and serves subsequent reads from memory until the cursor leaves the window. This greatly
+			reduces the cost of parsing large tables with many small reads. Writes made through BinaryWriter or
+			BinaryView::Write on any view discard the window, but writes made outside of the C++ API (for
+			example from Python) are not tracked; call FlushBuffer after those.
+
+			\param size Size of the read-ahead window in bytes, or 0 to disable buffering
+		*/
+		void SetBufferSize(size_t size);
+
+		/*! Get the size of the read-ahead window
+
+			\return The size of the read-ahead window in bytes, or 0 if buffering is disabled
+		*/
+		size_t GetBufferSize() const;
+
+		/*! Discard the contents of the read-ahead window so that the next read fetches fresh data
+		*/
+		void FlushBuffer();
 
+		/*! Discard the read-ahead windows of all buffered readers. Called automatically by BinaryWriter and
+			the BinaryView write methods.
 		*/
-		bool IsEndOfFile() const;
+		static void InvalidateBuffers();
 	};
 
 	/*! Raised whenever a write is performed out of bounds.
@@ -7779,6 +8592,39 @@ namespace BinaryNinja {
 		size_t fixedLength;  // Variable length if zero
 	};
 
+	/*! Incremental state of a streaming decode or encode, created by Transform::BeginDecode or Transform::BeginEncode
+
+		Input is fed in chunks with Update, and any output that is ready is appended to the output buffer passed in, so
+		the caller may consume and clear it between calls.
+
+		\ingroup transform
+	*/
+	class TransformContext
+	{
+	  public:
+		virtual ~TransformContext() {}
+
+		/*! Feed the next chunk of input
+
+			\param data Pointer to the input chunk
+			\param len Length of the input chunk
+			\param output Buffer that any ready output is appended to
+			\return Whether the input was accepted
+		*/
+		virtual bool Update(const void* data, size_t len, DataBuffer& output) = 0;
+		bool Update(const DataBuffer& input, DataBuffer& output)
+		{
+			return Update(input.GetData(), input.GetLength(), output);
+		}
+
+		/*! Signal the end of input and produce the remaining output
+
+			\param output Buffer that the remaining output is appended to
+			\return Whether the complete input was transformed successfully
+		*/
+		virtual bool Finish(DataBuffer& output) = 0;
+	};
+
 	/*! Allows users to implement custom transformations.
 
 	    New transformations may be added at runtime, so an instance of a transform is created like
@@ -7843,6 +8689,27 @@ namespace BinaryNinja {
 		    const std::map<std::string, DataBuffer>& params = std::map<std::string, DataBuffer>());
 		virtual bool Encode(const DataBuffer& input, DataBuffer& output,
 		    const std::map<std::string, DataBuffer>& params = std::map<std::string, DataBuffer>());
+
+		/*! Start a streaming decode
+
+			The default implementation collects the input and runs Decode when the context is finished. Transforms that
+			can produce output incrementally should override this.
+
+			\param params Transform parameters
+			\return Context to feed the input to
+		*/
+		virtual std::unique_ptr<TransformContext> BeginDecode(
+		    const std::map<std::string, DataBuffer>& params = std::map<std::string, DataBuffer>());
+
+		/*! Start a streaming encode
+
+			The default implementation collects the input and runs Encode when the context is finished.
+
+			\param params Transform parameters
+			\return Context to feed the input to
+		*/
+		virtual std::unique_ptr<TransformContext> BeginEncode(
+		    const std::map<std::string, DataBuffer>& params = std::map<std::string, DataBuffer>());
 	};
 
 	/*!
@@ -7854,12 +8721,48 @@ namespace BinaryNinja {
 		CoreTransform(BNTransform* xform);
 		virtual std::vector<TransformParameter> GetParameters() const override;
 
+		/*! Start a streaming decode. The core's xz transform is decoded with an XzDecodeContext, all others collect
+			the input and run Decode when the context is finished.
+
+			\param params Transform parameters
+			\return Context to feed the input to
+		*/
+		virtual std::unique_ptr<TransformContext> BeginDecode(
+		    const std::map<std::string, DataBuffer>& params = std::map<std::string, DataBuffer>()) override;
+
 		virtual bool Decode(const DataBuffer& input, DataBuffer& output,
 		    const std::map<std::string, DataBuffer>& params = std::map<std::string, DataBuffer>()) override;
 		virtual bool Encode(const DataBuffer& input, DataBuffer& output,
 		    const std::map<std::string, DataBuffer>& params = std::map<std::string, DataBuffer>()) override;
 	};
 
+	/*! Streaming decoder for the xz container format
+
+		Blocks whose headers record their compressed and uncompressed sizes (as written by multithreaded xz encoders)
+		are split out as they arrive and decompressed in parallel on the worker thread pool, and their output is produced
+		in order. Only the stream header and the blocks waiting to be decompressed are kept in memory. A block that does
+		not record its sizes cannot be split, so the input from that block on is kept and decompressed when the context
+		is finished. Concatenated streams and stream padding are supported.
+
+		\ingroup transform
+	*/
+	class XzDecodeContext : public TransformContext
+	{
+		struct DecoderState;
+		std::unique_ptr<DecoderState> m_state;
+
+	  public:
+		/*!
+			\param batchSize Number of blocks collected before they are decompressed together, or 0 to use one per
+				worker thread
+		*/
+		XzDecodeContext(size_t batchSize = 0);
+		virtual ~XzDecodeContext();
+
+		virtual bool Update(const void* data, size_t len, DataBuffer& output) override;
+		virtual bool Finish(DataBuffer& output) override;
+	};
+
 	struct InstructionInfo : public BNInstructionInfo
 	{
 		InstructionInfo();
@@ -8457,6 +9360,128 @@ namespace BinaryNinja {
 		void AddArchitectureRedirection(Architecture* from, Architecture* to);
 	};
 
+	/*! Per-thread cache of decoded instructions for Architecture plugins
+
+		The core usually asks for the info, text and IL of an instruction in quick succession, and each call would
+		otherwise decode the same bytes again. An architecture opts in by holding a DecodeCache for its decoded
+		instruction type and routing its decoder through Decode. Entries are keyed on the address and the instruction
+		bytes, so patched code never returns a stale result. \c MaxLength must cover every byte the decoder reads.
+
+		\ingroup architectures
+	*/
+	template <typename T, size_t MaxLength = 16, size_t Entries = 64>
+	class DecodeCache
+	{
+		static_assert(std::is_trivially_copyable<T>::value, "Decoded instructions must be trivially copyable");
+		static_assert((Entries & (Entries - 1)) == 0, "Entry count must be a power of two");
+		static_assert(MaxLength <= 0xff, "Instruction length must fit in a byte");
+
+		struct Entry
+		{
+			uint64_t owner;
+			uint64_t address;
+			uint8_t length;
+			uint8_t bytes[MaxLength];
+			T value;
+		};
+
+		struct ThreadCache
+		{
+			Entry entries[Entries] = {};
+		};
+
+		static inline std::atomic<uint64_t> s_nextId {1};
+
+		uint64_t m_id;
+#ifdef NDEBUG
+		std::atomic<bool> m_statisticsEnabled {false};
+#else
+		std::atomic<bool> m_statisticsEnabled {true};
+#endif
+		std::atomic<uint64_t> m_hits {0};
+		std::atomic<uint64_t> m_misses {0};
+
+		static ThreadCache& GetThreadCache()
+		{
+			// Allocated on first use so threads that never decode do not pay for the table
+			thread_local std::unique_ptr<ThreadCache> cache;
+			if (!cache)
+				cache = std::make_unique<ThreadCache>();
+			return *cache;
+		}
+
+	  public:
+		struct Statistics
+		{
+			uint64_t hits;
+			uint64_t misses;
+		};
+
+		DecodeCache() : m_id(s_nextId.fetch_add(1, std::memory_order_relaxed)) {}
+		DecodeCache(const DecodeCache&) = delete;
+		DecodeCache& operator=(const DecodeCache&) = delete;
+
+		/*! Decode an instruction, reusing the result of an earlier decode of the same bytes at the same address
+
+			\param data Instruction bytes
+			\param addr Address of the instruction
+			\param len Number of bytes available at \c data
+			\param result Receives the decoded instruction
+			\param decoder Called as <tt>decoder(data, addr, len, result)</tt> on a miss, returns whether decoding
+			succeeded. Failed decodes are not cached.
+			\return Whether the instruction was decoded
+		*/
+		template <typename Decoder>
+		bool Decode(const uint8_t* data, uint64_t addr, size_t len, T& result, Decoder&& decoder)
+		{
+			size_t keyLength = std::min(len, MaxLength);
+			Entry& entry = GetThreadCache().entries[((addr * 0x9e3779b97f4a7c15ull) >> 32) & (Entries - 1)];
+			if (entry.owner == m_id && entry.address == addr && entry.length == keyLength
+			    && std::memcmp(entry.bytes, data, keyLength) == 0)
+			{
+				result = entry.value;
+				if (m_statisticsEnabled.load(std::memory_order_relaxed))
+					m_hits.fetch_add(1, std::memory_order_relaxed);
+				return true;
+			}
+
+			if (m_statisticsEnabled.load(std::memory_order_relaxed))
+				m_misses.fetch_add(1, std::memory_order_relaxed);
+			if (!decoder(data, addr, len, result))
+				return false;
+
+			entry.owner = m_id;
+			entry.address = addr;
+			entry.length = (uint8_t)keyLength;
+			std::memcpy(entry.bytes, data, keyLength);
+			entry.value = result;
+			return true;
+		}
+
+		/*! Enable or disable hit and miss counting
+
+			Counting is off by default in release builds to keep lookups free of shared writes.
+
+			\param enabled Whether lookups should be counted
+		*/
+		void SetStatisticsEnabled(bool enabled) { m_statisticsEnabled.store(enabled, std::memory_order_relaxed); }
+
+		/*! Get the hit and miss counts recorded while statistics were enabled
+
+			\return Hit and miss counts across all threads
+		*/
+		Statistics GetStatistics() const
+		{
+			return {m_hits.load(std::memory_order_relaxed), m_misses.load(std::memory_order_relaxed)};
+		}
+
+		void ResetStatistics()
+		{
+			m_hits.store(0, std::memory_order_relaxed);
+			m_misses.store(0, std::memory_order_relaxed);
+		}
+	};
+
 	/*!
 
 	 	\ingroup architectures
@@ -9915,27 +10940,77 @@ namespace BinaryNinja {
 
 		bool Inform(const std::string& request);
 
+		/*! One element of a typed Inform request
+
+			String arguments are referenced, not copied, so they must outlive the Inform call.
+		*/
+		class InformArgument
+		{
+		  public:
+			enum Kind
+			{
+				StringArgument,
+				IntegerArgument,
+				ArchitectureArgument
+			};
+
+		  private:
+			Kind m_kind;
+			std::string_view m_string;
+			uint64_t m_integer = 0;
+			Architecture* m_arch = nullptr;
+
+		  public:
+			InformArgument(const char* str) : m_kind(StringArgument), m_string(str ? str : "") {}
+			InformArgument(const std::string& str) : m_kind(StringArgument), m_string(str) {}
+			InformArgument(std::string_view str) : m_kind(StringArgument), m_string(str) {}
+			template <typename T, typename = std::enable_if_t<std::is_integral_v<T>>>
+			InformArgument(T val) : m_kind(IntegerArgument), m_integer((uint64_t)val)
+			{}
+			InformArgument(Architecture* arch) : m_kind(ArchitectureArgument), m_arch(arch) {}
+			InformArgument(const Ref<Architecture>& arch) : m_kind(ArchitectureArgument), m_arch(arch.GetPtr()) {}
+
+			Kind GetKind() const { return m_kind; }
+			std::string_view GetString() const { return m_string; }
+			uint64_t GetInteger() const { return m_integer; }
+			Architecture* GetArchitecture() const { return m_arch; }
+		};
+
+		/*! Send a request built from typed arguments
+
+			The request is serialized directly into a reused buffer, without building an intermediate Json::Value.
+
+			\param args Request arguments
+			\param count Number of arguments
+			\return Whether the request was accepted
+		*/
+		bool InformArguments(const InformArgument* args, size_t count);
+
+		/*! Serialize typed arguments into the JSON array that InformArguments sends to the core
+
+			\param args Request arguments
+			\param count Number of arguments
+			\param request String that receives the request, its previous contents are replaced
+		*/
+		static void SerializeInformRequest(const InformArgument* args, size_t count, std::string& request);
+
 #if ((__cplusplus >= 201403L) || (_MSVC_LANG >= 201703L))
 		template <typename... Args>
 		bool Inform(Args... args)
 		{
-			// using T = std::variant<Args...>; // FIXME: remove type duplicates
-			using T = std::variant<std::string, const char*, uint64_t, Ref<Architecture>>;
-			std::vector<T> unpackedArgs {args...};
-			Json::Value request(Json::arrayValue);
-			for (auto& arg : unpackedArgs)
-				std::visit(overload {[&](Ref<Architecture> arch) { request.append(Json::Value(arch->GetName())); },
-				               [&](uint64_t val) { request.append(Json::Value(val)); },
-				               [&](auto& val) {
-					               request.append(Json::Value(std::forward<decltype(val)>(val)));
-				               }},
-				    arg);
-
-			return Inform(Json::writeString(m_builder, request));
+			if constexpr (sizeof...(Args) == 0)
+				return InformArguments(nullptr, 0);
+			else
+			{
+				const InformArgument unpackedArgs[] {InformArgument(args)...};
+				return InformArguments(unpackedArgs, sizeof...(Args));
+			}
 		}
 #endif
 	};
 
+	struct ActivityProfile;
+
 	/*!
 		\ingroup workflow
 	*/
@@ -9943,8 +11018,10 @@ namespace BinaryNinja {
 	{
 	  protected:
 		std::function<void(Ref<AnalysisContext> analysisContext)> m_action;
+		std::atomic<ActivityProfile*> m_profile = nullptr;
 
 		static void Run(void* ctxt, BNAnalysisContext* analysisContext);
+		ActivityProfile* GetProfile();
 
 	  public:
 		/*!
@@ -9962,6 +11039,112 @@ namespace BinaryNinja {
 		std::string GetName() const;
 	};
 
+	/*! Aggregate timing for every invocation of one Activity
+
+		\ingroup workflow
+	*/
+	struct ActivityTimingStatistics
+	{
+		static constexpr size_t HistogramBuckets = 32;
+
+		std::string name;
+		uint64_t invocations = 0;
+		uint64_t wallTimeNs = 0;
+		uint64_t cpuTimeNs = 0;
+		uint64_t maxWallTimeNs = 0;
+		//! Invocation count by wall time, bucket i holds durations in [2^i, 2^(i+1)) microseconds and bucket 0 anything shorter
+		uint64_t wallTimeHistogram[HistogramBuckets] = {};
+	};
+
+	/*! Timing for the invocations of one Activity on a single function
+
+		\ingroup workflow
+	*/
+	struct ActivityFunctionTiming
+	{
+		uint64_t function = 0;
+		uint64_t invocations = 0;
+		uint64_t wallTimeNs = 0;
+		uint64_t cpuTimeNs = 0;
+	};
+
+	/*! ActivityProfiler records how long each API-side Activity action takes to run.
+
+		Profiling is off by default, so activities run without timing overhead. After SetEnabled(true), invocation
+		counts, wall time and CPU time are collected. Per-function breakdowns and trace events are additionally opt-in,
+		since they grow with the size of the analysis. Activities implemented inside the core do not run through the API
+		and are not covered.
+
+		The profiler state lives in the C++ API library, which every plugin links statically. Each plugin therefore has
+		its own profiler that only sees the activities that plugin registered, and its settings and results are not
+		visible to other plugins or to the UI. To profile a plugin's activities, enable and query ActivityProfiler from
+		code in that same plugin, for example from a plugin command that writes the Chrome trace.
+
+		\ingroup workflow
+	*/
+	class ActivityProfiler
+	{
+	  public:
+		/*! Enable or disable all activity timing. Disabled by default.
+
+			\param enabled Whether activity invocations are timed
+		*/
+		static void SetEnabled(bool enabled);
+		static bool IsEnabled();
+
+		/*! Enable or disable per-function timing, see GetFunctionStatistics
+
+			\param enabled Whether to record timing per analyzed function
+		*/
+		static void SetFunctionStatisticsEnabled(bool enabled);
+		static bool IsFunctionStatisticsEnabled();
+
+		/*! Enable or disable recording of individual invocations for GetChromeTrace
+
+			\param enabled Whether to record trace events
+			\param maxEvents Events recorded after this limit is reached are dropped
+		*/
+		static void SetTraceEnabled(bool enabled, size_t maxEvents = 1000000);
+		static bool IsTraceEnabled();
+
+		/*! Get the timing statistics of every activity that has run, slowest first
+
+			\return Statistics for each activity
+		*/
+		static std::vector<ActivityTimingStatistics> GetStatistics();
+
+		/*! Get the timing statistics of a single activity
+
+			\param activity Activity name
+			\return Statistics for the activity, or std::nullopt if it has not run
+		*/
+		static std::optional<ActivityTimingStatistics> GetStatistics(const std::string& activity);
+
+		/*! Get the per-function timing of an activity, slowest first. Requires SetFunctionStatisticsEnabled.
+
+			\param activity Activity name
+			\return Timing for each function the activity ran on
+		*/
+		static std::vector<ActivityFunctionTiming> GetFunctionStatistics(const std::string& activity);
+
+		/*! Get the recorded invocations in the Chrome trace event JSON format, viewable in chrome://tracing or
+			Perfetto. Requires SetTraceEnabled.
+
+			\return Trace event JSON
+		*/
+		static std::string GetChromeTrace();
+
+		/*! Write the output of GetChromeTrace to a file
+
+			\param path Output file path
+			\return true on success, false otherwise
+		*/
+		static bool WriteChromeTrace(const std::string& path);
+
+		/*! Clear all collected statistics and trace events */
+		static void Reset();
+	};
+
 	class WorkflowMachine
 	{
 		Ref<BinaryView> m_view;
@@ -10650,6 +11833,14 @@ namespace BinaryNinja {
 		*/
 		std::vector<Ref<BasicBlock>> GetBasicBlocks() const;
 
+		/*! Get the Basic Blocks for this function as a single array-owning list
+
+			Elements are handed out as BorrowedRef and are only valid for the lifetime of the returned array.
+
+			\return BasicBlockArray of the blocks in this function
+		*/
+		BasicBlockArray GetBasicBlockArray() const;
+
 		/*! Get the basic block an address is located in
 
 			\param arch Architecture for the basic block
@@ -11312,6 +12503,13 @@ namespace BinaryNinja {
 		*/
 		void AddOutgoingEdge(BNBranchType type, FlowGraphNode* target, BNEdgeStyle edgeStyle = BNEdgeStyle());
 
+		/*! Set the route of an outgoing edge, for use by custom FlowGraphLayout implementations
+
+			\param edgeNum Index of the edge in GetOutgoingEdges
+			\param points Points along the edge, from this node to the target
+		*/
+		void SetOutgoingEdgePoints(size_t edgeNum, const std::vector<BNPoint>& points);
+
 		/*! Get the highlight color for the node
 
 			\return The highlight color for the node
@@ -11581,6 +12779,90 @@ namespace BinaryNinja {
 		virtual bool Layout(Ref<FlowGraph> graph, std::vector<Ref<FlowGraphNode>>& nodes) override;
 	};
 
+	struct LayeredFlowGraphLayoutCache;
+
+	/*! LayeredFlowGraphLayout is a Sugiyama-style layered layout for control flow graphs.
+
+		Layout runs in the usual phases: back edges are found with a depth first search from the entry node, nodes
+		are assigned to layers by longest path in linear time, long edges are split into chains of virtual nodes,
+		crossings are reduced with alternating barycenter sweeps that stop once a sweep no longer improves the crossing
+		count, and coordinates are assigned by balancing each node between its neighbors.
+
+		The result for each graph is cached. Laying out a graph with the same blocks and edges again, for example after
+		an edit changed the contents of one block, only reassigns coordinates. When blocks or edges change, the
+		previous ordering seeds crossing reduction so that the graph stays stable and converges quickly.
+
+		The layout is not registered automatically, plugins that want it call FlowGraphLayout::Register.
+
+		\ingroup flowgraph
+	*/
+	class LayeredFlowGraphLayout : public FlowGraphLayout
+	{
+		std::shared_ptr<LayeredFlowGraphLayoutCache> m_cache;
+
+	  public:
+		/*! Graph description used by LayoutGraph, with nodes and edges in flat arrays */
+		struct Graph
+		{
+			std::vector<int> nodeWidths;
+			std::vector<int> nodeHeights;
+			//! Stable identity of each node across layouts, such as the basic block start
+			std::vector<uint64_t> nodeKeys;
+			//! Outgoing edges of node i are edgeTargets[edgeStarts[i]] to edgeTargets[edgeStarts[i + 1] - 1]
+			std::vector<size_t> edgeStarts;
+			std::vector<size_t> edgeTargets;
+			int horizontalMargin = 16;
+			int verticalMargin = 16;
+
+			//! Outputs, node 0 is placed in the first layer
+			std::vector<int> nodeX;
+			std::vector<int> nodeY;
+			std::vector<std::vector<BNPoint>> edgePoints;
+			int width = 0;
+			int height = 0;
+		};
+
+		/*! Identifies the graph a cached layout belongs to */
+		struct CacheKey
+		{
+			//! Identity of the view the graph was built from, such as the address of its core object
+			uint64_t view = 0;
+			//! Start of the function the graph shows
+			uint64_t function = 0;
+			BNFunctionGraphType graphType = NormalFunctionGraph;
+
+			bool operator==(const CacheKey& other) const
+			{
+				return view == other.view && function == other.function && graphType == other.graphType;
+			}
+		};
+
+		struct Statistics
+		{
+			bool reusedLayering = false;
+			bool seededOrdering = false;
+			size_t layers = 0;
+			size_t virtualNodes = 0;
+			size_t crossings = 0;
+			size_t sweeps = 0;
+		};
+
+		LayeredFlowGraphLayout(const std::string& name = "layered");
+
+		virtual bool Layout(Ref<FlowGraph> graph, std::vector<Ref<FlowGraphNode>>& nodes) override;
+
+		/*! Lay out a graph without going through a FlowGraph
+
+			\param graph Graph to lay out, the output fields are filled in
+			\param cacheKey If set, results are cached under this key and reused by later calls with the same key
+			\return Statistics for the layout
+		*/
+		Statistics LayoutGraph(Graph& graph, std::optional<CacheKey> cacheKey = std::nullopt);
+
+		/*! Discard all cached layouts */
+		void ClearCache();
+	};
+
 	/*!
 		\ingroup lowlevelil
 	*/
@@ -11625,6 +12907,8 @@ namespace BinaryNinja {
 	class LowLevelILFunction :
 	    public CoreRefCountObject<BNLowLevelILFunction, BNNewLowLevelILFunctionReference, BNFreeLowLevelILFunction>
 	{
+		std::optional<std::vector<BNLowLevelILInstruction>> m_exprSnapshot;
+
 	  public:
 		LowLevelILFunction(Architecture* arch, Function* func = nullptr);
 		LowLevelILFunction(BNLowLevelILFunction* func);
@@ -12918,6 +14202,30 @@ namespace BinaryNinja {
 		size_t GetInstructionCount() const;
 		size_t GetExprCount() const;
 
+		/*! Copy every expression of this function into a contiguous local array.
+
+			Once a snapshot exists, GetRawExpr and every LowLevelILInstruction accessor created from this object
+			read from the local array instead of querying the core for each expression. This makes whole-function
+			walks (hashing, custom analyses, lifters that read back their output) considerably cheaper. The
+			snapshot is discarded by any modification made through this object; modifications made through another
+			LowLevelILFunction object referring to the same function are not detected.
+
+			@threadunsafe
+
+			\return The expressions of this function, indexed by expression index
+		*/
+		const std::vector<BNLowLevelILInstruction>& GetExprSnapshot();
+
+		/*! Whether this object currently holds an expression snapshot
+
+			\return Whether a snapshot created by GetExprSnapshot is active
+		*/
+		bool HasExprSnapshot() const { return m_exprSnapshot.has_value(); }
+
+		/*! Discard the expression snapshot created by GetExprSnapshot
+		*/
+		void ReleaseExprSnapshot() { m_exprSnapshot.reset(); }
+
 		void UpdateInstructionOperand(size_t i, size_t operandIndex, ExprId value);
 		void ReplaceExpr(size_t expr, size_t newExpr);
 		void SetExprAttributes(size_t expr, uint32_t attributes);
@@ -16375,6 +17683,122 @@ namespace BinaryNinja {
 		static std::vector<Ref<BackgroundTask>> GetRunningTasks();
 	};
 
+	struct TaskGroupState;
+
+	/*! TaskGroup runs a set of tasks on the worker thread pool and waits for all of them to complete.
+
+		Tasks are kept in per-thread queues owned by the group. Worker threads enqueued through WorkerEnqueue take tasks
+		from their own queue first and steal from the others once it is empty. A thread waiting on the group runs queued
+		tasks itself instead of blocking, so tasks may create and wait on nested groups without exhausting the pool.
+
+		If a BackgroundTask is provided, cancelling it cancels the group, and progress reported through AddProgress is
+		shown in its progress text.
+
+		\code{.cpp}
+		TaskGroup group(task, "Scanning RTTI");
+		for (auto& section : sections)
+			group.Run([&, section]() { ScanSection(section); });
+		group.Wait();
+		\endcode
+
+		@threadsafe
+		\ingroup mainthread
+	*/
+	class TaskGroup
+	{
+		std::shared_ptr<TaskGroupState> m_state;
+
+	  public:
+		/*!
+			\param task Optional background task used for cancellation and progress reporting
+			\param progressText Text shown in the background task before the progress count
+		*/
+		TaskGroup(BackgroundTask* task = nullptr, const std::string& progressText = "");
+		TaskGroup(const TaskGroup&) = delete;
+		TaskGroup& operator=(const TaskGroup&) = delete;
+
+		/*! Waits for all tasks to complete. Exceptions thrown by tasks are discarded, call Wait to observe them. */
+		~TaskGroup();
+
+		/*! Queue a task to run on the worker thread pool
+
+			\param task Function to run
+		*/
+		void Run(const std::function<void()>& task);
+
+		/*! Run queued tasks on the calling thread until every task in the group has completed. If a task threw
+			an exception, the group is cancelled and the first exception is rethrown here.
+		*/
+		void Wait();
+
+		/*! Cancel the group. Queued tasks that have not started are discarded, running tasks should poll IsCancelled. */
+		void Cancel();
+
+		/*! Whether the group or its background task has been cancelled
+
+			\return true if cancelled
+		*/
+		bool IsCancelled() const;
+
+		/*! Set the amount of work expected, in caller-defined units
+
+			\param total Total units of work
+		*/
+		void SetProgressTotal(uint64_t total);
+
+		/*! Report completed work, in the units given to SetProgressTotal
+
+			\param completed Units of work completed since the last call
+		*/
+		void AddProgress(uint64_t completed = 1);
+
+		/*! Get the completed and total units of work
+
+			\return Pair of completed and total units
+		*/
+		std::pair<uint64_t, uint64_t> GetProgress() const;
+	};
+
+	/*! Call `func` for every index in [begin, end) in parallel on the worker thread pool, returning once all calls
+		have completed. Indices are processed in chunks of `grainSize`, or in about eight chunks per worker thread if
+		`grainSize` is zero. Cancelling `task` skips the chunks that have not started yet.
+
+		\param begin First index
+		\param end One past the last index
+		\param func Function taking the index to process
+		\param task Optional background task used for cancellation and progress reporting
+		\param progressText Text shown in the background task before the progress count
+		\param grainSize Number of indices processed per task
+		\ingroup mainthread
+	*/
+	template <typename Func>
+	void ParallelFor(size_t begin, size_t end, const Func& func, BackgroundTask* task = nullptr,
+	    const std::string& progressText = "", size_t grainSize = 0)
+	{
+		if (begin >= end)
+			return;
+
+		size_t count = end - begin;
+		if (grainSize == 0)
+			grainSize = std::max<size_t>(1, count / (std::max<size_t>(1, GetWorkerThreadCount()) * 8));
+
+		TaskGroup group(task, progressText);
+		group.SetProgressTotal(count);
+		for (size_t chunk = begin; chunk < end; chunk += std::min(grainSize, end - chunk))
+		{
+			size_t chunkEnd = chunk + std::min(grainSize, end - chunk);
+			group.Run([&func, &group, chunk, chunkEnd]() {
+				// With a background task, IsCancelled calls into the core, so it is checked per chunk rather than per index
+				if (group.IsCancelled())
+					return;
+				for (size_t i = chunk; i < chunkEnd; i++)
+					func(i);
+				group.AddProgress(chunkEnd - chunk);
+			});
+		}
+		group.Wait();
+	}
+
 	/*!
 		\ingroup interaction
 	*/
@@ -18,13 +18,36 @@
 // FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
 // IN THE SOFTWARE.
 
+#include <algorithm>
+#include <cstring>
 #include "binaryninjaapi.h"
 
 using namespace BinaryNinja;
 using namespace std;
 
 
-BinaryReader::BinaryReader(BinaryView* data, BNEndianness endian) : m_view(data)
+static std::atomic<uint64_t> g_bufferGeneration = 0;
+
+
+template <typename T>
+static T LoadValue(const uint8_t* data, BNEndianness endian)
+{
+	T result = 0;
+	if (endian == LittleEndian)
+	{
+		for (size_t i = 0; i < sizeof(T); i++)
+			result |= (T)data[i] << (8 * i);
+	}
+	else
+	{
+		for (size_t i = 0; i < sizeof(T); i++)
+			result = (T)((result << 8) | data[i]);
+	}
+	return result;
+}
+
+
+BinaryReader::BinaryReader(BinaryView* data, BNEndianness endian) : m_view(data), m_endian(endian)
 {
 	m_stream = BNCreateBinaryReader(data->GetObject());
 	BNSetBinaryReaderEndianness(m_stream, endian);
@@ -37,21 +60,132 @@ BinaryReader::~BinaryReader()
 }
 
 
+void BinaryReader::SyncPosition() const
+{
+	BNSeekBinaryReader(m_stream, m_offset);
+}
+
+
+bool BinaryReader::FillBuffer(size_t minLength)
+{
+	m_bufferLength = 0;
+	m_bufferStart = m_offset;
+	m_bufferGeneration = g_bufferGeneration.load(std::memory_order_acquire);
+
+	// A full window can fail near the end of a readable region, so retry with smaller windows
+	// until the window no longer covers the requested range.
+	size_t size = m_buffer.size();
+	while (true)
+	{
+		SyncPosition();
+		if (BNReadData(m_stream, m_buffer.data(), size))
+		{
+			m_bufferLength = size;
+			return true;
+		}
+		if (size <= minLength)
+			return false;
+		size = std::max(size / 2, minLength);
+	}
+}
+
+
+bool BinaryReader::BufferedRead(void* dest, size_t len)
+{
+	if (m_bufferGeneration != g_bufferGeneration.load(std::memory_order_acquire))
+		m_bufferLength = 0;
+
+	uint64_t start = m_offset - m_bufferStart;
+	if ((m_offset < m_bufferStart) || (start > m_bufferLength) || (len > (m_bufferLength - start)))
+	{
+		if (len > m_buffer.size())
+		{
+			// Larger than the window, read directly without disturbing it
+			SyncPosition();
+			if (!BNReadData(m_stream, dest, len))
+				return false;
+			m_offset += len;
+			return true;
+		}
+
+		if (!FillBuffer(len))
+			return false;
+		start = 0;
+	}
+
+	memcpy(dest, &m_buffer[start], len);
+	m_offset += len;
+	return true;
+}
+
+
+template <typename T>
+bool BinaryReader::BufferedReadValue(T& result, BNEndianness endian)
+{
+	uint8_t data[sizeof(T)];
+	if (!BufferedRead(data, sizeof(T)))
+		return false;
+	result = LoadValue<T>(data, endian);
+	return true;
+}
+
+
+void BinaryReader::SetBufferSize(size_t size)
+{
+	if (size == 0)
+	{
+		if (IsBuffered())
+			SyncPosition();
+		m_buffer.clear();
+		m_buffer.shrink_to_fit();
+		m_bufferLength = 0;
+		return;
+	}
+
+	if (!IsBuffered())
+	{
+		m_offset = BNGetReaderPosition(m_stream);
+		m_addressSize = m_view->GetAddressSize();
+	}
+	m_buffer.resize(size);
+	m_bufferLength = 0;
+}
+
+
+size_t BinaryReader::GetBufferSize() const
+{
+	return m_buffer.size();
+}
+
+
+void BinaryReader::FlushBuffer()
+{
+	m_bufferLength = 0;
+}
+
+
+void BinaryReader::InvalidateBuffers()
+{
+	g_bufferGeneration.fetch_add(1, std::memory_order_acq_rel);
+}
+
+
 BNEndianness BinaryReader::GetEndianness() const
 {
-	return BNGetBinaryReaderEndianness(m_stream);
+	return m_endian;
 }
 
 
 void BinaryReader::SetEndianness(BNEndianness endian)
 {
+	m_endian = endian;
 	BNSetBinaryReaderEndianness(m_stream, endian);
 }
 
 
 void BinaryReader::Read(void* dest, size_t len)
 {
-	if (!BNReadData(m_stream, dest, len))
+	if (!TryRead(dest, len))
 		throw ReadException();
 }
 
@@ -66,15 +200,16 @@ DataBuffer BinaryReader::Read(size_t len)
 
 string BinaryReader::ReadString(size_t len)
 {
-	DataBuffer result = Read(len);
-	return string((const char*)result.GetData(), len);
+	string result(len, '\0');
+	Read(result.data(), len);
+	return result;
 }
 
 
 uint8_t BinaryReader::Read8()
 {
 	uint8_t result;
-	if (!BNRead8(m_stream, &result))
+	if (!TryRead8(result))
 		throw ReadException();
 	return result;
 }
@@ -83,7 +218,7 @@ uint8_t BinaryReader::Read8()
 uint16_t BinaryReader::Read16()
 {
 	uint16_t result;
-	if (!BNRead16(m_stream, &result))
+	if (!TryRead16(result))
 		throw ReadException();
 	return result;
 }
@@ -92,7 +227,7 @@ uint16_t BinaryReader::Read16()
 uint32_t BinaryReader::Read32()
 {
 	uint32_t result;
-	if (!BNRead32(m_stream, &result))
+	if (!TryRead32(result))
 		throw ReadException();
 	return result;
 }
@@ -101,7 +236,7 @@ uint32_t BinaryReader::Read32()
 uint64_t BinaryReader::Read64()
 {
 	uint64_t result;
-	if (!BNRead64(m_stream, &result))
+	if (!TryRead64(result))
 		throw ReadException();
 	return result;
 }
@@ -109,7 +244,7 @@ uint64_t BinaryReader::Read64()
 
 uint64_t BinaryReader::ReadPointer()
 {
-	size_t addressSize = m_view->GetAddressSize();
+	size_t addressSize = IsBuffered() ? m_addressSize : m_view->GetAddressSize();
 	if (addressSize > 8 || addressSize == 0)
 		throw ReadException();
 
@@ -123,7 +258,7 @@ uint64_t BinaryReader::ReadPointer()
 uint16_t BinaryReader::ReadLE16()
 {
 	uint16_t result;
-	if (!BNReadLE16(m_stream, &result))
+	if (!TryReadLE16(result))
 		throw ReadException();
 	return result;
 }
@@ -132,7 +267,7 @@ uint16_t BinaryReader::ReadLE16()
 uint32_t BinaryReader::ReadLE32()
 {
 	uint32_t result;
-	if (!BNReadLE32(m_stream, &result))
+	if (!TryReadLE32(result))
 		throw ReadException();
 	return result;
 }
@@ -141,7 +276,7 @@ uint32_t BinaryReader::ReadLE32()
 uint64_t BinaryReader::ReadLE64()
 {
 	uint64_t result;
-	if (!BNReadLE64(m_stream, &result))
+	if (!TryReadLE64(result))
 		throw ReadException();
 	return result;
 }
@@ -149,45 +284,8 @@ uint64_t BinaryReader::ReadLE64()
 uint64_t BinaryReader::ReadLEPointer()
 {
 	uint64_t result;
-	size_t addressSize = m_view->GetAddressSize();
-	switch (addressSize)
-	{
-		case 1:
-		{
-			uint8_t r;
-			if (!BNRead8(m_stream, &r))
-				throw ReadException();
-			result = r;
-			break;
-		}
-		case 2:
-		{
-			uint16_t r;
-			if (!BNReadLE16(m_stream, &r))
-				throw ReadException();
-			result = r;
-			break;
-		}
-		case 4:
-		{
-			uint32_t r;
-			if (!BNReadLE32(m_stream, &r))
-				throw ReadException();
-			result = r;
-			break;
-		}
-		case 8:
-		{
-			if (!BNReadLE64(m_stream, &result))
-				throw ReadException();
-			break;
-		}
-		default:
-		{
-			throw ReadException();
-			break;
-		}
-	}
+	if (!TryReadLEPointer(result))
+		throw ReadException();
 	return result;
 }
 
@@ -195,7 +293,7 @@ uint64_t BinaryReader::ReadLEPointer()
 uint16_t BinaryReader::ReadBE16()
 {
 	uint16_t result;
-	if (!BNReadBE16(m_stream, &result))
+	if (!TryReadBE16(result))
 		throw ReadException();
 	return result;
 }
@@ -204,7 +302,7 @@ uint16_t BinaryReader::ReadBE16()
 uint32_t BinaryReader::ReadBE32()
 {
 	uint32_t result;
-	if (!BNReadBE32(m_stream, &result))
+	if (!TryReadBE32(result))
 		throw ReadException();
 	return result;
 }
@@ -213,7 +311,7 @@ uint32_t BinaryReader::ReadBE32()
 uint64_t BinaryReader::ReadBE64()
 {
 	uint64_t result;
-	if (!BNReadBE64(m_stream, &result))
+	if (!TryReadBE64(result))
 		throw ReadException();
 	return result;
 }
@@ -222,51 +320,16 @@ uint64_t BinaryReader::ReadBE64()
 uint64_t BinaryReader::ReadBEPointer()
 {
 	uint64_t result;
-	size_t addressSize = m_view->GetAddressSize();
-	switch (addressSize)
-	{
-		case 1:
-		{
-			uint8_t r;
-			if (!BNRead8(m_stream, &r))
-				throw ReadException();
-			result = r;
-			break;
-		}
-		case 2:
-		{
-			uint16_t r;
-			if (!BNReadBE16(m_stream, &r))
-				throw ReadException();
-			result = r;
-			break;
-		}
-		case 4:
-		{
-			uint32_t r;
-			if (!BNReadBE32(m_stream, &r))
-				throw ReadException();
-			result = r;
-			break;
-		}
-		case 8:
-		{
-			if (!BNReadBE64(m_stream, &result))
-				throw ReadException();
-			break;
-		}
-		default:
-		{
-			throw ReadException();
-			break;
-		}
-	}
+	if (!TryReadBEPointer(result))
+		throw ReadException();
 	return result;
 }
 
 
 bool BinaryReader::TryRead(void* dest, size_t len)
 {
+	if (IsBuffered())
+		return BufferedRead(dest, len);
 	return BNReadData(m_stream, dest, len);
 }
 
@@ -280,71 +343,91 @@ bool BinaryReader::TryRead(DataBuffer& dest, size_t len)
 
 bool BinaryReader::TryReadString(string& dest, size_t len)
 {
-	DataBuffer result(len);
-	if (!TryRead(result.GetData(), len))
+	string result(len, '\0');
+	if (!TryRead(result.data(), len))
 		return false;
-	dest = string((const char*)result.GetData(), len);
+	dest = std::move(result);
 	return true;
 }
 
 
 bool BinaryReader::TryRead8(uint8_t& result)
 {
+	if (IsBuffered())
+		return BufferedRead(&result, 1);
 	return BNRead8(m_stream, &result);
 }
 
 
 bool BinaryReader::TryRead16(uint16_t& result)
 {
+	if (IsBuffered())
+		return BufferedReadValue(result, m_endian);
 	return BNRead16(m_stream, &result);
 }
 
 
 bool BinaryReader::TryRead32(uint32_t& result)
 {
+	if (IsBuffered())
+		return BufferedReadValue(result, m_endian);
 	return BNRead32(m_stream, &result);
 }
 
 
 bool BinaryReader::TryRead64(uint64_t& result)
 {
+	if (IsBuffered())
+		return BufferedReadValue(result, m_endian);
 	return BNRead64(m_stream, &result);
 }
 
 
 bool BinaryReader::TryReadPointer(uint64_t& result)
 {
+	if (IsBuffered())
+	{
+		if (m_endian == BigEndian)
+			return TryReadBEPointer(result);
+		return TryReadLEPointer(result);
+	}
 	return BNReadPointer(m_view->GetObject(), m_stream, &result);
 }
 
 
 bool BinaryReader::TryReadLE16(uint16_t& result)
 {
+	if (IsBuffered())
+		return BufferedReadValue(result, LittleEndian);
 	return BNReadLE16(m_stream, &result);
 }
 
 
 bool BinaryReader::TryReadLE32(uint32_t& result)
 {
+	if (IsBuffered())
+		return BufferedReadValue(result, LittleEndian);
 	return BNReadLE32(m_stream, &result);
 }
 
 
 bool BinaryReader::TryReadLE64(uint64_t& result)
 {
+	if (IsBuffered())
+		return BufferedReadValue(result, LittleEndian);
 	return BNReadLE64(m_stream, &result);
 }
 
 
 bool BinaryReader::TryReadLEPointer(uint64_t& result)
 {
-	size_t addressSize = m_view->GetAddressSize();
+	size_t addressSize = IsBuffered() ? m_addressSize : m_view->GetAddressSize();
 	switch (addressSize)
 	{
 		case 1:
 		{
 			uint8_t r;
-			if (!BNRead8(m_stream, &r))
+			if (!TryRead8(r))
 				return false;
 			result = r;
 			break;
@@ -352,7 +435,7 @@ bool BinaryReader::TryReadLEPointer(uint64_t& result)
 		case 2:
 		{
 			uint16_t r;
-			if (!BNReadLE16(m_stream, &r))
+			if (!TryReadLE16(r))
 				return false;
 			result = r;
 			break;
@@ -360,14 +443,14 @@ bool BinaryReader::TryReadLEPointer(uint64_t& result)
 		case 4:
 		{
 			uint32_t r;
-			if (!BNReadLE32(m_stream, &r))
+			if (!TryReadLE32(r))
 				return false;
 			result = r;
 			break;
 		}
 		case 8:
 		{
-			if (!BNReadLE64(m_stream, &result))
+			if (!TryReadLE64(result))
 				return false;
 			break;
 		}
@@ -382,18 +465,24 @@ bool BinaryReader::TryReadLEPointer(uint64_t& result)
 
 bool BinaryReader::TryReadBE16(uint16_t& result)
 {
+	if (IsBuffered())
+		return BufferedReadValue(result, BigEndian);
 	return BNReadBE16(m_stream, &result);
 }
 
 
 bool BinaryReader::TryReadBE32(uint32_t& result)
 {
+	if (IsBuffered())
+		return BufferedReadValue(result, BigEndian);
 	return BNReadBE32(m_stream, &result);
 }
 
 
 bool BinaryReader::TryReadBE64(uint64_t& result)
 {
+	if (IsBuffered())
+		return BufferedReadValue(result, BigEndian);
 	return BNReadBE64(m_stream, &result);
 }
 
@@ -401,13 +490,13 @@ bool BinaryReader::TryReadBE64(uint64_t& result)
 
 bool BinaryReader::TryReadBEPointer(uint64_t& result)
 {
-	size_t addressSize = m_view->GetAddressSize();
+	size_t addressSize = IsBuffered() ? m_addressSize : m_view->GetAddressSize();
 	switch (addressSize)
 	{
 		case 1:
 		{
 			uint8_t r;
-			if (!BNRead8(m_stream, &r))
+			if (!TryRead8(r))
 				return false;
 			result = r;
 			break;
@@ -415,7 +504,7 @@ bool BinaryReader::TryReadBEPointer(uint64_t& result)
 		case 2:
 		{
 			uint16_t r;
-			if (!BNReadBE16(m_stream, &r))
+			if (!TryReadBE16(r))
 				return false;
 			result = r;
 			break;
@@ -423,14 +512,14 @@ bool BinaryReader::TryReadBEPointer(uint64_t& result)
 		case 4:
 		{
 			uint32_t r;
-			if (!BNReadBE32(m_stream, &r))
+			if (!TryReadBE32(r))
 				return false;
 			result = r;
 			break;
 		}
 		case 8:
 		{
-			if (!BNReadBE64(m_stream, &result))
+			if (!TryReadBE64(result))
 				return false;
 			break;
 		}
@@ -445,18 +534,30 @@ bool BinaryReader::TryReadBEPointer(uint64_t& result)
 
 uint64_t BinaryReader::GetOffset() const
 {
+	if (IsBuffered())
+		return m_offset;
 	return BNGetReaderPosition(m_stream);
 }
 
 
 void BinaryReader::Seek(uint64_t offset)
 {
+	if (IsBuffered())
+	{
+		m_offset = offset;
+		return;
+	}
 	BNSeekBinaryReader(m_stream, offset);
 }
 
 
 void BinaryReader::SeekRelative(int64_t offset)
 {
+	if (IsBuffered())
+	{
+		m_offset += offset;
+		return;
+	}
 	BNSeekBinaryReaderRelative(m_stream, offset);
 }
 
@@ -468,12 +569,23 @@ uint64_t BinaryReader::GetVirtualBase()
 
 void BinaryReader::SetVirtualBase(uint64_t base)
 {
+	if (IsBuffered())
+	{
+		// The virtual base changes how offsets map to the view, so the window is no longer valid
+		SyncPosition();
+		BNSetBinaryReaderVirtualBase(m_stream, base);
+		m_offset = BNGetReaderPosition(m_stream);
+		m_bufferLength = 0;
+		return;
+	}
 	BNSetBinaryReaderVirtualBase(m_stream, base);
 }
 
 
 bool BinaryReader::IsEndOfFile() const
 {
+	if (IsBuffered())
+		SyncPosition();
 	return BNIsEndOfFile(m_stream);
 }
 
@@ -499,19 +611,12 @@ vector<T> BinaryReader::ReadVector(size_t count)
 string BinaryReader::ReadCString(size_t maxSize)
 {
 	string result;
-	try
-	{
-		for (size_t i = 0; i < maxSize; i++)
-		{
-			char cur = Read8();
-			if (cur == 0)
-				break;
-			result.push_back(cur);
-		}
-	}
-	catch (ReadException&)
+	for (size_t i = 0; i < maxSize; i++)
 	{
-		;
+		uint8_t cur;
+		if (!TryRead8(cur) || cur == 0)
+			break;
+		result.push_back((char)cur);
 	}
 	return result;
 }
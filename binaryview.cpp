@@ -19,8 +19,13 @@
 // IN THE SOFTWARE.
 
 #include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
 #include <iterator>
 #include <memory>
+#include <mutex>
 #include "binaryninjaapi.h"
 
 using namespace BinaryNinja;
@@ -650,6 +655,238 @@ BinaryDataNotification::BinaryDataNotification(NotificationTypes notifications)
 }
 
 
+namespace
+{
+	enum BatchKind
+	{
+		BatchAdded = 0,
+		BatchUpdated,
+		BatchRemoved,
+		BatchKindCount
+	};
+
+	template <typename Key, typename Value>
+	struct CoalescedBatch
+	{
+		vector<Value> items;
+		unordered_map<Key, size_t> index;
+
+		bool Contains(Key key) const { return index.find(key) != index.end(); }
+
+		// Returns true if the value is new to this batch, otherwise the pending entry is replaced by the newer value
+		bool Add(Key key, const Value& value)
+		{
+			auto i = index.emplace(key, items.size());
+			if (!i.second)
+			{
+				items[i.first->second] = value;
+				return false;
+			}
+			items.push_back(value);
+			return true;
+		}
+	};
+
+	struct ViewBatches
+	{
+		Ref<BinaryView> view;
+		CoalescedBatch<BNFunction*, Ref<Function>> functions[BatchKindCount];
+		CoalescedBatch<uint64_t, DataVariable> variables[BatchKindCount];
+		CoalescedBatch<BNSymbol*, Ref<Symbol>> symbols[BatchKindCount];
+	};
+}
+
+
+struct BatchedBinaryDataNotification::Batches
+{
+	size_t maxBatchSize;
+	chrono::milliseconds maxDelay;
+
+	mutex pendingMutex;
+	unordered_map<BNBinaryView*, ViewBatches> views;
+	size_t pending = 0;
+	chrono::steady_clock::time_point oldest;
+
+	// Held while delivering so that batches reach the callbacks in the order they were taken. Recursive so that
+	// callbacks which cause further notifications, or call Flush, do not deadlock.
+	recursive_mutex deliveryMutex;
+
+	ViewBatches& GetView(BinaryView* view)
+	{
+		auto& result = views[view->GetObject()];
+		if (!result.view)
+			result.view = view;
+		return result;
+	}
+
+	// Returns true when pending events should be delivered now
+	bool Added()
+	{
+		auto now = chrono::steady_clock::now();
+		if (pending++ == 0)
+			oldest = now;
+		return (pending >= maxBatchSize) || ((now - oldest) >= maxDelay);
+	}
+};
+
+
+BatchedBinaryDataNotification::BatchedBinaryDataNotification(
+    NotificationTypes notifications, size_t maxBatchSize, uint64_t maxDelayMs) :
+    BinaryDataNotification(notifications | NotificationBarrier), m_batches(make_unique<Batches>())
+{
+	m_batches->maxBatchSize = std::max<size_t>(maxBatchSize, 1);
+	m_batches->maxDelay = chrono::milliseconds(maxDelayMs);
+}
+
+
+BatchedBinaryDataNotification::~BatchedBinaryDataNotification() {}
+
+
+size_t BatchedBinaryDataNotification::GetMaxBatchSize() const
+{
+	return m_batches->maxBatchSize;
+}
+
+
+uint64_t BatchedBinaryDataNotification::GetMaxDelay() const
+{
+	return m_batches->maxDelay.count();
+}
+
+
+void BatchedBinaryDataNotification::Deliver(bool wait)
+{
+	unique_lock<recursive_mutex> deliveryLock(m_batches->deliveryMutex, defer_lock);
+	if (wait)
+		deliveryLock.lock();
+	else if (!deliveryLock.try_lock())
+		return;  // Another thread is delivering and will pick these up on its next flush
+
+	unordered_map<BNBinaryView*, ViewBatches> views;
+	{
+		unique_lock<mutex> lock(m_batches->pendingMutex);
+		views.swap(m_batches->views);
+		m_batches->pending = 0;
+	}
+
+	for (auto& [handle, batches] : views)
+	{
+		BinaryView* view = batches.view;
+		if (!batches.functions[BatchAdded].items.empty())
+			OnAnalysisFunctionsAdded(view, batches.functions[BatchAdded].items);
+		if (!batches.variables[BatchAdded].items.empty())
+			OnDataVariablesAdded(view, batches.variables[BatchAdded].items);
+		if (!batches.symbols[BatchAdded].items.empty())
+			OnSymbolsAdded(view, batches.symbols[BatchAdded].items);
+
+		if (!batches.functions[BatchUpdated].items.empty())
+			OnAnalysisFunctionsUpdated(view, batches.functions[BatchUpdated].items);
+		if (!batches.variables[BatchUpdated].items.empty())
+			OnDataVariablesUpdated(view, batches.variables[BatchUpdated].items);
+		if (!batches.symbols[BatchUpdated].items.empty())
+			OnSymbolsUpdated(view, batches.symbols[BatchUpdated].items);
+
+		if (!batches.functions[BatchRemoved].items.empty())
+			OnAnalysisFunctionsRemoved(view, batches.functions[BatchRemoved].items);
+		if (!batches.variables[BatchRemoved].items.empty())
+			OnDataVariablesRemoved(view, batches.variables[BatchRemoved].items);
+		if (!batches.symbols[BatchRemoved].items.empty())
+			OnSymbolsRemoved(view, batches.symbols[BatchRemoved].items);
+	}
+}
+
+
+void BatchedBinaryDataNotification::Flush()
+{
+	Deliver(true);
+}
+
+
+uint64_t BatchedBinaryDataNotification::OnNotificationBarrier(BinaryView*)
+{
+	Deliver(true);
+	return m_batches->maxDelay.count();
+}
+
+
+// Queues an event, delivering pending events first if the object has a pending event of the opposite lifetime kind
+// so that an add followed by a remove (or the reverse) is observed in order
+#define BATCH_NOTIFICATION(batchMember, kind, oppositeKind, key, value) \
+	do \
+	{ \
+		bool deliverNow; \
+		{ \
+			unique_lock<mutex> lock(m_batches->pendingMutex); \
+			auto& batches = m_batches->GetView(view); \
+			if (((kind) != BatchUpdated) && batches.batchMember[oppositeKind].Contains(key)) \
+			{ \
+				lock.unlock(); \
+				Deliver(true); \
+				lock.lock(); \
+			} \
+			deliverNow = m_batches->GetView(view).batchMember[kind].Add(key, value) && m_batches->Added(); \
+		} \
+		if (deliverNow) \
+			Deliver(false); \
+	} while (0)
+
+
+void BatchedBinaryDataNotification::OnAnalysisFunctionAdded(BinaryView* view, Function* func)
+{
+	BATCH_NOTIFICATION(functions, BatchAdded, BatchRemoved, func->GetObject(), Ref<Function>(func));
+}
+
+
+void BatchedBinaryDataNotification::OnAnalysisFunctionRemoved(BinaryView* view, Function* func)
+{
+	BATCH_NOTIFICATION(functions, BatchRemoved, BatchAdded, func->GetObject(), Ref<Function>(func));
+}
+
+
+void BatchedBinaryDataNotification::OnAnalysisFunctionUpdated(BinaryView* view, Function* func)
+{
+	BATCH_NOTIFICATION(functions, BatchUpdated, BatchUpdated, func->GetObject(), Ref<Function>(func));
+}
+
+
+void BatchedBinaryDataNotification::OnDataVariableAdded(BinaryView* view, const DataVariable& var)
+{
+	BATCH_NOTIFICATION(variables, BatchAdded, BatchRemoved, var.address, var);
+}
+
+
+void BatchedBinaryDataNotification::OnDataVariableRemoved(BinaryView* view, const DataVariable& var)
+{
+	BATCH_NOTIFICATION(variables, BatchRemoved, BatchAdded, var.address, var);
+}
+
+
+void BatchedBinaryDataNotification::OnDataVariableUpdated(BinaryView* view, const DataVariable& var)
+{
+	BATCH_NOTIFICATION(variables, BatchUpdated, BatchUpdated, var.address, var);
+}
+
+
+void BatchedBinaryDataNotification::OnSymbolAdded(BinaryView* view, Symbol* sym)
+{
+	BATCH_NOTIFICATION(symbols, BatchAdded, BatchRemoved, sym->GetObject(), Ref<Symbol>(sym));
+}
+
+
+void BatchedBinaryDataNotification::OnSymbolRemoved(BinaryView* view, Symbol* sym)
+{
+	BATCH_NOTIFICATION(symbols, BatchRemoved, BatchAdded, sym->GetObject(), Ref<Symbol>(sym));
+}
+
+
+void BatchedBinaryDataNotification::OnSymbolUpdated(BinaryView* view, Symbol* sym)
+{
+	BATCH_NOTIFICATION(symbols, BatchUpdated, BatchUpdated, sym->GetObject(), Ref<Symbol>(sym));
+}
+
+#undef BATCH_NOTIFICATION
+
+
 Symbol::Symbol(BNSymbolType type, const string& shortName, const string& fullName, const string& rawName, uint64_t addr,
     BNSymbolBinding binding, const NameSpace& nameSpace, uint64_t ordinal)
 {
@@ -1626,13 +1863,17 @@ DataBuffer BinaryView::ReadBuffer(uint64_t offset, size_t len)
 
 size_t BinaryView::WriteBuffer(uint64_t offset, const DataBuffer& data)
 {
-	return BNWriteViewBuffer(m_object, offset, data.GetBufferObject());
+	size_t result = BNWriteViewBuffer(m_object, offset, data.GetBufferObject());
+	BinaryReader::InvalidateBuffers();
+	return result;
 }
 
 
 size_t BinaryView::InsertBuffer(uint64_t offset, const DataBuffer& data)
 {
-	return BNInsertViewBuffer(m_object, offset, data.GetBufferObject());
+	size_t result = BNInsertViewBuffer(m_object, offset, data.GetBufferObject());
+	BinaryReader::InvalidateBuffers();
+	return result;
 }
 
 
@@ -1775,21 +2016,115 @@ size_t BinaryView::Read(void* dest, uint64_t offset, size_t len)
 }
 
 
+size_t BinaryView::ReadMany(ReadRange* ranges, size_t count)
+{
+	// Ranges closer than this are read together and the gap between them is discarded
+	static constexpr uint64_t MaxCoalesceGap = 256;
+	static constexpr uint64_t MaxCoalescedRead = 0x10000;
+
+	if (!ranges || count == 0)
+		return 0;
+
+	vector<size_t> order(count);
+	for (size_t i = 0; i < count; i++)
+		order[i] = i;
+	stable_sort(order.begin(), order.end(),
+	    [&](size_t a, size_t b) { return ranges[a].address < ranges[b].address; });
+
+	auto readSingle = [&](ReadRange& range) {
+		range.bytesRead = range.length ? BNReadViewData(m_object, range.dest, range.address, range.length) : 0;
+	};
+
+	vector<uint8_t> scratch;
+	size_t i = 0;
+	while (i < count)
+	{
+		// Gather a run of ranges that can be served by one contiguous read
+		ReadRange& first = ranges[order[i]];
+		uint64_t start = first.address;
+		uint64_t end = start + first.length;
+		size_t groupEnd = i + 1;
+		if (end >= start)
+		{
+			while (groupEnd < count)
+			{
+				const ReadRange& next = ranges[order[groupEnd]];
+				uint64_t nextEnd = next.address + next.length;
+				if (nextEnd < next.address || next.address > end + MaxCoalesceGap)
+					break;
+				uint64_t newEnd = max(end, nextEnd);
+				if (newEnd - start > MaxCoalescedRead)
+					break;
+				end = newEnd;
+				groupEnd++;
+			}
+		}
+
+		if (groupEnd - i == 1)
+		{
+			readSingle(first);
+			i = groupEnd;
+			continue;
+		}
+
+		scratch.resize((size_t)(end - start));
+		size_t got = BNReadViewData(m_object, scratch.data(), start, scratch.size());
+		for (size_t j = i; j < groupEnd; j++)
+		{
+			ReadRange& range = ranges[order[j]];
+			uint64_t offset = range.address - start;
+			if (offset + range.length <= got)
+			{
+				if (range.length)
+					memcpy(range.dest, scratch.data() + offset, range.length);
+				range.bytesRead = range.length;
+			}
+			else
+			{
+				// The coalesced read stopped at unbacked memory, data after the hole may still be readable
+				readSingle(range);
+			}
+		}
+		i = groupEnd;
+	}
+
+	size_t complete = 0;
+	for (size_t j = 0; j < count; j++)
+	{
+		if (ranges[j].Succeeded())
+			complete++;
+	}
+	return complete;
+}
+
+
+size_t BinaryView::ReadMany(vector<ReadRange>& ranges)
+{
+	return ReadMany(ranges.data(), ranges.size());
+}
+
+
 size_t BinaryView::Write(uint64_t offset, const void* data, size_t len)
 {
-	return BNWriteViewData(m_object, offset, data, len);
+	size_t result = BNWriteViewData(m_object, offset, data, len);
+	BinaryReader::InvalidateBuffers();
+	return result;
 }
 
 
 size_t BinaryView::Insert(uint64_t offset, const void* data, size_t len)
 {
-	return BNInsertViewData(m_object, offset, data, len);
+	size_t result = BNInsertViewData(m_object, offset, data, len);
+	BinaryReader::InvalidateBuffers();
+	return result;
 }
 
 
 size_t BinaryView::Remove(uint64_t offset, uint64_t len)
 {
-	return BNRemoveViewData(m_object, offset, len);
+	size_t result = BNRemoveViewData(m_object, offset, len);
+	BinaryReader::InvalidateBuffers();
+	return result;
 }
 
 
@@ -2140,6 +2475,25 @@ vector<Ref<Function>> BinaryView::GetAnalysisFunctionList()
 }
 
 
+FunctionArray BinaryView::GetAnalysisFunctionArray()
+{
+	size_t count;
+	BNFunction** list = BNGetAnalysisFunctionList(m_object, &count);
+	return FunctionArray(list, count);
+}
+
+
+bool BinaryView::ForEachAnalysisFunction(const function<bool(BorrowedRef<Function> func)>& callback)
+{
+	for (BorrowedRef<Function> func : GetAnalysisFunctionArray())
+	{
+		if (!callback(func))
+			return false;
+	}
+	return true;
+}
+
+
 AnalysisInfo BinaryView::GetAnalysisInfo()
 {
 	AnalysisInfo result;
@@ -2326,6 +2680,50 @@ vector<ReferenceSource> BinaryView::GetCodeReferences(uint64_t addr, uint64_t le
 }
 
 
+static bool VisitCodeReferences(
+    BNReferenceSource* refs, size_t count, const function<bool(const ReferenceSource& ref)>& callback)
+{
+	// The references are freed even if the callback throws
+	auto freeRefs = [count](BNReferenceSource* refs) { BNFreeCodeReferences(refs, count); };
+	unique_ptr<BNReferenceSource[], decltype(freeRefs)> refsGuard(refs, freeRefs);
+
+	// References are grouped by function, so reuse the wrapper objects while the function and architecture repeat
+	ReferenceSource src;
+	bool complete = true;
+	for (size_t i = 0; i < count; i++)
+	{
+		if (!src.func || (src.func->GetObject() != refs[i].func))
+			src.func = new Function(BNNewFunctionReference(refs[i].func));
+		if (!src.arch || (src.arch->GetObject() != refs[i].arch))
+			src.arch = new CoreArchitecture(refs[i].arch);
+		src.addr = refs[i].addr;
+		if (!callback(src))
+		{
+			complete = false;
+			break;
+		}
+	}
+	return complete;
+}
+
+
+bool BinaryView::ForEachCodeReference(uint64_t addr, const function<bool(const ReferenceSource& ref)>& callback)
+{
+	size_t count;
+	BNReferenceSource* refs = BNGetCodeReferences(m_object, addr, &count);
+	return VisitCodeReferences(refs, count, callback);
+}
+
+
+bool BinaryView::ForEachCodeReference(
+    uint64_t addr, uint64_t len, const function<bool(const ReferenceSource& ref)>& callback)
+{
+	size_t count;
+	BNReferenceSource* refs = BNGetCodeReferencesInRange(m_object, addr, len, &count);
+	return VisitCodeReferences(refs, count, callback);
+}
+
+
 vector<uint64_t> BinaryView::GetCodeReferencesFrom(ReferenceSource src)
 {
 	size_t count;
@@ -2368,6 +2766,28 @@ vector<uint64_t> BinaryView::GetDataReferences(uint64_t addr, uint64_t len)
 }
 
 
+bool BinaryView::ForEachDataReference(uint64_t addr, const function<bool(uint64_t ref)>& callback)
+{
+	size_t count;
+	unique_ptr<uint64_t[], decltype(&BNFreeDataReferences)> refs(BNGetDataReferences(m_object, addr, &count), BNFreeDataReferences);
+	size_t i = 0;
+	while ((i < count) && callback(refs[i]))
+		i++;
+	return i == count;
+}
+
+
+bool BinaryView::ForEachDataReference(uint64_t addr, uint64_t len, const function<bool(uint64_t ref)>& callback)
+{
+	size_t count;
+	unique_ptr<uint64_t[], decltype(&BNFreeDataReferences)> refs(BNGetDataReferencesInRange(m_object, addr, len, &count), BNFreeDataReferences);
+	size_t i = 0;
+	while ((i < count) && callback(refs[i]))
+		i++;
+	return i == count;
+}
+
+
 vector<uint64_t> BinaryView::GetDataReferencesFrom(uint64_t addr)
 {
 	size_t count;
@@ -2942,6 +3362,49 @@ vector<Ref<Symbol>> BinaryView::GetSymbols(uint64_t start, uint64_t len, const N
 }
 
 
+SymbolArray BinaryView::GetSymbolArray(const NameSpace& nameSpace)
+{
+	size_t count;
+	BNNameSpace ns = nameSpace.GetAPIObject();
+	BNSymbol** syms = BNGetSymbols(m_object, &count, &ns);
+	NameSpace::FreeAPIObject(&ns);
+	return SymbolArray(syms, count);
+}
+
+
+SymbolArray BinaryView::GetSymbolArray(uint64_t start, uint64_t len, const NameSpace& nameSpace)
+{
+	size_t count;
+	BNNameSpace ns = nameSpace.GetAPIObject();
+	BNSymbol** syms = BNGetSymbolsInRange(m_object, start, len, &count, &ns);
+	NameSpace::FreeAPIObject(&ns);
+	return SymbolArray(syms, count);
+}
+
+
+bool BinaryView::ForEachSymbol(const function<bool(BorrowedRef<Symbol> sym)>& callback, const NameSpace& nameSpace)
+{
+	for (BorrowedRef<Symbol> sym : GetSymbolArray(nameSpace))
+	{
+		if (!callback(sym))
+			return false;
+	}
+	return true;
+}
+
+
+bool BinaryView::ForEachSymbol(
+    uint64_t start, uint64_t len, const function<bool(BorrowedRef<Symbol> sym)>& callback, const NameSpace& nameSpace)
+{
+	for (BorrowedRef<Symbol> sym : GetSymbolArray(start, len, nameSpace))
+	{
+		if (!callback(sym))
+			return false;
+	}
+	return true;
+}
+
+
 vector<Ref<Symbol>> BinaryView::GetSymbolsOfType(BNSymbolType type, const NameSpace& nameSpace)
 {
 	size_t count;
@@ -3010,6 +3473,130 @@ Ref<Symbol> BinaryView::DefineAutoSymbolAndVariableOrFunction(Ref<Platform> plat
 }
 
 
+void BinaryView::DefineAutoSymbols(const vector<SymbolSpec>& symbols, Ref<Platform> platform)
+{
+	// Most tables use one or two namespaces, so only convert when it changes from the previous entry
+	const NameSpace* lastNameSpace = nullptr;
+	BNNameSpace ns;
+	for (auto& i : symbols)
+	{
+		if (!lastNameSpace || (i.nameSpace != *lastNameSpace))
+		{
+			if (lastNameSpace)
+				NameSpace::FreeAPIObject(&ns);
+			ns = i.nameSpace.GetAPIObject();
+			lastNameSpace = &i.nameSpace;
+		}
+
+		const string& fullName = i.fullName.empty() ? i.shortName : i.fullName;
+		const string& rawName = i.rawName.empty() ? i.shortName : i.rawName;
+		BNSymbol* sym = BNCreateSymbol(
+		    i.type, i.shortName.c_str(), fullName.c_str(), rawName.c_str(), i.address, i.binding, &ns, i.ordinal);
+		if (!sym)
+			continue;
+
+		if (platform)
+		{
+			BNSymbol* result = BNDefineAutoSymbolAndVariableOrFunction(
+			    m_object, platform->GetObject(), sym, i.variableType ? i.variableType->GetObject() : nullptr);
+			if (result)
+				BNFreeSymbol(result);
+		}
+		else
+		{
+			BNDefineAutoSymbol(m_object, sym);
+		}
+		BNFreeSymbol(sym);
+	}
+
+	if (lastNameSpace)
+		NameSpace::FreeAPIObject(&ns);
+}
+
+
+void BinaryView::DefineAutoSymbols(
+    size_t count, const function<bool(size_t index, SymbolSpec& symbol)>& resolve, Ref<Platform> platform)
+{
+	static constexpr size_t BatchSize = 256;
+
+	// Workers may start after the calling thread has already resolved everything, so the state they check lives
+	// on the heap. Only workers that start before the calling thread finishes touch the symbols, and only those are
+	// waited for, so this cannot deadlock when called from a worker thread.
+	struct ResolveState
+	{
+		mutex lock;
+		condition_variable done;
+		bool closed = false;
+		size_t active = 0;
+		atomic<size_t> next {0};
+		exception_ptr error;
+	};
+
+	vector<SymbolSpec> symbols(count);
+	vector<uint8_t> valid(count, 0);
+	auto state = make_shared<ResolveState>();
+	auto work = [&symbols, &valid, &resolve, count](ResolveState& state) {
+		try
+		{
+			for (size_t start = state.next.fetch_add(BatchSize); start < count; start = state.next.fetch_add(BatchSize))
+			{
+				size_t end = min(count, start + BatchSize);
+				for (size_t i = start; i < end; i++)
+					valid[i] = resolve(i, symbols[i]) ? 1 : 0;
+			}
+		}
+		catch (...)
+		{
+			// Claim the remaining indices so that the other threads stop early
+			state.next.store(count);
+			unique_lock<mutex> lock(state.lock);
+			if (!state.error)
+				state.error = current_exception();
+		}
+	};
+
+	size_t batches = (count + BatchSize - 1) / BatchSize;
+	size_t workers = min(GetWorkerThreadCount(), batches > 0 ? batches - 1 : 0);
+	for (size_t i = 0; i < workers; i++)
+	{
+		WorkerEnqueue([state, work]() {
+			{
+				unique_lock<mutex> lock(state->lock);
+				if (state->closed)
+					return;
+				state->active++;
+			}
+			work(*state);
+			unique_lock<mutex> lock(state->lock);
+			if (--state->active == 0)
+				state->done.notify_all();
+		}, "DefineAutoSymbols");
+	}
+
+	work(*state);
+	{
+		unique_lock<mutex> lock(state->lock);
+		state->closed = true;
+		state->done.wait(lock, [&]() { return state->active == 0; });
+		if (state->error)
+			rethrow_exception(state->error);
+	}
+
+	// Compact in place so that definition happens in index order without copying the resolved names
+	size_t out = 0;
+	for (size_t i = 0; i < count; i++)
+	{
+		if (!valid[i])
+			continue;
+		if (out != i)
+			symbols[out] = std::move(symbols[i]);
+		out++;
+	}
+	symbols.resize(out);
+	DefineAutoSymbols(symbols, platform);
+}
+
+
 void BinaryView::UndefineAutoSymbol(Ref<Symbol> sym)
 {
 	BNUndefineAutoSymbol(m_object, sym->GetObject());
@@ -51,7 +51,7 @@ void BinaryWriter::SetEndianness(BNEndianness endian)
 
 void BinaryWriter::Write(const void* src, size_t len)
 {
-	if (!BNWriteData(m_stream, src, len))
+	if (!TryWrite(src, len))
 		throw WriteException();
 }
 
@@ -70,77 +70,79 @@ void BinaryWriter::Write(const string& str)
 
 void BinaryWriter::Write8(uint8_t val)
 {
-	if (!BNWrite8(m_stream, val))
+	if (!TryWrite8(val))
 		throw WriteException();
 }
 
 
 void BinaryWriter::Write16(uint16_t val)
 {
-	if (!BNWrite16(m_stream, val))
+	if (!TryWrite16(val))
 		throw WriteException();
 }
 
 
 void BinaryWriter::Write32(uint32_t val)
 {
-	if (!BNWrite32(m_stream, val))
+	if (!TryWrite32(val))
 		throw WriteException();
 }
 
 
 void BinaryWriter::Write64(uint64_t val)
 {
-	if (!BNWrite64(m_stream, val))
+	if (!TryWrite64(val))
 		throw WriteException();
 }
 
 
 void BinaryWriter::WriteLE16(uint16_t val)
 {
-	if (!BNWriteLE16(m_stream, val))
+	if (!TryWriteLE16(val))
 		throw WriteException();
 }
 
 
 void BinaryWriter::WriteLE32(uint32_t val)
 {
-	if (!BNWriteLE32(m_stream, val))
+	if (!TryWriteLE32(val))
 		throw WriteException();
 }
 
 
 void BinaryWriter::WriteLE64(uint64_t val)
 {
-	if (!BNWriteLE64(m_stream, val))
+	if (!TryWriteLE64(val))
 		throw WriteException();
 }
 
 
 void BinaryWriter::WriteBE16(uint16_t val)
 {
-	if (!BNWriteBE16(m_stream, val))
+	if (!TryWriteBE16(val))
 		throw WriteException();
 }
 
 
 void BinaryWriter::WriteBE32(uint32_t val)
 {
-	if (!BNWriteBE32(m_stream, val))
+	if (!TryWriteBE32(val))
 		throw WriteException();
 }
 
 
 void BinaryWriter::WriteBE64(uint64_t val)
 {
-	if (!BNWriteBE64(m_stream, val))
+	if (!TryWriteBE64(val))
 		throw WriteException();
 }
 
 
 bool BinaryWriter::TryWrite(const void* src, size_t len)
 {
-	return BNWriteData(m_stream, src, len);
+	bool result = BNWriteData(m_stream, src, len);
+	BinaryReader::InvalidateBuffers();
+	return result;
 }
 
 
@@ -158,61 +160,81 @@ bool BinaryWriter::TryWrite(const string& str)
 
 bool BinaryWriter::TryWrite8(uint8_t val)
 {
-	return BNWrite8(m_stream, val);
+	bool result = BNWrite8(m_stream, val);
+	BinaryReader::InvalidateBuffers();
+	return result;
 }
 
 
 bool BinaryWriter::TryWrite16(uint16_t val)
 {
-	return BNWrite16(m_stream, val);
+	bool result = BNWrite16(m_stream, val);
+	BinaryReader::InvalidateBuffers();
+	return result;
 }
 
 
 bool BinaryWriter::TryWrite32(uint32_t val)
 {
-	return BNWrite32(m_stream, val);
+	bool result = BNWrite32(m_stream, val);
+	BinaryReader::InvalidateBuffers();
+	return result;
 }
 
 
 bool BinaryWriter::TryWrite64(uint64_t val)
 {
-	return BNWrite64(m_stream, val);
+	bool result = BNWrite64(m_stream, val);
+	BinaryReader::InvalidateBuffers();
+	return result;
 }
 
 
 bool BinaryWriter::TryWriteLE16(uint16_t val)
 {
-	return BNWriteLE16(m_stream, val);
+	bool result = BNWriteLE16(m_stream, val);
+	BinaryReader::InvalidateBuffers();
+	return result;
 }
 
 
 bool BinaryWriter::TryWriteLE32(uint32_t val)
 {
-	return BNWriteLE32(m_stream, val);
+	bool result = BNWriteLE32(m_stream, val);
+	BinaryReader::InvalidateBuffers();
+	return result;
 }
 
 
 bool BinaryWriter::TryWriteLE64(uint64_t val)
 {
-	return BNWriteLE64(m_stream, val);
+	bool result = BNWriteLE64(m_stream, val);
+	BinaryReader::InvalidateBuffers();
+	return result;
 }
 
 
 bool BinaryWriter::TryWriteBE16(uint16_t val)
 {
-	return BNWriteBE16(m_stream, val);
+	bool result = BNWriteBE16(m_stream, val);
+	BinaryReader::InvalidateBuffers();
+	return result;
 }
 
 
 bool BinaryWriter::TryWriteBE32(uint32_t val)
 {
-	return BNWriteBE32(m_stream, val);
+	bool result = BNWriteBE32(m_stream, val);
+	BinaryReader::InvalidateBuffers();
+	return result;
 }
 
 
 bool BinaryWriter::TryWriteBE64(uint64_t val)
 {
-	return BNWriteBE64(m_stream, val);
+	bool result = BNWriteBE64(m_stream, val);
+	BinaryReader::InvalidateBuffers();
+	return result;
 }
 
 
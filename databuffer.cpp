@@ -270,6 +270,49 @@ bool DataBuffer::XzDecompress(DataBuffer& output) const
 }
 
 
+DataBufferView::DataBufferView(DataBuffer&& buf)
+{
+	auto owner = make_shared<DataBuffer>(std::move(buf));
+	m_data = (const uint8_t*)owner->GetData();
+	m_length = owner->GetLength();
+	m_owner = std::move(owner);
+}
+
+
+DataBufferView::DataBufferView(shared_ptr<const void> owner, const void* data, size_t len) :
+	m_owner(std::move(owner)), m_data((const uint8_t*)data), m_length(len)
+{
+}
+
+
+DataBufferView DataBufferView::Borrow(const void* data, size_t len)
+{
+	return DataBufferView(nullptr, data, len);
+}
+
+
+DataBufferView DataBufferView::FromBinaryView(BinaryView* view, uint64_t offset, size_t len)
+{
+	return DataBufferView(view->ReadBuffer(offset, len));
+}
+
+
+DataBufferView DataBufferView::GetSlice(size_t start, size_t len) const
+{
+	if (start > m_length)
+		start = m_length;
+	if (len > m_length - start)
+		len = m_length - start;
+	return DataBufferView(m_owner, m_data + start, len);
+}
+
+
+DataBuffer DataBufferView::ToDataBuffer() const
+{
+	return DataBuffer(m_data, m_length);
+}
+
+
 string BinaryNinja::EscapeString(const string& s)
 {
 	DataBuffer buffer(s.c_str(), s.size());
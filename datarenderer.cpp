@@ -90,7 +90,7 @@ BNDisassemblyTextLine* DataRenderer::GetLinesForDataCallback(void* ctxt, BNBinar
 		buf[i].addr = line.addr;
 		buf[i].instrIndex = line.instrIndex;
 		buf[i].highlight = line.highlight;
-		buf[i].tokens = InstructionTextToken::CreateInstructionTextTokenList(line.tokens);
+		buf[i].tokens = InstructionTextToken::CreatePackedInstructionTextTokenList(line.tokens);
 		buf[i].count = line.tokens.size();
 		buf[i].tags = Tag::CreateTagList(line.tags, &(buf[i].tagCount));
 	}
@@ -112,7 +112,7 @@ void DataRenderer::FreeLinesCallback(void* ctxt, BNDisassemblyTextLine* lines, s
 {
 	for (size_t i = 0; i < count; i++)
 	{
-		InstructionTextToken::FreeInstructionTextTokenList(lines[i].tokens, lines[i].count);
+		InstructionTextToken::FreePackedInstructionTextTokenList(lines[i].tokens);
 		Tag::FreeTagList(lines[i].tags, lines[i].tagCount);
 	}
 	delete[] lines;
@@ -136,7 +136,7 @@ bool DataRenderer::IsValidForData(BinaryView* data, uint64_t addr, Type* type, v
 vector<DisassemblyTextLine> DataRenderer::GetLinesForData(BinaryView* data, uint64_t addr, Type* type,
     const std::vector<InstructionTextToken>& prefix, size_t width, vector<pair<Type*, size_t>>& context, const string& language)
 {
-	BNInstructionTextToken* prefixes = InstructionTextToken::CreateInstructionTextTokenList(prefix);
+	BNInstructionTextToken* prefixes = InstructionTextToken::CreatePackedInstructionTextTokenList(prefix);
 	BNTypeContext* typeCtx = new BNTypeContext[context.size()];
 	for (size_t i = 0; i < context.size(); i++)
 	{
@@ -148,14 +148,7 @@ vector<DisassemblyTextLine> DataRenderer::GetLinesForData(BinaryView* data, uint
 	    prefix.size(), width, &count, typeCtx, context.size(), language.c_str());
 
 	delete[] typeCtx;
-	for (size_t i = 0; i < prefix.size(); i++)
-	{
-		BNFreeString(prefixes[i].text);
-		for (size_t j = 0; j < prefixes[j].namesCount; j++)
-			BNFreeString(prefixes[i].typeNames[j]);
-		delete[] prefixes[i].typeNames;
-	}
-	delete[] prefixes;
+	InstructionTextToken::FreePackedInstructionTextTokenList(prefixes);
 
 	vector<DisassemblyTextLine> result;
 	result.reserve(count);
@@ -176,7 +169,7 @@ vector<DisassemblyTextLine> DataRenderer::GetLinesForData(BinaryView* data, uint
 vector<DisassemblyTextLine> DataRenderer::RenderLinesForData(BinaryView* data, uint64_t addr, Type* type,
     const std::vector<InstructionTextToken>& prefix, size_t width, vector<pair<Type*, size_t>>& context, const string& language)
 {
-	BNInstructionTextToken* prefixes = InstructionTextToken::CreateInstructionTextTokenList(prefix);
+	BNInstructionTextToken* prefixes = InstructionTextToken::CreatePackedInstructionTextTokenList(prefix);
 	BNTypeContext* typeCtx = new BNTypeContext[context.size()];
 	for (size_t i = 0; i < context.size(); i++)
 	{
@@ -189,14 +182,7 @@ vector<DisassemblyTextLine> DataRenderer::RenderLinesForData(BinaryView* data, u
 	    language.c_str());
 
 	delete[] typeCtx;
-	for (size_t i = 0; i < prefix.size(); i++)
-	{
-		BNFreeString(prefixes[i].text);
-		for (size_t j = 0; j < prefixes[j].namesCount; j++)
-			BNFreeString(prefixes[i].typeNames[j]);
-		delete[] prefixes[i].typeNames;
-	}
-	delete[] prefixes;
+	InstructionTextToken::FreePackedInstructionTextTokenList(prefixes);
 
 	vector<DisassemblyTextLine> result;
 	result.reserve(count);
@@ -0,0 +1,88 @@
+/*
+ * Benchmarks for the C++ API.
+ *
+ * Each benchmark first checks that the code it measures behaves the same
+ * as the path it replaces, then times both. The process exits non-zero if
+ * the check fails.
+ */
+
+#include <cstdio>
+#include <cstring>
+
+#include "binaryninjacore.h"
+#include "benchmarks.h"
+
+using namespace BinaryNinja;
+using namespace std;
+
+
+struct Benchmark
+{
+	const char* name;
+	const char* arguments;
+	int (*run)(int argc, char* argv[]);
+};
+
+
+static const Benchmark g_benchmarks[] = {
+    {"binaryreader", "", Benchmarks::BinaryReaderBenchmark},
+    {"flowgraph_layout", "[file_name]", Benchmarks::FlowGraphLayoutBenchmark},
+    {"il_visitor", "<file_name>", Benchmarks::ILVisitorBenchmark},
+    {"inform", "", Benchmarks::InformBenchmark},
+    {"object_array", "<file_name>", Benchmarks::ObjectArrayBenchmark},
+    {"readmany", "", Benchmarks::ReadManyBenchmark},
+};
+
+
+Ref<BinaryView> Benchmarks::OpenExecutable(const char* path)
+{
+	SetBundledPluginDirectory(GetBundledPluginDirectory());
+	InitPlugins();
+
+	Ref<BinaryView> bv = BinaryNinja::Load(path);
+	if (!bv || bv->GetTypeName() == "Raw")
+	{
+		fprintf(stderr, "Input file does not appear to be an executable\n");
+		return nullptr;
+	}
+	return bv;
+}
+
+
+int Benchmarks::ReportCheck(const char* name, bool ok)
+{
+	printf("%s check: %s\n", name, ok ? "passed" : "FAILED");
+	return ok ? 0 : 1;
+}
+
+
+static void Usage(const char* program)
+{
+	fprintf(stderr, "USAGE: %s <benchmark> [arguments]\n\nBenchmarks:\n", program);
+	for (auto& benchmark : g_benchmarks)
+		fprintf(stderr, "    %s %s\n", benchmark.name, benchmark.arguments);
+}
+
+
+int main(int argc, char* argv[])
+{
+	if (argc < 2)
+	{
+		Usage(argv[0]);
+		return -1;
+	}
+
+	for (auto& benchmark : g_benchmarks)
+	{
+		if (strcmp(argv[1], benchmark.name) != 0)
+			continue;
+		int result = benchmark.run(argc - 1, argv + 1);
+
+		// Shutting down is required to allow for clean exit of the core
+		BNShutdown();
+		return result;
+	}
+
+	Usage(argv[0]);
+	return -1;
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+
+#include "binaryninjaapi.h"
+
+namespace Benchmarks
+{
+	// Each measurement is the best of several runs, to keep scheduling noise out of the results
+	static constexpr size_t Repetitions = 5;
+
+	/*! Run `func` Repetitions times
+
+		\param func Function to time
+		\return Shortest run time in seconds
+	*/
+	template <typename Func>
+	double BestOf(const Func& func)
+	{
+		double best = 0;
+		for (size_t i = 0; i < Repetitions; i++)
+		{
+			auto start = std::chrono::steady_clock::now();
+			func();
+			double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+			if (i == 0 || elapsed < best)
+				best = elapsed;
+		}
+		return best;
+	}
+
+	/*! Load plugins and open an executable for analysis, rejecting files that only open as a Raw view
+
+		\param path Path to the executable
+		\return The analyzed view, or nullptr after printing an error
+	*/
+	BinaryNinja::Ref<BinaryNinja::BinaryView> OpenExecutable(const char* path);
+
+	/*! Print the result of a behavior check
+
+		\param name What was checked
+		\param ok Whether the check passed
+		\return Process exit code for the result
+	*/
+	int ReportCheck(const char* name, bool ok);
+
+	int BinaryReaderBenchmark(int argc, char* argv[]);
+	int FlowGraphLayoutBenchmark(int argc, char* argv[]);
+	int ILVisitorBenchmark(int argc, char* argv[]);
+	int InformBenchmark(int argc, char* argv[]);
+	int ObjectArrayBenchmark(int argc, char* argv[]);
+	int ReadManyBenchmark(int argc, char* argv[]);
+}
@@ -0,0 +1,118 @@
+// BinaryReader read-ahead window: writes through every BinaryWriter path must read back unchanged, then a table
+// of small integers is parsed with several window sizes
+
+#include <cstdio>
+#include <cstring>
+#include <random>
+
+#include "benchmarks.h"
+
+using namespace BinaryNinja;
+using namespace std;
+
+
+static constexpr size_t TableEntries = 1 << 20;
+
+
+static bool CheckWrites(Ref<BinaryView> view)
+{
+	// Each write path gets its own pattern so that a misdirected write shows up as a mismatch
+	uint8_t raw[64];
+	for (size_t i = 0; i < sizeof(raw); i++)
+		raw[i] = (uint8_t)(0xa0 + i);
+	DataBuffer buffer(32);
+	uint8_t* bufferData = (uint8_t*)buffer.GetData();
+	for (size_t i = 0; i < buffer.GetLength(); i++)
+		bufferData[i] = (uint8_t)(0x10 + i);
+	string text = "binaryreader benchmark";
+
+	BinaryWriter writer(view);
+	writer.Seek(0);
+	writer.Write(raw, sizeof(raw));
+	writer.Write(buffer);
+	writer.Write(text);
+	writer.WriteLE32(0x12345678);
+	writer.WriteBE16(0xabcd);
+
+	for (size_t bufferSize : {0, 16, 4096})
+	{
+		BinaryReader reader(view);
+		reader.SetBufferSize(bufferSize);
+		reader.Seek(0);
+		DataBuffer readRaw = reader.Read(sizeof(raw));
+		DataBuffer readBuffer = reader.Read(buffer.GetLength());
+		DataBuffer readText = reader.Read(text.size());
+		uint32_t le32 = reader.ReadLE32();
+		uint16_t be16 = reader.ReadBE16();
+		if (readRaw.GetLength() != sizeof(raw) || memcmp(readRaw.GetData(), raw, sizeof(raw)) != 0)
+		{
+			fprintf(stderr, "Write(const void*, size_t) mismatch (buffer size %zu)\n", bufferSize);
+			return false;
+		}
+		if (readBuffer.GetLength() != buffer.GetLength()
+		    || memcmp(readBuffer.GetData(), buffer.GetData(), buffer.GetLength()) != 0)
+		{
+			fprintf(stderr, "Write(const DataBuffer&) mismatch (buffer size %zu)\n", bufferSize);
+			return false;
+		}
+		if (readText.GetLength() != text.size() || memcmp(readText.GetData(), text.data(), text.size()) != 0)
+		{
+			fprintf(stderr, "Write(const string&) mismatch (buffer size %zu)\n", bufferSize);
+			return false;
+		}
+		if (le32 != 0x12345678 || be16 != 0xabcd)
+		{
+			fprintf(stderr, "Integer write mismatch (buffer size %zu)\n", bufferSize);
+			return false;
+		}
+	}
+	return true;
+}
+
+
+int Benchmarks::BinaryReaderBenchmark(int, char*[])
+{
+	mt19937 rng(1);
+	DataBuffer contents(TableEntries * 4);
+	uint8_t* contentsData = (uint8_t*)contents.GetData();
+	for (size_t i = 0; i < contents.GetLength(); i++)
+		contentsData[i] = (uint8_t)rng();
+
+	Ref<FileMetadata> file = new FileMetadata();
+	Ref<BinaryView> view = new BinaryData(file, contents);
+
+	uint64_t expected = 0;
+	for (size_t entry = 0; entry < TableEntries; entry++)
+	{
+		const uint8_t* data = contentsData + entry * 4;
+		expected += (uint32_t)data[0] | ((uint32_t)data[1] << 8) | ((uint32_t)data[2] << 16) | ((uint32_t)data[3] << 24);
+	}
+
+	bool ok = CheckWrites(view);
+
+	// The table is rewritten by CheckWrites, so restore it before parsing
+	view->Write(0, contents.GetData(), contents.GetLength());
+
+	printf("%-24s %16s\n", "buffer size", "reads/s");
+	for (size_t bufferSize : {0, 256, 4096, 65536})
+	{
+		uint64_t checksum = 0;
+		double elapsed = BestOf([&]() {
+			BinaryReader reader(view);
+			reader.SetBufferSize(bufferSize);
+			reader.Seek(0);
+			checksum = 0;
+			for (size_t entry = 0; entry < TableEntries; entry++)
+				checksum += reader.ReadLE32();
+		});
+		if (checksum != expected)
+		{
+			fprintf(stderr, "Read mismatch with buffer size %zu\n", bufferSize);
+			ok = false;
+		}
+		printf("%-24zu %16.0f\n", bufferSize, TableEntries / elapsed);
+	}
+
+	file->Close();
+	return ReportCheck("write read-back", ok);
+}
@@ -0,0 +1,257 @@
+// LayeredFlowGraphLayout: synthetic control flow graphs of increasing size are laid out, then the control flow
+// graphs of every function in a binary if one is passed. Each graph is laid out from scratch, again after one block
+// changes size (which reuses the cached layering), and again after one edge is added (which seeds crossing
+// reduction from the previous ordering).
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <map>
+#include <random>
+
+#include "benchmarks.h"
+
+using namespace BinaryNinja;
+using namespace std;
+
+
+struct Timing
+{
+	double full = 0;
+	double resized = 0;
+	double edited = 0;
+};
+
+
+static double TimeLayout(
+    LayeredFlowGraphLayout& layout, LayeredFlowGraphLayout::Graph& graph, const LayeredFlowGraphLayout::CacheKey& key)
+{
+	auto start = chrono::steady_clock::now();
+	layout.LayoutGraph(graph, key);
+	return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+
+
+static LayeredFlowGraphLayout::Graph FromEdgeLists(
+    const vector<pair<int, int>>& sizes, const vector<vector<size_t>>& successors, const vector<uint64_t>& keys)
+{
+	LayeredFlowGraphLayout::Graph graph;
+	for (size_t i = 0; i < sizes.size(); i++)
+	{
+		graph.nodeWidths.push_back(sizes[i].first);
+		graph.nodeHeights.push_back(sizes[i].second);
+		graph.nodeKeys.push_back(keys[i]);
+		graph.edgeStarts.push_back(graph.edgeTargets.size());
+		graph.edgeTargets.insert(graph.edgeTargets.end(), successors[i].begin(), successors[i].end());
+	}
+	graph.edgeStarts.push_back(graph.edgeTargets.size());
+	return graph;
+}
+
+
+static Timing MeasureOnce(LayeredFlowGraphLayout& layout, const vector<pair<int, int>>& sizes,
+    vector<vector<size_t>> successors, const vector<uint64_t>& keys, const LayeredFlowGraphLayout::CacheKey& key)
+{
+	Timing result;
+	LayeredFlowGraphLayout::Graph graph = FromEdgeLists(sizes, successors, keys);
+	layout.ClearCache();
+	result.full = TimeLayout(layout, graph, key);
+
+	LayeredFlowGraphLayout::Graph resized = FromEdgeLists(sizes, successors, keys);
+	resized.nodeHeights[resized.nodeHeights.size() / 2] += 64;
+	result.resized = TimeLayout(layout, resized, key);
+
+	// Add a short edge, as patching a branch would
+	size_t middle = sizes.size() / 2;
+	if (sizes.size() > 1)
+		successors[middle].push_back(min(middle + 2, sizes.size() - 1));
+	LayeredFlowGraphLayout::Graph edited = FromEdgeLists(sizes, successors, keys);
+	result.edited = TimeLayout(layout, edited, key);
+	return result;
+}
+
+
+// Each phase is timed separately, so BestOf cannot be used here
+static Timing Measure(LayeredFlowGraphLayout& layout, const vector<pair<int, int>>& sizes,
+    const vector<vector<size_t>>& successors, const vector<uint64_t>& keys, const LayeredFlowGraphLayout::CacheKey& key)
+{
+	Timing best = MeasureOnce(layout, sizes, successors, keys, key);
+	for (size_t i = 1; i < Benchmarks::Repetitions; i++)
+	{
+		Timing timing = MeasureOnce(layout, sizes, successors, keys, key);
+		best.full = min(best.full, timing.full);
+		best.resized = min(best.resized, timing.resized);
+		best.edited = min(best.edited, timing.edited);
+	}
+	return best;
+}
+
+
+// Random structured control flow: straight line code, diamonds, loops and the occasional large switch
+static void GenerateGraph(size_t blockCount, mt19937& rng, vector<pair<int, int>>& sizes,
+    vector<vector<size_t>>& successors, vector<uint64_t>& keys)
+{
+	sizes.clear();
+	successors.assign(blockCount, {});
+	keys.clear();
+	uniform_int_distribution<int> width(120, 600);
+	uniform_int_distribution<int> lines(1, 30);
+	uniform_int_distribution<int> shape(0, 99);
+	for (size_t i = 0; i < blockCount; i++)
+	{
+		sizes.emplace_back(width(rng), lines(rng) * 16 + 8);
+		keys.push_back(0x1000 + i * 0x10);
+	}
+
+	vector<size_t> loopHeads = {0};
+	size_t i = 0;
+	while (i + 1 < blockCount)
+	{
+		int kind = shape(rng);
+		if (kind < 2 && i + 18 < blockCount)
+		{
+			size_t cases = 16;
+			for (size_t c = 1; c <= cases; c++)
+			{
+				successors[i].push_back(i + c);
+				successors[i + c].push_back(i + cases + 1);
+			}
+			i += cases + 1;
+		}
+		else if (kind < 40 && i + 3 < blockCount)
+		{
+			successors[i] = {i + 1, i + 2};
+			successors[i + 1] = {i + 3};
+			successors[i + 2] = {i + 3};
+			i += 3;
+		}
+		else if (kind < 55 && i + 2 < blockCount)
+		{
+			loopHeads.push_back(i + 1);
+			successors[i] = {i + 1};
+			i += 1;
+		}
+		else if (kind < 70 && loopHeads.size() > 1)
+		{
+			successors[i] = {loopHeads.back(), i + 1};
+			loopHeads.pop_back();
+			i += 1;
+		}
+		else
+		{
+			successors[i] = {i + 1};
+			i += 1;
+		}
+	}
+}
+
+
+// Block heights approximate the rendered disassembly without needing the UI to size the nodes
+static bool BuildFunctionGraph(Ref<Function> func, vector<pair<int, int>>& sizes, vector<vector<size_t>>& successors,
+    vector<uint64_t>& keys)
+{
+	vector<Ref<BasicBlock>> blocks = func->GetBasicBlocks();
+	if (blocks.empty())
+		return false;
+
+	// The entry block goes first so that it is placed at the top
+	sort(blocks.begin(), blocks.end(), [&](const Ref<BasicBlock>& a, const Ref<BasicBlock>& b) {
+		bool aEntry = a->GetStart() == func->GetStart();
+		bool bEntry = b->GetStart() == func->GetStart();
+		if (aEntry != bEntry)
+			return aEntry;
+		return a->GetStart() < b->GetStart();
+	});
+	map<uint64_t, size_t> indices;
+	for (size_t i = 0; i < blocks.size(); i++)
+		indices[blocks[i]->GetStart()] = i;
+
+	sizes.clear();
+	keys.clear();
+	successors.assign(blocks.size(), {});
+	for (size_t i = 0; i < blocks.size(); i++)
+	{
+		sizes.emplace_back(400, (int)min<uint64_t>(blocks[i]->GetLength(), 4096) * 4 + 8);
+		keys.push_back(blocks[i]->GetStart());
+		for (auto& edge : blocks[i]->GetOutgoingEdges())
+		{
+			if (!edge.target)
+				continue;
+			auto target = indices.find(edge.target->GetStart());
+			if (target != indices.end())
+				successors[i].push_back(target->second);
+		}
+	}
+	return true;
+}
+
+
+static void PrintTiming(const char* name, size_t blocks, const Timing& timing)
+{
+	printf("%-32s %8zu %12.3f %12.3f %12.3f\n", name, blocks, timing.full, timing.resized, timing.edited);
+}
+
+
+int Benchmarks::FlowGraphLayoutBenchmark(int argc, char* argv[])
+{
+	LayeredFlowGraphLayout layout;
+	printf("%-32s %8s %12s %12s %12s\n", "graph", "blocks", "full ms", "resized ms", "edited ms");
+
+	mt19937 rng(1);
+	vector<pair<int, int>> sizes;
+	vector<vector<size_t>> successors;
+	vector<uint64_t> keys;
+	for (size_t blocks : {100, 1000, 5000, 20000})
+	{
+		GenerateGraph(blocks, rng, sizes, successors, keys);
+		char name[64];
+		snprintf(name, sizeof(name), "synthetic-%zu", blocks);
+		LayeredFlowGraphLayout::CacheKey key;
+		key.function = blocks;
+		PrintTiming(name, blocks, Measure(layout, sizes, successors, keys, key));
+	}
+
+	if (argc < 2)
+		return 0;
+
+	Ref<BinaryView> bv = OpenExecutable(argv[1]);
+	if (!bv)
+		return -1;
+
+	auto keyFor = [&](Ref<Function> func) {
+		LayeredFlowGraphLayout::CacheKey key;
+		key.view = (uint64_t)(uintptr_t)bv->GetObject();
+		key.function = func->GetStart();
+		return key;
+	};
+
+	Timing total;
+	vector<pair<size_t, Ref<Function>>> largest;
+	for (auto& func : bv->GetAnalysisFunctionList())
+	{
+		if (!BuildFunctionGraph(func, sizes, successors, keys))
+			continue;
+		Timing timing = Measure(layout, sizes, successors, keys, keyFor(func));
+		total.full += timing.full;
+		total.resized += timing.resized;
+		total.edited += timing.edited;
+		largest.emplace_back(sizes.size(), func);
+	}
+
+	// Show the largest functions individually
+	sort(largest.begin(), largest.end(),
+	    [](const pair<size_t, Ref<Function>>& a, const pair<size_t, Ref<Function>>& b) { return a.first > b.first; });
+	if (largest.size() > 10)
+		largest.resize(10);
+	for (auto& [blocks, func] : largest)
+	{
+		BuildFunctionGraph(func, sizes, successors, keys);
+		Ref<Symbol> sym = func->GetSymbol();
+		string name = sym ? sym->GetFullName() : fmt::format("sub_{:x}", func->GetStart());
+		PrintTiming(name.substr(0, 32).c_str(), blocks, Measure(layout, sizes, successors, keys, keyFor(func)));
+	}
+	PrintTiming("all functions", 0, total);
+
+	bv->GetFile()->Close();
+	return 0;
+}
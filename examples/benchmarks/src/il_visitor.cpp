@@ -0,0 +1,571 @@
+// IL expression visitors: VisitExprs against copies of the visitors it replaced, which recursed through
+// std::function for LLIL and MLIL and called through std::function for HLIL. Both must visit the same expressions
+// in the same order, and returning false must skip the sub-expressions.
+
+#include <cstdio>
+#include <functional>
+#include <stack>
+
+#include "benchmarks.h"
+#include "lowlevelilinstruction.h"
+#include "mediumlevelilinstruction.h"
+#include "highlevelilinstruction.h"
+
+using namespace BinaryNinja;
+using namespace std;
+
+
+static void RecursiveVisitExprs(
+    const LowLevelILInstruction& expr, const function<bool(const LowLevelILInstruction& expr)>& func)
+{
+	if (!func(expr))
+		return;
+	switch (expr.operation)
+	{
+	case LLIL_SET_REG:
+		RecursiveVisitExprs(expr.GetSourceExpr<LLIL_SET_REG>(), func);
+		break;
+	case LLIL_SET_REG_SPLIT:
+		RecursiveVisitExprs(expr.GetSourceExpr<LLIL_SET_REG_SPLIT>(), func);
+		break;
+	case LLIL_SET_REG_SSA:
+		RecursiveVisitExprs(expr.GetSourceExpr<LLIL_SET_REG_SSA>(), func);
+		break;
+	case LLIL_SET_REG_SSA_PARTIAL:
+		RecursiveVisitExprs(expr.GetSourceExpr<LLIL_SET_REG_SSA_PARTIAL>(), func);
+		break;
+	case LLIL_SET_REG_SPLIT_SSA:
+		RecursiveVisitExprs(expr.GetSourceExpr<LLIL_SET_REG_SPLIT_SSA>(), func);
+		break;
+	case LLIL_SET_REG_STACK_REL:
+		RecursiveVisitExprs(expr.GetDestExpr<LLIL_SET_REG_STACK_REL>(), func);
+		RecursiveVisitExprs(expr.GetSourceExpr<LLIL_SET_REG_STACK_REL>(), func);
+		break;
+	case LLIL_REG_STACK_PUSH:
+		RecursiveVisitExprs(expr.GetSourceExpr<LLIL_REG_STACK_PUSH>(), func);
+		break;
+	case LLIL_SET_REG_STACK_REL_SSA:
+		RecursiveVisitExprs(expr.GetDestExpr<LLIL_SET_REG_STACK_REL_SSA>(), func);
+		RecursiveVisitExprs(expr.GetSourceExpr<LLIL_SET_REG_STACK_REL_SSA>(), func);
+		break;
+	case LLIL_SET_REG_STACK_ABS_SSA:
+		RecursiveVisitExprs(expr.GetSourceExpr<LLIL_SET_REG_STACK_ABS_SSA>(), func);
+		break;
+	case LLIL_SET_FLAG:
+		RecursiveVisitExprs(expr.GetSourceExpr<LLIL_SET_FLAG>(), func);
+		break;
+	case LLIL_SET_FLAG_SSA:
+		RecursiveVisitExprs(expr.GetSourceExpr<LLIL_SET_FLAG_SSA>(), func);
+		break;
+	case LLIL_REG_STACK_REL:
+		RecursiveVisitExprs(expr.GetSourceExpr<LLIL_REG_STACK_REL>(), func);
+		break;
+	case LLIL_REG_STACK_FREE_REL:
+		RecursiveVisitExprs(expr.GetDestExpr<LLIL_REG_STACK_FREE_REL>(), func);
+		break;
+	case LLIL_REG_STACK_REL_SSA:
+		RecursiveVisitExprs(expr.GetSourceExpr<LLIL_REG_STACK_REL_SSA>(), func);
+		break;
+	case LLIL_REG_STACK_FREE_REL_SSA:
+		RecursiveVisitExprs(expr.GetDestExpr<LLIL_REG_STACK_FREE_REL_SSA>(), func);
+		break;
+	case LLIL_LOAD:
+		RecursiveVisitExprs(expr.GetSourceExpr<LLIL_LOAD>(), func);
+		break;
+	case LLIL_LOAD_SSA:
+		RecursiveVisitExprs(expr.GetSourceExpr<LLIL_LOAD_SSA>(), func);
+		break;
+	case LLIL_STORE:
+		RecursiveVisitExprs(expr.GetDestExpr<LLIL_STORE>(), func);
+		RecursiveVisitExprs(expr.GetSourceExpr<LLIL_STORE>(), func);
+		break;
+	case LLIL_STORE_SSA:
+		RecursiveVisitExprs(expr.GetDestExpr<LLIL_STORE_SSA>(), func);
+		RecursiveVisitExprs(expr.GetSourceExpr<LLIL_STORE_SSA>(), func);
+		break;
+	case LLIL_JUMP:
+		RecursiveVisitExprs(expr.GetDestExpr<LLIL_JUMP>(), func);
+		break;
+	case LLIL_JUMP_TO:
+		RecursiveVisitExprs(expr.GetDestExpr<LLIL_JUMP_TO>(), func);
+		break;
+	case LLIL_IF:
+		RecursiveVisitExprs(expr.GetConditionExpr<LLIL_IF>(), func);
+		break;
+	case LLIL_CALL:
+		RecursiveVisitExprs(expr.GetDestExpr<LLIL_CALL>(), func);
+		break;
+	case LLIL_CALL_STACK_ADJUST:
+		RecursiveVisitExprs(expr.GetDestExpr<LLIL_CALL_STACK_ADJUST>(), func);
+		break;
+	case LLIL_TAILCALL:
+		RecursiveVisitExprs(expr.GetDestExpr<LLIL_TAILCALL>(), func);
+		break;
+	case LLIL_CALL_SSA:
+		RecursiveVisitExprs(expr.GetDestExpr<LLIL_CALL_SSA>(), func);
+		for (auto i : expr.GetParameterExprs<LLIL_CALL_SSA>())
+			RecursiveVisitExprs(i, func);
+		break;
+	case LLIL_SYSCALL_SSA:
+		for (auto i : expr.GetParameterExprs<LLIL_SYSCALL_SSA>())
+			RecursiveVisitExprs(i, func);
+		break;
+	case LLIL_TAILCALL_SSA:
+		RecursiveVisitExprs(expr.GetDestExpr<LLIL_TAILCALL_SSA>(), func);
+		for (auto i : expr.GetParameterExprs<LLIL_TAILCALL_SSA>())
+			RecursiveVisitExprs(i, func);
+		break;
+	case LLIL_RET:
+		RecursiveVisitExprs(expr.GetDestExpr<LLIL_RET>(), func);
+		break;
+	case LLIL_PUSH:
+	case LLIL_NEG:
+	case LLIL_NOT:
+	case LLIL_SX:
+	case LLIL_ZX:
+	case LLIL_LOW_PART:
+	case LLIL_BOOL_TO_INT:
+	case LLIL_UNIMPL_MEM:
+	case LLIL_FSQRT:
+	case LLIL_FNEG:
+	case LLIL_FABS:
+	case LLIL_FLOAT_TO_INT:
+	case LLIL_INT_TO_FLOAT:
+	case LLIL_FLOAT_CONV:
+	case LLIL_ROUND_TO_INT:
+	case LLIL_FLOOR:
+	case LLIL_CEIL:
+	case LLIL_FTRUNC:
+		RecursiveVisitExprs(expr.AsOneOperand().GetSourceExpr(), func);
+		break;
+	case LLIL_ADD:
+	case LLIL_SUB:
+	case LLIL_AND:
+	case LLIL_OR:
+	case LLIL_XOR:
+	case LLIL_LSL:
+	case LLIL_LSR:
+	case LLIL_ASR:
+	case LLIL_ROL:
+	case LLIL_ROR:
+	case LLIL_MUL:
+	case LLIL_MULU_DP:
+	case LLIL_MULS_DP:
+	case LLIL_DIVU:
+	case LLIL_DIVS:
+	case LLIL_MODU:
+	case LLIL_MODS:
+	case LLIL_DIVU_DP:
+	case LLIL_DIVS_DP:
+	case LLIL_MODU_DP:
+	case LLIL_MODS_DP:
+	case LLIL_CMP_E:
+	case LLIL_CMP_NE:
+	case LLIL_CMP_SLT:
+	case LLIL_CMP_ULT:
+	case LLIL_CMP_SLE:
+	case LLIL_CMP_ULE:
+	case LLIL_CMP_SGE:
+	case LLIL_CMP_UGE:
+	case LLIL_CMP_SGT:
+	case LLIL_CMP_UGT:
+	case LLIL_TEST_BIT:
+	case LLIL_ADD_OVERFLOW:
+	case LLIL_FADD:
+	case LLIL_FSUB:
+	case LLIL_FMUL:
+	case LLIL_FDIV:
+	case LLIL_FCMP_E:
+	case LLIL_FCMP_NE:
+	case LLIL_FCMP_LT:
+	case LLIL_FCMP_LE:
+	case LLIL_FCMP_GE:
+	case LLIL_FCMP_GT:
+	case LLIL_FCMP_O:
+	case LLIL_FCMP_UO:
+		RecursiveVisitExprs(expr.AsTwoOperand().GetLeftExpr(), func);
+		RecursiveVisitExprs(expr.AsTwoOperand().GetRightExpr(), func);
+		break;
+	case LLIL_ADC:
+	case LLIL_SBB:
+	case LLIL_RLC:
+	case LLIL_RRC:
+		RecursiveVisitExprs(expr.AsTwoOperandWithCarry().GetLeftExpr(), func);
+		RecursiveVisitExprs(expr.AsTwoOperandWithCarry().GetRightExpr(), func);
+		RecursiveVisitExprs(expr.AsTwoOperandWithCarry().GetCarryExpr(), func);
+		break;
+	case LLIL_INTRINSIC:
+		for (auto i : expr.GetParameterExprs<LLIL_INTRINSIC>())
+			RecursiveVisitExprs(i, func);
+		break;
+	case LLIL_INTRINSIC_SSA:
+		for (auto i : expr.GetParameterExprs<LLIL_INTRINSIC_SSA>())
+			RecursiveVisitExprs(i, func);
+		break;
+	case LLIL_MEMORY_INTRINSIC_SSA:
+		for (auto i : expr.GetParameterExprs<LLIL_MEMORY_INTRINSIC_SSA>())
+			RecursiveVisitExprs(i, func);
+		break;
+	case LLIL_SEPARATE_PARAM_LIST_SSA:
+		for (auto i : expr.GetParameterExprs<LLIL_SEPARATE_PARAM_LIST_SSA>())
+			RecursiveVisitExprs(i, func);
+		break;
+	case LLIL_SHARED_PARAM_SLOT_SSA:
+		for (auto i : expr.GetParameterExprs<LLIL_SHARED_PARAM_SLOT_SSA>())
+			RecursiveVisitExprs(i, func);
+		break;
+	default:
+		break;
+	}
+}
+
+
+static void RecursiveVisitExprs(
+    const MediumLevelILInstruction& expr, const function<bool(const MediumLevelILInstruction& expr)>& func)
+{
+	if (!func(expr))
+		return;
+	switch (expr.operation)
+	{
+	case MLIL_SET_VAR:
+		RecursiveVisitExprs(expr.GetSourceExpr<MLIL_SET_VAR>(), func);
+		break;
+	case MLIL_SET_VAR_SSA:
+		RecursiveVisitExprs(expr.GetSourceExpr<MLIL_SET_VAR_SSA>(), func);
+		break;
+	case MLIL_SET_VAR_ALIASED:
+		RecursiveVisitExprs(expr.GetSourceExpr<MLIL_SET_VAR_ALIASED>(), func);
+		break;
+	case MLIL_SET_VAR_SPLIT:
+		RecursiveVisitExprs(expr.GetSourceExpr<MLIL_SET_VAR_SPLIT>(), func);
+		break;
+	case MLIL_SET_VAR_SPLIT_SSA:
+		RecursiveVisitExprs(expr.GetSourceExpr<MLIL_SET_VAR_SPLIT_SSA>(), func);
+		break;
+	case MLIL_SET_VAR_FIELD:
+		RecursiveVisitExprs(expr.GetSourceExpr<MLIL_SET_VAR_FIELD>(), func);
+		break;
+	case MLIL_SET_VAR_SSA_FIELD:
+		RecursiveVisitExprs(expr.GetSourceExpr<MLIL_SET_VAR_SSA_FIELD>(), func);
+		break;
+	case MLIL_SET_VAR_ALIASED_FIELD:
+		RecursiveVisitExprs(expr.GetSourceExpr<MLIL_SET_VAR_ALIASED_FIELD>(), func);
+		break;
+	case MLIL_CALL:
+		RecursiveVisitExprs(expr.GetDestExpr<MLIL_CALL>(), func);
+		for (auto i : expr.GetParameterExprs<MLIL_CALL>())
+			RecursiveVisitExprs(i, func);
+		break;
+	case MLIL_CALL_UNTYPED:
+		RecursiveVisitExprs(expr.GetDestExpr<MLIL_CALL_UNTYPED>(), func);
+		for (auto i : expr.GetParameterExprs<MLIL_CALL_UNTYPED>())
+			RecursiveVisitExprs(i, func);
+		break;
+	case MLIL_CALL_SSA:
+		RecursiveVisitExprs(expr.GetDestExpr<MLIL_CALL_SSA>(), func);
+		for (auto i : expr.GetParameterExprs<MLIL_CALL_SSA>())
+			RecursiveVisitExprs(i, func);
+		break;
+	case MLIL_CALL_UNTYPED_SSA:
+		RecursiveVisitExprs(expr.GetDestExpr<MLIL_CALL_UNTYPED_SSA>(), func);
+		for (auto i : expr.GetParameterExprs<MLIL_CALL_UNTYPED_SSA>())
+			RecursiveVisitExprs(i, func);
+		break;
+	case MLIL_SYSCALL:
+		for (auto i : expr.GetParameterExprs<MLIL_SYSCALL>())
+			RecursiveVisitExprs(i, func);
+		break;
+	case MLIL_SYSCALL_UNTYPED:
+		for (auto i : expr.GetParameterExprs<MLIL_SYSCALL_UNTYPED>())
+			RecursiveVisitExprs(i, func);
+		break;
+	case MLIL_SYSCALL_SSA:
+		for (auto i : expr.GetParameterExprs<MLIL_SYSCALL_SSA>())
+			RecursiveVisitExprs(i, func);
+		break;
+	case MLIL_SYSCALL_UNTYPED_SSA:
+		for (auto i : expr.GetParameterExprs<MLIL_SYSCALL_UNTYPED_SSA>())
+			RecursiveVisitExprs(i, func);
+		break;
+	case MLIL_TAILCALL:
+		RecursiveVisitExprs(expr.GetDestExpr<MLIL_TAILCALL>(), func);
+		for (auto i : expr.GetParameterExprs<MLIL_TAILCALL>())
+			RecursiveVisitExprs(i, func);
+		break;
+	case MLIL_TAILCALL_UNTYPED:
+		RecursiveVisitExprs(expr.GetDestExpr<MLIL_TAILCALL_UNTYPED>(), func);
+		for (auto i : expr.GetParameterExprs<MLIL_TAILCALL_UNTYPED>())
+			RecursiveVisitExprs(i, func);
+		break;
+	case MLIL_TAILCALL_SSA:
+		RecursiveVisitExprs(expr.GetDestExpr<MLIL_TAILCALL_SSA>(), func);
+		for (auto i : expr.GetParameterExprs<MLIL_TAILCALL_SSA>())
+			RecursiveVisitExprs(i, func);
+		break;
+	case MLIL_TAILCALL_UNTYPED_SSA:
+		RecursiveVisitExprs(expr.GetDestExpr<MLIL_TAILCALL_UNTYPED_SSA>(), func);
+		for (auto i : expr.GetParameterExprs<MLIL_TAILCALL_UNTYPED_SSA>())
+			RecursiveVisitExprs(i, func);
+		break;
+	case MLIL_SEPARATE_PARAM_LIST:
+		for (auto i : expr.GetParameterExprs<MLIL_SEPARATE_PARAM_LIST>())
+			RecursiveVisitExprs(i, func);
+		break;
+	case MLIL_SHARED_PARAM_SLOT:
+		for (auto i : expr.GetParameterExprs<MLIL_SHARED_PARAM_SLOT>())
+			RecursiveVisitExprs(i, func);
+		break;
+	case MLIL_RET:
+		for (auto i : expr.GetSourceExprs<MLIL_RET>())
+			RecursiveVisitExprs(i, func);
+		break;
+	case MLIL_STORE:
+		RecursiveVisitExprs(expr.GetDestExpr<MLIL_STORE>(), func);
+		RecursiveVisitExprs(expr.GetSourceExpr<MLIL_STORE>(), func);
+		break;
+	case MLIL_STORE_STRUCT:
+		RecursiveVisitExprs(expr.GetDestExpr<MLIL_STORE_STRUCT>(), func);
+		RecursiveVisitExprs(expr.GetSourceExpr<MLIL_STORE_STRUCT>(), func);
+		break;
+	case MLIL_STORE_SSA:
+		RecursiveVisitExprs(expr.GetDestExpr<MLIL_STORE_SSA>(), func);
+		RecursiveVisitExprs(expr.GetSourceExpr<MLIL_STORE_SSA>(), func);
+		break;
+	case MLIL_STORE_STRUCT_SSA:
+		RecursiveVisitExprs(expr.GetDestExpr<MLIL_STORE_STRUCT_SSA>(), func);
+		RecursiveVisitExprs(expr.GetSourceExpr<MLIL_STORE_STRUCT_SSA>(), func);
+		break;
+	case MLIL_NEG:
+	case MLIL_NOT:
+	case MLIL_SX:
+	case MLIL_ZX:
+	case MLIL_LOW_PART:
+	case MLIL_BOOL_TO_INT:
+	case MLIL_JUMP:
+	case MLIL_JUMP_TO:
+	case MLIL_RET_HINT:
+	case MLIL_IF:
+	case MLIL_UNIMPL_MEM:
+	case MLIL_LOAD:
+	case MLIL_LOAD_STRUCT:
+	case MLIL_LOAD_SSA:
+	case MLIL_LOAD_STRUCT_SSA:
+	case MLIL_FSQRT:
+	case MLIL_FNEG:
+	case MLIL_FABS:
+	case MLIL_FLOAT_TO_INT:
+	case MLIL_INT_TO_FLOAT:
+	case MLIL_FLOAT_CONV:
+	case MLIL_ROUND_TO_INT:
+	case MLIL_FLOOR:
+	case MLIL_CEIL:
+	case MLIL_FTRUNC:
+		RecursiveVisitExprs(expr.AsOneOperand().GetSourceExpr(), func);
+		break;
+	case MLIL_ADD:
+	case MLIL_SUB:
+	case MLIL_AND:
+	case MLIL_OR:
+	case MLIL_XOR:
+	case MLIL_LSL:
+	case MLIL_LSR:
+	case MLIL_ASR:
+	case MLIL_ROL:
+	case MLIL_ROR:
+	case MLIL_MUL:
+	case MLIL_MULU_DP:
+	case MLIL_MULS_DP:
+	case MLIL_DIVU:
+	case MLIL_DIVS:
+	case MLIL_MODU:
+	case MLIL_MODS:
+	case MLIL_DIVU_DP:
+	case MLIL_DIVS_DP:
+	case MLIL_MODU_DP:
+	case MLIL_MODS_DP:
+	case MLIL_CMP_E:
+	case MLIL_CMP_NE:
+	case MLIL_CMP_SLT:
+	case MLIL_CMP_ULT:
+	case MLIL_CMP_SLE:
+	case MLIL_CMP_ULE:
+	case MLIL_CMP_SGE:
+	case MLIL_CMP_UGE:
+	case MLIL_CMP_SGT:
+	case MLIL_CMP_UGT:
+	case MLIL_TEST_BIT:
+	case MLIL_ADD_OVERFLOW:
+	case MLIL_FADD:
+	case MLIL_FSUB:
+	case MLIL_FMUL:
+	case MLIL_FDIV:
+	case MLIL_FCMP_E:
+	case MLIL_FCMP_NE:
+	case MLIL_FCMP_LT:
+	case MLIL_FCMP_LE:
+	case MLIL_FCMP_GE:
+	case MLIL_FCMP_GT:
+	case MLIL_FCMP_O:
+	case MLIL_FCMP_UO:
+		RecursiveVisitExprs(expr.AsTwoOperand().GetLeftExpr(), func);
+		RecursiveVisitExprs(expr.AsTwoOperand().GetRightExpr(), func);
+		break;
+	case MLIL_ADC:
+	case MLIL_SBB:
+	case MLIL_RLC:
+	case MLIL_RRC:
+		RecursiveVisitExprs(expr.AsTwoOperandWithCarry().GetLeftExpr(), func);
+		RecursiveVisitExprs(expr.AsTwoOperandWithCarry().GetRightExpr(), func);
+		RecursiveVisitExprs(expr.AsTwoOperandWithCarry().GetCarryExpr(), func);
+		break;
+	case MLIL_INTRINSIC:
+		for (auto i : expr.GetParameterExprs<MLIL_INTRINSIC>())
+			RecursiveVisitExprs(i, func);
+		break;
+	case MLIL_INTRINSIC_SSA:
+	case MLIL_MEMORY_INTRINSIC_SSA:
+		for (auto i : expr.GetParameterExprs())
+			RecursiveVisitExprs(i, func);
+		break;
+	default:
+		break;
+	}
+}
+
+
+
+static void RecursiveVisitExprs(
+    const HighLevelILInstruction& expr, const function<bool(const HighLevelILInstruction& expr)>& func)
+{
+	stack<size_t> toProcess;
+	toProcess.push(expr.exprIndex);
+	while (!toProcess.empty())
+	{
+		HighLevelILInstruction cur = expr.function->GetExpr(toProcess.top(), expr.ast);
+		toProcess.pop();
+		if (!func(cur))
+			continue;
+		cur.CollectSubExprs(toProcess);
+	}
+}
+
+
+struct Timing
+{
+	size_t roots = 0;
+	size_t exprs = 0;
+	double baseline = 0;
+	double inlined = 0;
+};
+
+
+template <typename Instruction>
+static bool CheckVisitors(const vector<Instruction>& roots)
+{
+	for (const Instruction& root : roots)
+	{
+		vector<size_t> baseline, visited;
+		RecursiveVisitExprs(root, [&](const Instruction& expr) {
+			baseline.push_back(expr.exprIndex);
+			return true;
+		});
+		root.VisitExprs([&](const Instruction& expr) {
+			visited.push_back(expr.exprIndex);
+			return true;
+		});
+		if (visited != baseline)
+			return false;
+
+		// Skipping the sub-expressions of the root must leave only the root
+		size_t count = 0;
+		root.VisitExprs([&](const Instruction&) {
+			count++;
+			return false;
+		});
+		if (count != 1)
+			return false;
+	}
+	return true;
+}
+
+
+template <typename Instruction>
+static Timing Measure(const vector<Instruction>& roots)
+{
+	Timing timing;
+	timing.roots = roots.size();
+	size_t count = 0;
+	timing.baseline = Benchmarks::BestOf([&]() {
+		count = 0;
+		for (const Instruction& root : roots)
+		{
+			RecursiveVisitExprs(root, [&](const Instruction&) {
+				count++;
+				return true;
+			});
+		}
+	});
+	timing.inlined = Benchmarks::BestOf([&]() {
+		count = 0;
+		for (const Instruction& root : roots)
+		{
+			root.VisitExprs([&](const Instruction&) {
+				count++;
+				return true;
+			});
+		}
+	});
+	timing.exprs = count;
+	return timing;
+}
+
+
+static void PrintTiming(const char* name, const Timing& timing)
+{
+	printf("%-8s %10zu %10zu %16.3f %16.3f\n", name, timing.roots, timing.exprs, timing.baseline * 1000,
+	    timing.inlined * 1000);
+}
+
+
+int Benchmarks::ILVisitorBenchmark(int argc, char* argv[])
+{
+	if (argc != 2)
+	{
+		fprintf(stderr, "USAGE: il_visitor <file_name>\n");
+		return -1;
+	}
+
+	Ref<BinaryView> bv = OpenExecutable(argv[1]);
+	if (!bv)
+		return -1;
+
+	// Gather the root expressions up front so that only the traversal is timed
+	vector<LowLevelILInstruction> llil;
+	vector<MediumLevelILInstruction> mlil;
+	vector<HighLevelILInstruction> hlil;
+	for (auto& func : bv->GetAnalysisFunctionList())
+	{
+		if (Ref<LowLevelILFunction> il = func->GetLowLevelIL())
+		{
+			for (size_t i = 0; i < il->GetInstructionCount(); i++)
+				llil.push_back(il->GetInstruction(i));
+		}
+		if (Ref<MediumLevelILFunction> il = func->GetMediumLevelIL())
+		{
+			for (size_t i = 0; i < il->GetInstructionCount(); i++)
+				mlil.push_back(il->GetInstruction(i));
+		}
+		if (Ref<HighLevelILFunction> il = func->GetHighLevelIL())
+			hlil.push_back(il->GetRootExpr());
+	}
+
+	bool ok = CheckVisitors(llil) && CheckVisitors(mlil) && CheckVisitors(hlil);
+
+	printf("%-8s %10s %10s %16s %16s\n", "IL", "roots", "exprs", "baseline ms", "VisitExprs ms");
+	PrintTiming("LLIL", Measure(llil));
+	PrintTiming("MLIL", Measure(mlil));
+	PrintTiming("HLIL", Measure(hlil));
+
+	bv->GetFile()->Close();
+	return ReportCheck("visitor order", ok);
+}
@@ -0,0 +1,109 @@
+// Typed AnalysisContext::Inform serializer: requests shaped like the ones the tailcall workflow sends for every call
+// site are serialized once by building a Json::Value array and writing it with Json::writeString as Inform used to,
+// and once with AnalysisContext::SerializeInformRequest. Both must parse back to the same JSON, including strings that
+// need escaping and integers at the ends of their range.
+
+#include <cstdint>
+#include <cstdio>
+#include <limits>
+#include <memory>
+
+#include "benchmarks.h"
+
+using namespace BinaryNinja;
+using namespace std;
+
+
+static constexpr size_t Requests = 1000000;
+
+
+// The Json::Value path that Inform used before it took typed arguments
+static string SerializeWithJson(Json::StreamWriterBuilder& builder, const vector<AnalysisContext::InformArgument>& args)
+{
+	Json::Value request(Json::arrayValue);
+	for (auto& arg : args)
+	{
+		switch (arg.GetKind())
+		{
+		case AnalysisContext::InformArgument::StringArgument:
+			request.append(Json::Value(string(arg.GetString())));
+			break;
+		case AnalysisContext::InformArgument::IntegerArgument:
+			request.append(Json::Value((Json::UInt64)arg.GetInteger()));
+			break;
+		default:
+			request.append(Json::Value(arg.GetArchitecture()->GetName()));
+			break;
+		}
+	}
+	return Json::writeString(builder, request);
+}
+
+
+static bool Parse(const string& text, Json::Value& value)
+{
+	unique_ptr<Json::CharReader> reader(Json::CharReaderBuilder().newCharReader());
+	string errors;
+	return reader->parse(text.data(), text.data() + text.size(), &value, &errors);
+}
+
+
+static bool CheckRequests(Json::StreamWriterBuilder& builder)
+{
+	const string quoted = "say \"hi\"\\path";
+	const string control = string("tab\tline\nreturn\rbell\x07nul") + '\0' + "end";
+	const string utf8 = "na\xc3\xafve \xe2\x86\x92 \xf0\x9f\x94\xa5";
+	const vector<vector<AnalysisContext::InformArgument>> requests = {
+	    {},
+	    {"directRefs", "insert", (uint64_t)0x401000, "x86_64", (uint64_t)0x400ff0},
+	    {quoted, control, utf8, ""},
+	    {(uint64_t)0, numeric_limits<uint64_t>::max(), (uint32_t)0xffffffff, (uint8_t)7, true},
+	};
+
+	string request;
+	for (size_t i = 0; i < requests.size(); i++)
+	{
+		AnalysisContext::SerializeInformRequest(requests[i].data(), requests[i].size(), request);
+		Json::Value typed, json;
+		if (!Parse(request, typed) || !Parse(SerializeWithJson(builder, requests[i]), json) || typed != json)
+		{
+			fprintf(stderr, "Request %zu serialized differently: %s\n", i, request.c_str());
+			return false;
+		}
+	}
+	return true;
+}
+
+
+int Benchmarks::InformBenchmark(int, char*[])
+{
+	Json::StreamWriterBuilder builder;
+	builder["indentation"] = "";
+
+	bool ok = CheckRequests(builder);
+
+	size_t jsonBytes = 0, typedBytes = 0;
+	double json = BestOf([&]() {
+		for (size_t i = 0; i < Requests; i++)
+		{
+			vector<AnalysisContext::InformArgument> args = {"directRefs", "insert", 0x400000 + i * 16, "x86_64", 0x400000 + i};
+			jsonBytes += SerializeWithJson(builder, args).size();
+		}
+	});
+
+	string request;
+	double typed = BestOf([&]() {
+		for (size_t i = 0; i < Requests; i++)
+		{
+			const AnalysisContext::InformArgument args[] = {"directRefs", "insert", 0x400000 + i * 16, "x86_64", 0x400000 + i};
+			AnalysisContext::SerializeInformRequest(args, 5, request);
+			typedBytes += request.size();
+		}
+	});
+	ok = ok && (jsonBytes == typedBytes);
+
+	printf("%-16s %16s\n", "", "requests/s");
+	printf("%-16s %16.0f\n", "Json::Value", Requests / json);
+	printf("%-16s %16.0f\n", "typed", Requests / typed);
+	return ReportCheck("request format", ok);
+}
@@ -0,0 +1,164 @@
+// Array-owning object lists: GetAnalysisFunctionArray and GetSymbolArray must return the same objects in the same
+// order as the vector returning calls, a temporary Ref to a borrowed element must not destroy it, and elements kept
+// with Retain must stay valid after the array is gone. The ForEachAnalysisFunction and ForEachSymbol visitors, which
+// walk the same arrays, must visit the same objects.
+
+#include <cstdio>
+#include <type_traits>
+
+#include "benchmarks.h"
+
+using namespace BinaryNinja;
+using namespace std;
+
+
+// Keeping an element past the lifetime of its array has to go through Retain
+static_assert(!is_convertible_v<BorrowedRef<Function>, Ref<Function>>);
+static_assert(!is_convertible_v<BorrowedRef<Function>, Function*>);
+
+
+static bool CheckFunctions(Ref<BinaryView> bv)
+{
+	vector<Ref<Function>> list = bv->GetAnalysisFunctionList();
+	vector<Ref<Function>> retained;
+	{
+		FunctionArray array = bv->GetAnalysisFunctionArray();
+		if (array.size() != list.size())
+		{
+			fprintf(stderr, "Function array has %zu entries, list has %zu\n", array.size(), list.size());
+			return false;
+		}
+		for (size_t i = 0; i < array.size(); i++)
+		{
+			BorrowedRef<Function> func = array[i];
+			if (func != list[i] || func->GetStart() != list[i]->GetStart())
+			{
+				fprintf(stderr, "Function array entry %zu differs from the list\n", i);
+				return false;
+			}
+
+			// Passing the borrowed object to a call that takes a Ref must leave it intact
+			{
+				Ref<Function> temporary = func.GetPtr();
+			}
+			if (func->GetStart() != list[i]->GetStart())
+			{
+				fprintf(stderr, "Function array entry %zu was released by a temporary Ref\n", i);
+				return false;
+			}
+		}
+		retained = array.ToVector();
+	}
+
+	size_t visited = 0;
+	bool same = bv->ForEachAnalysisFunction([&](BorrowedRef<Function> func) {
+		return visited < list.size() && func == list[visited++];
+	});
+	if (!same || visited != list.size())
+	{
+		fprintf(stderr, "ForEachAnalysisFunction differs from the list at entry %zu\n", visited);
+		return false;
+	}
+
+	for (size_t i = 0; i < list.size(); i++)
+	{
+		if (retained[i] != list[i] || retained[i]->GetStart() != list[i]->GetStart())
+		{
+			fprintf(stderr, "Retained function %zu did not outlive its array\n", i);
+			return false;
+		}
+	}
+	return true;
+}
+
+
+static bool CheckSymbols(Ref<BinaryView> bv)
+{
+	vector<Ref<Symbol>> list = bv->GetSymbols();
+	Ref<Symbol> first;
+	{
+		SymbolArray array = bv->GetSymbolArray();
+		if (array.size() != list.size())
+		{
+			fprintf(stderr, "Symbol array has %zu entries, list has %zu\n", array.size(), list.size());
+			return false;
+		}
+		size_t i = 0;
+		for (BorrowedRef<Symbol> sym : array)
+		{
+			if (sym != list[i] || sym->GetAddress() != list[i]->GetAddress())
+			{
+				fprintf(stderr, "Symbol array entry %zu differs from the list\n", i);
+				return false;
+			}
+			i++;
+		}
+		if (!array.empty())
+			first = array[0].Retain();
+	}
+
+	size_t visited = 0;
+	bool same = bv->ForEachSymbol([&](BorrowedRef<Symbol> sym) {
+		return visited < list.size() && sym == list[visited++];
+	});
+	if (!same || visited != list.size())
+	{
+		fprintf(stderr, "ForEachSymbol differs from the list at entry %zu\n", visited);
+		return false;
+	}
+
+	if (!list.empty() && (first != list[0] || first->GetRawName() != list[0]->GetRawName()))
+	{
+		fprintf(stderr, "Retained symbol did not outlive its array\n");
+		return false;
+	}
+	return true;
+}
+
+
+int Benchmarks::ObjectArrayBenchmark(int argc, char* argv[])
+{
+	if (argc != 2)
+	{
+		fprintf(stderr, "USAGE: object_array <file_name>\n");
+		return -1;
+	}
+
+	Ref<BinaryView> bv = OpenExecutable(argv[1]);
+	if (!bv)
+		return -1;
+
+	bool ok = CheckFunctions(bv) && CheckSymbols(bv);
+
+	uint64_t listSum = 0, arraySum = 0;
+	double functionList = BestOf([&]() {
+		listSum = 0;
+		for (auto& func : bv->GetAnalysisFunctionList())
+			listSum += func->GetStart();
+	});
+	double functionArray = BestOf([&]() {
+		arraySum = 0;
+		for (auto func : bv->GetAnalysisFunctionArray())
+			arraySum += func->GetStart();
+	});
+	ok = ok && (listSum == arraySum);
+
+	double symbolList = BestOf([&]() {
+		listSum = 0;
+		for (auto& sym : bv->GetSymbols())
+			listSum += sym->GetAddress();
+	});
+	double symbolArray = BestOf([&]() {
+		arraySum = 0;
+		for (auto sym : bv->GetSymbolArray())
+			arraySum += sym->GetAddress();
+	});
+	ok = ok && (listSum == arraySum);
+
+	printf("%-12s %12s %12s\n", "", "vector ms", "array ms");
+	printf("%-12s %12.3f %12.3f\n", "functions", functionList * 1000, functionArray * 1000);
+	printf("%-12s %12.3f %12.3f\n", "symbols", symbolList * 1000, symbolArray * 1000);
+
+	bv->GetFile()->Close();
+	return ReportCheck("borrowed reference", ok);
+}
@@ -0,0 +1,125 @@
+// BinaryView::ReadMany: an in-memory view holds a table of 1M pointers into the view, and the table entries and the
+// data they point at are read once with a loop of Read calls and once with ReadMany. Both must return the same bytes.
+// Ranges that overlap, are unsorted, are empty or run past the end of the view must report the same result as Read.
+
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <random>
+
+#include "benchmarks.h"
+
+using namespace BinaryNinja;
+using namespace std;
+
+
+static constexpr size_t TableEntries = 1 << 20;
+static constexpr size_t TargetSize = 16;
+
+
+static bool CheckRanges(Ref<BinaryView> view, const DataBuffer& contents)
+{
+	const uint8_t* contentsData = (const uint8_t*)contents.GetData();
+	uint64_t end = contents.GetLength();
+
+	// Unsorted, overlapping, adjacent, empty and partially backed ranges in one batch
+	vector<pair<uint64_t, size_t>> requests = {{0x1000, 32}, {0x10, 8}, {0x1010, 64}, {0x18, 8}, {0x20, 0},
+	    {end - 4, 16}, {end + 0x100, 8}, {0x1000, 32}, {0x40000, 0x20000}, {0x14, 4}};
+
+	vector<vector<uint8_t>> buffers(requests.size());
+	vector<BinaryView::ReadRange> ranges;
+	for (size_t i = 0; i < requests.size(); i++)
+	{
+		buffers[i].assign(requests[i].second, 0xcc);
+		ranges.emplace_back(requests[i].first, requests[i].second, buffers[i].data());
+	}
+
+	size_t complete = view->ReadMany(ranges);
+	size_t expectedComplete = 0;
+	for (size_t i = 0; i < requests.size(); i++)
+	{
+		auto [address, length] = requests[i];
+		size_t expected = address >= end ? 0 : (size_t)min<uint64_t>(length, end - address);
+		if (expected == length)
+			expectedComplete++;
+
+		vector<uint8_t> single(length);
+		size_t singleRead = length ? view->Read(single.data(), address, length) : 0;
+		if (ranges[i].bytesRead != expected || ranges[i].bytesRead != singleRead
+		    || ranges[i].Succeeded() != (expected == length))
+		{
+			fprintf(stderr, "Range %zu at 0x%" PRIx64 " read %zu bytes, expected %zu\n", i, address,
+			    ranges[i].bytesRead, expected);
+			return false;
+		}
+		if (expected && (memcmp(buffers[i].data(), contentsData + address, expected) != 0
+		    || memcmp(buffers[i].data(), single.data(), expected) != 0))
+		{
+			fprintf(stderr, "Range %zu at 0x%" PRIx64 " has the wrong contents\n", i, address);
+			return false;
+		}
+	}
+	if (complete != expectedComplete)
+	{
+		fprintf(stderr, "ReadMany reported %zu complete ranges, expected %zu\n", complete, expectedComplete);
+		return false;
+	}
+	return true;
+}
+
+
+int Benchmarks::ReadManyBenchmark(int, char*[])
+{
+	// The pointer table is followed by the data it points into
+	mt19937_64 rng(1);
+	size_t tableSize = TableEntries * sizeof(uint64_t);
+	size_t dataSize = TableEntries * TargetSize;
+	DataBuffer contents(tableSize + dataSize);
+	uint8_t* contentsData = (uint8_t*)contents.GetData();
+	for (size_t i = 0; i < TableEntries; i++)
+	{
+		uint64_t target = tableSize + (rng() % (dataSize / TargetSize)) * TargetSize;
+		memcpy(contentsData + i * sizeof(uint64_t), &target, sizeof(target));
+	}
+	for (size_t i = tableSize; i < contents.GetLength(); i++)
+		contentsData[i] = (uint8_t)rng();
+
+	Ref<FileMetadata> file = new FileMetadata();
+	Ref<BinaryView> view = new BinaryData(file, contents);
+
+	bool ok = CheckRanges(view, contents);
+
+	vector<uint64_t> pointers(TableEntries), batchPointers(TableEntries);
+	double tableLoop = BestOf([&]() {
+		for (size_t i = 0; i < TableEntries; i++)
+			view->Read(&pointers[i], i * sizeof(uint64_t), sizeof(uint64_t));
+	});
+	vector<BinaryView::ReadRange> ranges(TableEntries);
+	double tableBatch = BestOf([&]() {
+		for (size_t i = 0; i < TableEntries; i++)
+			ranges[i] = BinaryView::ReadRange(i * sizeof(uint64_t), sizeof(uint64_t), &batchPointers[i]);
+		if (view->ReadMany(ranges) != TableEntries)
+			ok = false;
+	});
+	ok = ok && (pointers == batchPointers) && memcmp(pointers.data(), contentsData, tableSize) == 0;
+
+	vector<uint8_t> targets(TableEntries * TargetSize), batchTargets(TableEntries * TargetSize);
+	double targetLoop = BestOf([&]() {
+		for (size_t i = 0; i < TableEntries; i++)
+			view->Read(&targets[i * TargetSize], pointers[i], TargetSize);
+	});
+	double targetBatch = BestOf([&]() {
+		for (size_t i = 0; i < TableEntries; i++)
+			ranges[i] = BinaryView::ReadRange(pointers[i], TargetSize, &batchTargets[i * TargetSize]);
+		if (view->ReadMany(ranges) != TableEntries)
+			ok = false;
+	});
+	ok = ok && (targets == batchTargets);
+
+	printf("%-16s %12s %12s\n", "", "Read ms", "ReadMany ms");
+	printf("%-16s %12.3f %12.3f\n", "pointer table", tableLoop * 1000, tableBatch * 1000);
+	printf("%-16s %12.3f %12.3f\n", "pointer targets", targetLoop * 1000, targetBatch * 1000);
+
+	file->Close();
+	return ReportCheck("read range", ok);
+}
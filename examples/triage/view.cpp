@@ -207,11 +207,11 @@ bool TriageView::navigate(uint64_t addr)
 void TriageView::startFullAnalysis()
 {
 	BinaryNinja::Settings::Instance()->Set("analysis.mode", "full", m_data);
-	for (auto& f : m_data->GetAnalysisFunctionList())
-	{
+	m_data->ForEachAnalysisFunction([](BinaryNinja::BorrowedRef<BinaryNinja::Function> f) {
 		if (f->IsAnalysisSkipped())
 			f->Reanalyze();
-	}
+		return true;
+	});
 	m_data->UpdateAnalysis();
 	m_fullAnalysisButton->hide();
 }
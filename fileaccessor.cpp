@@ -18,8 +18,17 @@
 // FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
 // IN THE SOFTWARE.
 
+#include <algorithm>
+#include <cstring>
 #include "binaryninjaapi.h"
 
+#ifndef WIN32
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+#endif
+
 using namespace BinaryNinja;
 using namespace std;
 
@@ -76,3 +85,309 @@ size_t CoreFileAccessor::Write(uint64_t offset, const void* src, size_t len)
 {
 	return m_callbacks.write(m_callbacks.context, offset, src, len);
 }
+
+
+// Number of back to back reads before the access pattern is treated as sequential
+static constexpr uint32_t SequentialReadThreshold = 4;
+// Amount of data requested ahead of a sequential reader
+static constexpr uint64_t ReadAheadWindow = 0x400000;
+// Number of pages queried per residency call
+static constexpr uint64_t ResidencyQueryPages = 0x10000;
+
+
+struct MappedFileAccessor::MappedFile
+{
+	uint8_t* data = nullptr;
+	uint64_t length = 0;
+	uint64_t pageSize = 0x1000;
+	bool valid = false;
+#ifdef WIN32
+	HANDLE file = INVALID_HANDLE_VALUE;
+	HANDLE mapping = nullptr;
+#endif
+
+	// The mapping itself is read-only. Written pages are copied into a sparse overlay, which is guarded by writeMutex.
+	// modifiedPageCount mirrors its size so that reads of an unmodified file do not need the lock.
+	mutex writeMutex;
+	map<uint64_t, unique_ptr<uint8_t[]>> modifiedPages;
+	atomic<uint64_t> modifiedPageCount {0};
+
+	atomic<uint64_t> nextSequentialOffset {0};
+	atomic<uint32_t> sequentialReads {0};
+	atomic<bool> sequential {false};
+	atomic<uint64_t> readAheadEnd {0};
+
+	enum AccessHint
+	{
+		NormalAccess,
+		SequentialAccess,
+		PrefetchAccess
+	};
+
+	void Advise(uint64_t offset, uint64_t len, AccessHint hint)
+	{
+#ifdef WIN32
+		(void)offset;
+		(void)len;
+		(void)hint;
+#else
+		uint64_t start = offset & ~(pageSize - 1);
+		uint64_t end = min(length, offset + len);
+		if (!data || end <= start)
+			return;
+		int advice = MADV_NORMAL;
+		if (hint == SequentialAccess)
+			advice = MADV_SEQUENTIAL;
+		else if (hint == PrefetchAccess)
+			advice = MADV_WILLNEED;
+		madvise(data + start, (size_t)(end - start), advice);
+#endif
+	}
+
+	void NoteRead(uint64_t offset, size_t len)
+	{
+		uint64_t end = offset + len;
+		uint64_t expected = nextSequentialOffset.exchange(end, memory_order_relaxed);
+		if (offset != expected)
+		{
+			sequentialReads.store(0, memory_order_relaxed);
+			if (sequential.exchange(false, memory_order_relaxed))
+			{
+				readAheadEnd.store(0, memory_order_relaxed);
+				Advise(0, length, NormalAccess);
+			}
+			return;
+		}
+
+		if (sequentialReads.fetch_add(1, memory_order_relaxed) + 1 < SequentialReadThreshold)
+			return;
+		if (!sequential.exchange(true, memory_order_relaxed))
+			Advise(0, length, SequentialAccess);
+
+		// Keep at least half a window of data requested ahead of the reader
+		uint64_t prefetched = readAheadEnd.load(memory_order_relaxed);
+		if (end >= length || end + ReadAheadWindow / 2 <= prefetched)
+			return;
+		uint64_t start = max(prefetched, end);
+		uint64_t stop = min(length, start + ReadAheadWindow);
+		if (readAheadEnd.compare_exchange_strong(prefetched, stop, memory_order_relaxed))
+			Advise(start, stop - start, PrefetchAccess);
+	}
+};
+
+
+MappedFileAccessor::MappedFileAccessor(const string& path) : m_file(make_unique<MappedFile>())
+{
+#ifdef WIN32
+	SYSTEM_INFO info;
+	GetSystemInfo(&info);
+	m_file->pageSize = info.dwPageSize;
+
+	int wideLen = MultiByteToWideChar(CP_UTF8, 0, path.c_str(), -1, nullptr, 0);
+	if (wideLen <= 0)
+		return;
+	wstring widePath(wideLen, L'\0');
+	MultiByteToWideChar(CP_UTF8, 0, path.c_str(), -1, &widePath[0], wideLen);
+
+	m_file->file = CreateFileW(widePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+	    FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (m_file->file == INVALID_HANDLE_VALUE)
+		return;
+
+	LARGE_INTEGER size;
+	if (!GetFileSizeEx(m_file->file, &size))
+		return;
+	m_file->length = (uint64_t)size.QuadPart;
+	if (m_file->length == 0)
+	{
+		m_file->valid = true;
+		return;
+	}
+
+	m_file->mapping = CreateFileMappingW(m_file->file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (!m_file->mapping)
+		return;
+	m_file->data = (uint8_t*)MapViewOfFile(m_file->mapping, FILE_MAP_READ, 0, 0, 0);
+	if (!m_file->data)
+		return;
+#else
+	long pageSize = sysconf(_SC_PAGESIZE);
+	if (pageSize > 0)
+		m_file->pageSize = (uint64_t)pageSize;
+
+	int fd = open(path.c_str(), O_RDONLY);
+	if (fd < 0)
+		return;
+
+	struct stat st;
+	if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode))
+	{
+		close(fd);
+		return;
+	}
+	m_file->length = (uint64_t)st.st_size;
+	if (m_file->length == 0)
+	{
+		close(fd);
+		m_file->valid = true;
+		return;
+	}
+
+	void* data = mmap(nullptr, (size_t)m_file->length, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if (data == MAP_FAILED)
+		return;
+	m_file->data = (uint8_t*)data;
+#endif
+
+	m_file->valid = true;
+}
+
+
+MappedFileAccessor::~MappedFileAccessor()
+{
+#ifdef WIN32
+	if (m_file->data)
+		UnmapViewOfFile(m_file->data);
+	if (m_file->mapping)
+		CloseHandle(m_file->mapping);
+	if (m_file->file != INVALID_HANDLE_VALUE)
+		CloseHandle(m_file->file);
+#else
+	if (m_file->data)
+		munmap(m_file->data, (size_t)m_file->length);
+#endif
+}
+
+
+bool MappedFileAccessor::IsValid() const
+{
+	return m_file->valid;
+}
+
+
+uint64_t MappedFileAccessor::GetLength() const
+{
+	return m_file->length;
+}
+
+
+size_t MappedFileAccessor::Read(void* dest, uint64_t offset, size_t len)
+{
+	if (!m_file->data || offset >= m_file->length)
+		return 0;
+	len = (size_t)min<uint64_t>(len, m_file->length - offset);
+
+	if (m_file->modifiedPageCount.load(memory_order_acquire) == 0)
+	{
+		memcpy(dest, m_file->data + offset, len);
+	}
+	else
+	{
+		// Copy runs of unmodified pages from the mapping and modified pages from the overlay
+		unique_lock<mutex> lock(m_file->writeMutex);
+		uint8_t* out = (uint8_t*)dest;
+		uint64_t pos = offset;
+		uint64_t end = offset + len;
+		auto page = m_file->modifiedPages.lower_bound(pos / m_file->pageSize);
+		while (pos < end)
+		{
+			uint64_t pageStart = (pos / m_file->pageSize) * m_file->pageSize;
+			if (page != m_file->modifiedPages.end() && page->first == pos / m_file->pageSize)
+			{
+				uint64_t chunk = min(end, pageStart + m_file->pageSize) - pos;
+				memcpy(out, page->second.get() + (pos - pageStart), (size_t)chunk);
+				out += chunk;
+				pos += chunk;
+				++page;
+				continue;
+			}
+
+			uint64_t stop = end;
+			if (page != m_file->modifiedPages.end())
+				stop = min(stop, page->first * m_file->pageSize);
+			memcpy(out, m_file->data + pos, (size_t)(stop - pos));
+			out += stop - pos;
+			pos = stop;
+		}
+	}
+
+	m_file->NoteRead(offset, len);
+	return len;
+}
+
+
+size_t MappedFileAccessor::Write(uint64_t offset, const void* src, size_t len)
+{
+	if (!m_file->data || offset >= m_file->length)
+		return 0;
+	len = (size_t)min<uint64_t>(len, m_file->length - offset);
+	if (len == 0)
+		return 0;
+
+	unique_lock<mutex> lock(m_file->writeMutex);
+	const uint8_t* in = (const uint8_t*)src;
+	uint64_t pos = offset;
+	uint64_t end = offset + len;
+	while (pos < end)
+	{
+		uint64_t pageIndex = pos / m_file->pageSize;
+		uint64_t pageStart = pageIndex * m_file->pageSize;
+		auto& page = m_file->modifiedPages[pageIndex];
+		if (!page)
+		{
+			// A page is copied from the file the first time it is written
+			page = make_unique<uint8_t[]>((size_t)m_file->pageSize);
+			memcpy(page.get(), m_file->data + pageStart, (size_t)min(m_file->pageSize, m_file->length - pageStart));
+			m_file->modifiedPageCount.store(m_file->modifiedPages.size(), memory_order_release);
+		}
+
+		uint64_t chunk = min(end, pageStart + m_file->pageSize) - pos;
+		memcpy(page.get() + (pos - pageStart), in, (size_t)chunk);
+		in += chunk;
+		pos += chunk;
+	}
+	return len;
+}
+
+
+bool MappedFileAccessor::IsModified() const
+{
+	return m_file->modifiedPageCount.load(memory_order_acquire) != 0;
+}
+
+
+bool MappedFileAccessor::GetResidencyStats(ResidencyStats& stats) const
+{
+	stats = ResidencyStats();
+	stats.pageSize = m_file->pageSize;
+	stats.totalPages = (m_file->length + m_file->pageSize - 1) / m_file->pageSize;
+	stats.modifiedPages = m_file->modifiedPageCount.load(memory_order_acquire);
+	if (!m_file->data)
+		return m_file->valid;
+
+#ifdef WIN32
+	return false;
+#else
+#ifdef __APPLE__
+	vector<char> residency;
+#else
+	vector<unsigned char> residency;
+#endif
+	for (uint64_t page = 0; page < stats.totalPages; page += ResidencyQueryPages)
+	{
+		uint64_t count = min(ResidencyQueryPages, stats.totalPages - page);
+		uint64_t offset = page * m_file->pageSize;
+		uint64_t len = min(count * m_file->pageSize, m_file->length - offset);
+		residency.resize((size_t)count);
+		if (mincore(m_file->data + offset, (size_t)len, residency.data()) != 0)
+			return false;
+		for (auto entry : residency)
+		{
+			if (entry & 1)
+				stats.residentPages++;
+		}
+	}
+	return true;
+#endif
+}
@@ -18,6 +18,9 @@
 // FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
 // IN THE SOFTWARE.
 
+#include <algorithm>
+#include <cmath>
+#include <list>
 #include "binaryninjaapi.h"
 
 using namespace BinaryNinja;
@@ -115,3 +118,817 @@ bool CoreFlowGraphLayout::Layout(Ref<FlowGraph> graph, std::vector<Ref<FlowGraph
 	delete[] nodeList;
 	return result;
 }
+
+
+namespace BinaryNinja
+{
+	struct LayeredFlowGraphLayoutCache
+	{
+		// Layered form of a graph. Layout nodes are the original nodes followed by the virtual nodes that long
+		// edges are split into, and every edge between layout nodes joins adjacent layers.
+		struct Entry
+		{
+			vector<uint64_t> nodeKeys;
+			vector<size_t> edgeStarts;
+			vector<size_t> edgeTargets;
+
+			size_t layoutNodeCount = 0;
+			vector<uint32_t> layers;
+			vector<uint32_t> layerStarts;
+			vector<uint32_t> order;
+			vector<uint32_t> upStarts, up;
+			vector<uint32_t> downStarts, down;
+
+			// Virtual nodes of each original edge, from the upper end to the lower end
+			vector<uint32_t> chainStarts, chains;
+			vector<bool> reversed;
+
+			size_t crossings = 0;
+			// Centers of all layout nodes from the layout that built this entry, used as the starting point
+			// when the same graph is laid out again and to seed the ordering after an edit
+			vector<double> centers;
+		};
+
+		mutex cacheMutex;
+		list<pair<LayeredFlowGraphLayout::CacheKey, shared_ptr<const Entry>>> entries;
+	};
+}
+
+
+static constexpr size_t MaxCachedLayouts = 32;
+static constexpr size_t MaxCrossingSweeps = 24;
+static constexpr size_t SweepsWithoutImprovement = 2;
+static constexpr size_t CoordinatePasses = 8;
+static constexpr size_t CachedCoordinatePasses = 2;
+
+
+static void BuildNeighborLists(size_t nodeCount, const vector<pair<uint32_t, uint32_t>>& segments,
+    vector<uint32_t>& starts, vector<uint32_t>& neighbors, bool upward)
+{
+	starts.assign(nodeCount + 1, 0);
+	for (auto& [from, to] : segments)
+		starts[(upward ? to : from) + 1]++;
+	for (size_t i = 0; i < nodeCount; i++)
+		starts[i + 1] += starts[i];
+	neighbors.resize(segments.size());
+	vector<uint32_t> next(starts.begin(), starts.end() - 1);
+	for (auto& [from, to] : segments)
+	{
+		if (upward)
+			neighbors[next[to]++] = from;
+		else
+			neighbors[next[from]++] = to;
+	}
+}
+
+
+static size_t CountCrossings(const LayeredFlowGraphLayoutCache::Entry& entry, const vector<uint32_t>& positions)
+{
+	// Count inversions of the lower endpoints, in upper endpoint order, with a Fenwick tree
+	size_t result = 0;
+	vector<uint32_t> lower;
+	vector<uint32_t> tree;
+	for (size_t layer = 0; layer + 2 < entry.layerStarts.size(); layer++)
+	{
+		size_t lowerSize = entry.layerStarts[layer + 2] - entry.layerStarts[layer + 1];
+		tree.assign(lowerSize + 1, 0);
+		size_t inserted = 0;
+		for (size_t i = entry.layerStarts[layer]; i < entry.layerStarts[layer + 1]; i++)
+		{
+			uint32_t node = entry.order[i];
+			lower.clear();
+			for (size_t j = entry.downStarts[node]; j < entry.downStarts[node + 1]; j++)
+				lower.push_back(positions[entry.down[j]]);
+			sort(lower.begin(), lower.end());
+			for (uint32_t position : lower)
+			{
+				size_t notGreater = 0;
+				for (size_t k = position + 1; k > 0; k -= k & (~k + 1))
+					notGreater += tree[k];
+				result += inserted - notGreater;
+				for (size_t k = position + 1; k <= lowerSize; k += k & (~k + 1))
+					tree[k]++;
+				inserted++;
+			}
+		}
+	}
+	return result;
+}
+
+
+static void SortLayerByBarycenter(LayeredFlowGraphLayoutCache::Entry& entry, vector<uint32_t>& positions, size_t layer,
+    const vector<uint32_t>& starts, const vector<uint32_t>& neighbors, vector<pair<double, uint32_t>>& scratch)
+{
+	scratch.clear();
+	for (size_t i = entry.layerStarts[layer]; i < entry.layerStarts[layer + 1]; i++)
+	{
+		uint32_t node = entry.order[i];
+		double barycenter = positions[node];
+		if (starts[node] != starts[node + 1])
+		{
+			double sum = 0;
+			for (size_t j = starts[node]; j < starts[node + 1]; j++)
+				sum += positions[neighbors[j]];
+			barycenter = sum / (starts[node + 1] - starts[node]);
+		}
+		scratch.emplace_back(barycenter, node);
+	}
+	stable_sort(scratch.begin(), scratch.end(),
+	    [](const pair<double, uint32_t>& a, const pair<double, uint32_t>& b) { return a.first < b.first; });
+	for (size_t i = 0; i < scratch.size(); i++)
+	{
+		entry.order[entry.layerStarts[layer] + i] = scratch[i].second;
+		positions[scratch[i].second] = (uint32_t)i;
+	}
+}
+
+
+static shared_ptr<LayeredFlowGraphLayoutCache::Entry> BuildLayering(const LayeredFlowGraphLayout::Graph& graph,
+    const LayeredFlowGraphLayoutCache::Entry* previous, LayeredFlowGraphLayout::Statistics& stats)
+{
+	auto entry = make_shared<LayeredFlowGraphLayoutCache::Entry>();
+	entry->nodeKeys = graph.nodeKeys;
+	entry->edgeStarts = graph.edgeStarts;
+	entry->edgeTargets = graph.edgeTargets;
+
+	size_t nodeCount = graph.nodeWidths.size();
+	size_t edgeCount = graph.edgeTargets.size();
+	const vector<size_t>& edgeStarts = graph.edgeStarts;
+	const vector<size_t>& edgeTargets = graph.edgeTargets;
+
+	// Back edges are the ones that reach a node still on the depth first search stack. Searching from node 0 first
+	// keeps the entry block a source.
+	entry->reversed.assign(edgeCount, false);
+	vector<uint8_t> state(nodeCount, 0);
+	vector<pair<size_t, size_t>> stack;
+	for (size_t root = 0; root < nodeCount; root++)
+	{
+		if (state[root] != 0)
+			continue;
+		state[root] = 1;
+		stack.emplace_back(root, edgeStarts[root]);
+		while (!stack.empty())
+		{
+			size_t node = stack.back().first;
+			if (stack.back().second == edgeStarts[node + 1])
+			{
+				state[node] = 2;
+				stack.pop_back();
+				continue;
+			}
+			size_t edge = stack.back().second++;
+			size_t target = edgeTargets[edge];
+			if (target == node)
+				continue;
+			if (state[target] == 1)
+			{
+				entry->reversed[edge] = true;
+			}
+			else if (state[target] == 0)
+			{
+				state[target] = 1;
+				stack.emplace_back(target, edgeStarts[target]);
+			}
+		}
+	}
+
+	// Longest path layering over the acyclic graph, in topological order
+	vector<uint32_t> inDegree(nodeCount, 0);
+	vector<uint32_t> dagStarts(nodeCount + 1, 0);
+	for (size_t node = 0; node < nodeCount; node++)
+	{
+		for (size_t edge = edgeStarts[node]; edge < edgeStarts[node + 1]; edge++)
+		{
+			size_t target = edgeTargets[edge];
+			if (target == node)
+				continue;
+			size_t from = entry->reversed[edge] ? target : node;
+			size_t to = entry->reversed[edge] ? node : target;
+			dagStarts[from + 1]++;
+			inDegree[to]++;
+		}
+	}
+	for (size_t i = 0; i < nodeCount; i++)
+		dagStarts[i + 1] += dagStarts[i];
+	vector<uint32_t> dagTargets(dagStarts[nodeCount]);
+	vector<uint32_t> next(dagStarts.begin(), dagStarts.end() - 1);
+	for (size_t node = 0; node < nodeCount; node++)
+	{
+		for (size_t edge = edgeStarts[node]; edge < edgeStarts[node + 1]; edge++)
+		{
+			size_t target = edgeTargets[edge];
+			if (target == node)
+				continue;
+			if (entry->reversed[edge])
+				dagTargets[next[target]++] = (uint32_t)node;
+			else
+				dagTargets[next[node]++] = (uint32_t)target;
+		}
+	}
+
+	vector<uint32_t> layers(nodeCount, 0);
+	vector<uint32_t> queue;
+	queue.reserve(nodeCount);
+	for (size_t node = 0; node < nodeCount; node++)
+	{
+		if (inDegree[node] == 0)
+			queue.push_back((uint32_t)node);
+	}
+	for (size_t i = 0; i < queue.size(); i++)
+	{
+		uint32_t node = queue[i];
+		for (size_t j = dagStarts[node]; j < dagStarts[node + 1]; j++)
+		{
+			uint32_t target = dagTargets[j];
+			layers[target] = max(layers[target], layers[node] + 1);
+			if (--inDegree[target] == 0)
+				queue.push_back(target);
+		}
+	}
+
+	// Split edges spanning more than one layer into chains of virtual nodes
+	vector<pair<uint32_t, uint32_t>> segments;
+	segments.reserve(edgeCount);
+	entry->chainStarts.assign(edgeCount + 1, 0);
+	for (size_t node = 0; node < nodeCount; node++)
+	{
+		for (size_t edge = edgeStarts[node]; edge < edgeStarts[node + 1]; edge++)
+		{
+			entry->chainStarts[edge] = (uint32_t)entry->chains.size();
+			size_t target = edgeTargets[edge];
+			if (target == node)
+				continue;
+			uint32_t upper = (uint32_t)(entry->reversed[edge] ? target : node);
+			uint32_t lower = (uint32_t)(entry->reversed[edge] ? node : target);
+			uint32_t previousNode = upper;
+			for (uint32_t layer = layers[upper] + 1; layer < layers[lower]; layer++)
+			{
+				uint32_t virtualNode = (uint32_t)layers.size();
+				layers.push_back(layer);
+				entry->chains.push_back(virtualNode);
+				segments.emplace_back(previousNode, virtualNode);
+				previousNode = virtualNode;
+			}
+			segments.emplace_back(previousNode, lower);
+		}
+	}
+	entry->chainStarts[edgeCount] = (uint32_t)entry->chains.size();
+
+	size_t layoutNodeCount = layers.size();
+	entry->layoutNodeCount = layoutNodeCount;
+	BuildNeighborLists(layoutNodeCount, segments, entry->upStarts, entry->up, true);
+	BuildNeighborLists(layoutNodeCount, segments, entry->downStarts, entry->down, false);
+
+	// Initial order within each layer follows a depth first search from the sources
+	vector<uint32_t> visit;
+	visit.reserve(layoutNodeCount);
+	vector<bool> visited(layoutNodeCount, false);
+	vector<uint32_t> visitStack;
+	for (size_t root = 0; root < layoutNodeCount; root++)
+	{
+		if (visited[root] || (entry->upStarts[root] != entry->upStarts[root + 1]))
+			continue;
+		visitStack.push_back((uint32_t)root);
+		while (!visitStack.empty())
+		{
+			uint32_t node = visitStack.back();
+			visitStack.pop_back();
+			if (visited[node])
+				continue;
+			visited[node] = true;
+			visit.push_back(node);
+			for (size_t j = entry->downStarts[node + 1]; j > entry->downStarts[node]; j--)
+			{
+				if (!visited[entry->down[j - 1]])
+					visitStack.push_back(entry->down[j - 1]);
+			}
+		}
+	}
+
+	uint32_t layerCount = 0;
+	for (uint32_t layer : layers)
+		layerCount = max(layerCount, layer + 1);
+	entry->layerStarts.assign(layerCount + 1, 0);
+	for (uint32_t layer : layers)
+		entry->layerStarts[layer + 1]++;
+	for (size_t i = 0; i < layerCount; i++)
+		entry->layerStarts[i + 1] += entry->layerStarts[i];
+	entry->order.resize(layoutNodeCount);
+	next.assign(entry->layerStarts.begin(), entry->layerStarts.end() - 1);
+	for (uint32_t node : visit)
+		entry->order[next[layers[node]]++] = node;
+	entry->layers = std::move(layers);
+
+	vector<uint32_t> positions(layoutNodeCount);
+	auto updatePositions = [&]() {
+		for (size_t layer = 0; layer < layerCount; layer++)
+		{
+			for (size_t i = entry->layerStarts[layer]; i < entry->layerStarts[layer + 1]; i++)
+				positions[entry->order[i]] = (uint32_t)(i - entry->layerStarts[layer]);
+		}
+	};
+	updatePositions();
+	size_t bestCrossings = CountCrossings(*entry, positions);
+
+	// Try keeping nodes that survived an edit in the order they had before it, which avoids the graph jumping around
+	// when the search order changes. The search order is kept when it is already better.
+	if (previous && !previous->centers.empty())
+	{
+		vector<uint32_t> searchOrder = entry->order;
+		// Virtual nodes are matched by the blocks their edge joins and their place along it
+		auto virtualNodeKey = [](uint64_t upper, uint64_t lower, size_t index) {
+			uint64_t key = upper * 0x9e3779b97f4a7c15ULL;
+			key ^= lower + 0x7f4a7c159e3779b9ULL + (key << 6) + (key >> 2);
+			key ^= index + 0x9e3779b97f4a7c15ULL + (key << 6) + (key >> 2);
+			return key;
+		};
+
+		unordered_map<uint64_t, double> previousCenters, previousVirtualCenters;
+		previousCenters.reserve(previous->nodeKeys.size());
+		for (size_t i = 0; i < previous->nodeKeys.size(); i++)
+			previousCenters[previous->nodeKeys[i]] = previous->centers[i];
+		previousVirtualCenters.reserve(previous->chains.size());
+		for (size_t node = 0; node + 1 < previous->edgeStarts.size(); node++)
+		{
+			for (size_t edge = previous->edgeStarts[node]; edge < previous->edgeStarts[node + 1]; edge++)
+			{
+				uint64_t upper = previous->nodeKeys[previous->reversed[edge] ? previous->edgeTargets[edge] : node];
+				uint64_t lower = previous->nodeKeys[previous->reversed[edge] ? node : previous->edgeTargets[edge]];
+				for (size_t j = previous->chainStarts[edge]; j < previous->chainStarts[edge + 1]; j++)
+				{
+					previousVirtualCenters[virtualNodeKey(upper, lower, j - previous->chainStarts[edge])] =
+						previous->centers[previous->chains[j]];
+				}
+			}
+		}
+
+		vector<double> seeds(layoutNodeCount, NAN);
+		for (size_t node = 0; node < nodeCount; node++)
+		{
+			auto i = previousCenters.find(graph.nodeKeys[node]);
+			if (i != previousCenters.end())
+				seeds[node] = i->second;
+		}
+		for (size_t node = 0; node < nodeCount; node++)
+		{
+			for (size_t edge = edgeStarts[node]; edge < edgeStarts[node + 1]; edge++)
+			{
+				uint64_t upper = graph.nodeKeys[entry->reversed[edge] ? edgeTargets[edge] : node];
+				uint64_t lower = graph.nodeKeys[entry->reversed[edge] ? node : edgeTargets[edge]];
+				for (size_t j = entry->chainStarts[edge]; j < entry->chainStarts[edge + 1]; j++)
+				{
+					auto i = previousVirtualCenters.find(virtualNodeKey(upper, lower, j - entry->chainStarts[edge]));
+					if (i != previousVirtualCenters.end())
+						seeds[entry->chains[j]] = i->second;
+				}
+			}
+		}
+
+		vector<pair<double, uint32_t>> seeded;
+		for (size_t layer = 0; layer < layerCount; layer++)
+		{
+			// Nodes without a previous position stay next to the node they followed in the initial order
+			seeded.clear();
+			double last = NAN;
+			for (size_t i = entry->layerStarts[layer]; i < entry->layerStarts[layer + 1]; i++)
+			{
+				uint32_t node = entry->order[i];
+				if (!isnan(seeds[node]))
+					last = seeds[node];
+				seeded.emplace_back(last, node);
+			}
+			double first = 0;
+			for (auto& [seed, node] : seeded)
+			{
+				if (!isnan(seed))
+				{
+					first = seed;
+					break;
+				}
+			}
+			for (auto& [seed, node] : seeded)
+			{
+				if (isnan(seed))
+					seed = first;
+				seeds[node] = seed;
+			}
+			stable_sort(seeded.begin(), seeded.end(),
+			    [](const pair<double, uint32_t>& a, const pair<double, uint32_t>& b) { return a.first < b.first; });
+			for (size_t i = 0; i < seeded.size(); i++)
+				entry->order[entry->layerStarts[layer] + i] = seeded[i].second;
+		}
+
+		updatePositions();
+		size_t seededCrossings = CountCrossings(*entry, positions);
+		if (seededCrossings <= bestCrossings)
+		{
+			bestCrossings = seededCrossings;
+			stats.seededOrdering = true;
+
+			// The previous ordering had already converged, so when the edit added no crossings there is nothing
+			// left for the sweeps to do and the previous centers are a good start for coordinate assignment
+			if (seededCrossings <= previous->crossings)
+			{
+				entry->crossings = seededCrossings;
+				entry->centers = std::move(seeds);
+				return entry;
+			}
+		}
+		else
+		{
+			entry->order = std::move(searchOrder);
+			updatePositions();
+		}
+	}
+
+	// Barycenter sweeps, keeping the best order seen and stopping once sweeps stop helping
+	vector<uint32_t> bestOrder = entry->order;
+	vector<pair<double, uint32_t>> scratch;
+	// A seeded order starts close to converged, so give up sooner when a sweep does not help
+	size_t sweepLimit = stats.seededOrdering ? 1 : SweepsWithoutImprovement;
+	size_t sweepsWithoutImprovement = 0;
+	for (size_t sweep = 0; sweep < MaxCrossingSweeps && bestCrossings != 0; sweep++)
+	{
+		for (size_t layer = 1; layer < layerCount; layer++)
+			SortLayerByBarycenter(*entry, positions, layer, entry->upStarts, entry->up, scratch);
+		for (size_t layer = layerCount - 1; layer > 0; layer--)
+			SortLayerByBarycenter(*entry, positions, layer - 1, entry->downStarts, entry->down, scratch);
+		stats.sweeps++;
+
+		size_t crossings = CountCrossings(*entry, positions);
+		if (crossings < bestCrossings)
+		{
+			bestCrossings = crossings;
+			bestOrder = entry->order;
+			sweepsWithoutImprovement = 0;
+		}
+		else if (++sweepsWithoutImprovement >= sweepLimit)
+		{
+			break;
+		}
+	}
+	entry->order = std::move(bestOrder);
+	entry->crossings = bestCrossings;
+	return entry;
+}
+
+
+static vector<double> AssignCoordinates(const LayeredFlowGraphLayoutCache::Entry& entry,
+    LayeredFlowGraphLayout::Graph& graph, const vector<double>* initialCenters)
+{
+	size_t nodeCount = graph.nodeWidths.size();
+	size_t layerCount = entry.layerStarts.size() - 1;
+	double horizontalMargin = graph.horizontalMargin;
+	double verticalMargin = graph.verticalMargin;
+	auto width = [&](uint32_t node) { return node < nodeCount ? (double)graph.nodeWidths[node] : 0.0; };
+
+	vector<int> layerY(layerCount);
+	vector<int> layerHeights(layerCount, 0);
+	for (size_t node = 0; node < nodeCount; node++)
+	{
+		int& height = layerHeights[entry.layers[node]];
+		height = max(height, graph.nodeHeights[node]);
+	}
+	int y = graph.verticalMargin;
+	for (size_t layer = 0; layer < layerCount; layer++)
+	{
+		layerY[layer] = y;
+		y += layerHeights[layer] + graph.verticalMargin;
+	}
+
+	// Edges may pass closer to each other than blocks
+	auto separation = [&](uint32_t left, uint32_t right) {
+		double margin = (left < nodeCount && right < nodeCount) ? horizontalMargin : horizontalMargin / 2;
+		return (width(left) + width(right)) / 2 + margin;
+	};
+
+	// Starting from the centers of a previous layout of the same graph converges in fewer passes
+	vector<double> centers(entry.layoutNodeCount);
+	size_t passes = CoordinatePasses;
+	if (initialCenters && initialCenters->size() == entry.layoutNodeCount)
+	{
+		centers = *initialCenters;
+		passes = CachedCoordinatePasses;
+	}
+	else
+	{
+		for (size_t layer = 0; layer < layerCount; layer++)
+		{
+			double x = 0;
+			for (size_t i = entry.layerStarts[layer]; i < entry.layerStarts[layer + 1]; i++)
+			{
+				uint32_t node = entry.order[i];
+				double nodeWidth = width(node);
+				centers[node] = x + nodeWidth / 2;
+				x += nodeWidth + horizontalMargin;
+			}
+		}
+	}
+
+	// Move each node toward the average of its neighbors in the previous layer of the pass. Averaging the
+	// placements packed from the left and from the right keeps the minimum separation and the layer order.
+	vector<double> desired, left, right;
+	for (size_t pass = 0; pass < passes; pass++)
+	{
+		bool downward = (pass % 2) == 0;
+		const vector<uint32_t>& starts = downward ? entry.upStarts : entry.downStarts;
+		const vector<uint32_t>& neighbors = downward ? entry.up : entry.down;
+		for (size_t step = 0; step < layerCount; step++)
+		{
+			size_t layer = downward ? step : layerCount - 1 - step;
+			size_t begin = entry.layerStarts[layer];
+			size_t count = entry.layerStarts[layer + 1] - begin;
+			if (count == 0)
+				continue;
+			desired.resize(count);
+			left.resize(count);
+			right.resize(count);
+			for (size_t i = 0; i < count; i++)
+			{
+				uint32_t node = entry.order[begin + i];
+				desired[i] = centers[node];
+				if (starts[node] != starts[node + 1])
+				{
+					double sum = 0;
+					for (size_t j = starts[node]; j < starts[node + 1]; j++)
+						sum += centers[neighbors[j]];
+					desired[i] = sum / (starts[node + 1] - starts[node]);
+				}
+			}
+			left[0] = desired[0];
+			for (size_t i = 1; i < count; i++)
+				left[i] = max(desired[i], left[i - 1] + separation(entry.order[begin + i - 1], entry.order[begin + i]));
+			right[count - 1] = desired[count - 1];
+			for (size_t i = count - 1; i > 0; i--)
+				right[i - 1] = min(desired[i - 1], right[i] - separation(entry.order[begin + i - 1], entry.order[begin + i]));
+			for (size_t i = 0; i < count; i++)
+				centers[entry.order[begin + i]] = (left[i] + right[i]) / 2;
+		}
+	}
+
+	double minLeft = 0;
+	double maxRight = 0;
+	for (size_t node = 0; node < entry.layoutNodeCount; node++)
+	{
+		double nodeWidth = width((uint32_t)node);
+		if (node == 0 || centers[node] - nodeWidth / 2 < minLeft)
+			minLeft = centers[node] - nodeWidth / 2;
+		if (node == 0 || centers[node] + nodeWidth / 2 > maxRight)
+			maxRight = centers[node] + nodeWidth / 2;
+	}
+	double shift = horizontalMargin - minLeft;
+	for (double& center : centers)
+		center += shift;
+
+	graph.nodeX.resize(nodeCount);
+	graph.nodeY.resize(nodeCount);
+	for (size_t node = 0; node < nodeCount; node++)
+	{
+		graph.nodeX[node] = (int)lround(centers[node] - width((uint32_t)node) / 2);
+		graph.nodeY[node] = layerY[entry.layers[node]];
+	}
+	graph.width = (int)lround(maxRight + shift + horizontalMargin);
+	graph.height = y;
+
+	// Edges leave from the bottom of the source, travel between layers and along their virtual nodes, and enter the
+	// top of the target. Back edges climb along the right of the source and reach the target from its left.
+	auto below = [&](uint32_t layer) { return (float)(layerY[layer] + layerHeights[layer] + verticalMargin / 2); };
+	auto above = [&](uint32_t layer) { return (float)(layerY[layer] - verticalMargin / 2); };
+	graph.edgePoints.resize(graph.edgeTargets.size());
+	for (size_t node = 0; node < nodeCount; node++)
+	{
+		size_t outgoing = graph.edgeStarts[node + 1] - graph.edgeStarts[node];
+		for (size_t edge = graph.edgeStarts[node]; edge < graph.edgeStarts[node + 1]; edge++)
+		{
+			size_t target = graph.edgeTargets[edge];
+			uint32_t sourceLayer = entry.layers[node];
+			uint32_t targetLayer = entry.layers[target];
+			float exitX = (float)(graph.nodeX[node] +
+				(double)graph.nodeWidths[node] * (edge - graph.edgeStarts[node] + 1) / (outgoing + 1));
+			float exitY = (float)(graph.nodeY[node] + graph.nodeHeights[node]);
+			float entryX = (float)(graph.nodeX[target] + graph.nodeWidths[target] / 2.0);
+			float entryY = (float)graph.nodeY[target];
+			float sourceRight = (float)(graph.nodeX[node] + graph.nodeWidths[node] + horizontalMargin / 2);
+			float targetLeft = (float)(graph.nodeX[target] - horizontalMargin / 2);
+
+			vector<BNPoint>& points = graph.edgePoints[edge];
+			points.clear();
+			points.push_back({exitX, exitY});
+			points.push_back({exitX, below(sourceLayer)});
+			if (target == node)
+			{
+				points.push_back({sourceRight, below(sourceLayer)});
+				points.push_back({sourceRight, above(sourceLayer)});
+			}
+			else if (!entry.reversed[edge])
+			{
+				for (size_t j = entry.chainStarts[edge]; j < entry.chainStarts[edge + 1]; j++)
+				{
+					uint32_t virtualNode = entry.chains[j];
+					points.push_back({(float)centers[virtualNode], above(entry.layers[virtualNode])});
+					points.push_back({(float)centers[virtualNode], below(entry.layers[virtualNode])});
+				}
+			}
+			else
+			{
+				points.push_back({sourceRight, below(sourceLayer)});
+				points.push_back({sourceRight, above(sourceLayer)});
+				for (size_t j = entry.chainStarts[edge + 1]; j > entry.chainStarts[edge]; j--)
+				{
+					uint32_t virtualNode = entry.chains[j - 1];
+					points.push_back({(float)centers[virtualNode], below(entry.layers[virtualNode])});
+					points.push_back({(float)centers[virtualNode], above(entry.layers[virtualNode])});
+				}
+				points.push_back({targetLeft, below(targetLayer)});
+				points.push_back({targetLeft, above(targetLayer)});
+			}
+			points.push_back({entryX, above(targetLayer)});
+			points.push_back({entryX, entryY});
+		}
+	}
+
+	return centers;
+}
+
+
+LayeredFlowGraphLayout::LayeredFlowGraphLayout(const string& name) :
+    FlowGraphLayout(name), m_cache(make_shared<LayeredFlowGraphLayoutCache>())
+{
+}
+
+
+template <typename T>
+static bool IsSameIL(const Ref<T>& il, const Ref<T>& other)
+{
+	return il && other && il->GetObject() == other->GetObject();
+}
+
+
+// Graphs whose IL cannot be matched against the function's IL, such as language representations, share the key of
+// the IL level they report. Cached entries are only reused when their nodes and edges match, so this can only cost
+// cache hits.
+static BNFunctionGraphType GetGraphType(FlowGraph* graph, Function* func)
+{
+	if (graph->IsLowLevelILGraph())
+	{
+		Ref<LowLevelILFunction> il = graph->GetLowLevelILFunction();
+		if (IsSameIL(il, func->GetLiftedILIfAvailable()))
+			return LiftedILFunctionGraph;
+		Ref<LowLevelILFunction> llil = func->GetLowLevelILIfAvailable();
+		if (llil && IsSameIL(il, llil->GetSSAForm()))
+			return LowLevelILSSAFormFunctionGraph;
+		return LowLevelILFunctionGraph;
+	}
+	if (graph->IsMediumLevelILGraph())
+	{
+		Ref<MediumLevelILFunction> il = graph->GetMediumLevelILFunction();
+		Ref<MediumLevelILFunction> mapped = func->GetMappedMediumLevelILIfAvailable();
+		if (IsSameIL(il, mapped))
+			return MappedMediumLevelILFunctionGraph;
+		if (mapped && IsSameIL(il, mapped->GetSSAForm()))
+			return MappedMediumLevelILSSAFormFunctionGraph;
+		Ref<MediumLevelILFunction> mlil = func->GetMediumLevelILIfAvailable();
+		if (mlil && IsSameIL(il, mlil->GetSSAForm()))
+			return MediumLevelILSSAFormFunctionGraph;
+		return MediumLevelILFunctionGraph;
+	}
+	if (graph->IsHighLevelILGraph())
+	{
+		Ref<HighLevelILFunction> il = graph->GetHighLevelILFunction();
+		Ref<HighLevelILFunction> hlil = func->GetHighLevelILIfAvailable();
+		if (hlil && IsSameIL(il, hlil->GetSSAForm()))
+			return HighLevelILSSAFormFunctionGraph;
+		return HighLevelILFunctionGraph;
+	}
+	return NormalFunctionGraph;
+}
+
+
+bool LayeredFlowGraphLayout::Layout(Ref<FlowGraph> graph, std::vector<Ref<FlowGraphNode>>& nodes)
+{
+	Graph layout;
+	layout.horizontalMargin = graph->GetHorizontalNodeMargin();
+	layout.verticalMargin = graph->GetVerticalNodeMargin();
+	layout.nodeWidths.reserve(nodes.size());
+	layout.nodeHeights.reserve(nodes.size());
+	layout.nodeKeys.reserve(nodes.size());
+	layout.edgeStarts.reserve(nodes.size() + 1);
+
+	unordered_map<BNFlowGraphNode*, size_t> indices;
+	indices.reserve(nodes.size());
+	for (size_t i = 0; i < nodes.size(); i++)
+		indices[nodes[i]->GetObject()] = i;
+
+	// Edges to nodes outside of the list are not laid out, so remember which outgoing edge each one is
+	vector<size_t> edgeNumbers;
+	for (size_t i = 0; i < nodes.size(); i++)
+	{
+		layout.nodeWidths.push_back(nodes[i]->GetWidth());
+		layout.nodeHeights.push_back(nodes[i]->GetHeight());
+		Ref<BasicBlock> block = nodes[i]->GetBasicBlock();
+		layout.nodeKeys.push_back(block ? block->GetStart() : ((1ULL << 63) | i));
+
+		layout.edgeStarts.push_back(layout.edgeTargets.size());
+		const vector<FlowGraphEdge>& edges = nodes[i]->GetOutgoingEdges();
+		for (size_t j = 0; j < edges.size(); j++)
+		{
+			if (!edges[j].target)
+				continue;
+			auto target = indices.find(edges[j].target->GetObject());
+			if (target == indices.end())
+				continue;
+			layout.edgeTargets.push_back(target->second);
+			edgeNumbers.push_back(j);
+		}
+	}
+	layout.edgeStarts.push_back(layout.edgeTargets.size());
+
+	optional<CacheKey> cacheKey;
+	if (Ref<Function> func = graph->GetFunction())
+	{
+		CacheKey key;
+		key.view = (uint64_t)(uintptr_t)func->GetView()->GetObject();
+		key.function = func->GetStart();
+		key.graphType = GetGraphType(graph, func);
+		cacheKey = key;
+	}
+
+	LayoutGraph(layout, cacheKey);
+
+	for (size_t i = 0; i < nodes.size(); i++)
+	{
+		nodes[i]->SetX(layout.nodeX[i]);
+		nodes[i]->SetY(layout.nodeY[i]);
+		for (size_t edge = layout.edgeStarts[i]; edge < layout.edgeStarts[i + 1]; edge++)
+			nodes[i]->SetOutgoingEdgePoints(edgeNumbers[edge], layout.edgePoints[edge]);
+	}
+	graph->SetWidth(layout.width);
+	graph->SetHeight(layout.height);
+	return true;
+}
+
+
+LayeredFlowGraphLayout::Statistics LayeredFlowGraphLayout::LayoutGraph(Graph& graph, optional<CacheKey> cacheKey)
+{
+	Statistics stats;
+	if (graph.nodeWidths.empty())
+	{
+		graph.nodeX.clear();
+		graph.nodeY.clear();
+		graph.edgePoints.clear();
+		graph.width = 0;
+		graph.height = 0;
+		return stats;
+	}
+
+	shared_ptr<const LayeredFlowGraphLayoutCache::Entry> previous;
+	if (cacheKey)
+	{
+		unique_lock<mutex> lock(m_cache->cacheMutex);
+		for (auto i = m_cache->entries.begin(); i != m_cache->entries.end(); ++i)
+		{
+			if (i->first == *cacheKey)
+			{
+				previous = i->second;
+				m_cache->entries.splice(m_cache->entries.begin(), m_cache->entries, i);
+				break;
+			}
+		}
+	}
+
+	if (previous && previous->nodeKeys == graph.nodeKeys && previous->edgeStarts == graph.edgeStarts
+	    && previous->edgeTargets == graph.edgeTargets)
+	{
+		stats.reusedLayering = true;
+		AssignCoordinates(*previous, graph, &previous->centers);
+	}
+	else
+	{
+		shared_ptr<LayeredFlowGraphLayoutCache::Entry> entry = BuildLayering(graph, previous.get(), stats);
+		entry->centers = AssignCoordinates(*entry, graph, entry->centers.empty() ? nullptr : &entry->centers);
+		previous = entry;
+		if (cacheKey)
+		{
+			unique_lock<mutex> lock(m_cache->cacheMutex);
+			auto& entries = m_cache->entries;
+			if (!entries.empty() && entries.front().first == *cacheKey)
+				entries.front().second = entry;
+			else
+				entries.emplace_front(*cacheKey, entry);
+			if (entries.size() > MaxCachedLayouts)
+				entries.pop_back();
+		}
+	}
+
+	stats.layers = previous->layerStarts.size() - 1;
+	stats.virtualNodes = previous->layoutNodeCount - graph.nodeWidths.size();
+	stats.crossings = previous->crossings;
+	return stats;
+}
+
+
+void LayeredFlowGraphLayout::ClearCache()
+{
+	unique_lock<mutex> lock(m_cache->cacheMutex);
+	m_cache->entries.clear();
+}
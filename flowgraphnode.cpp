@@ -221,6 +221,14 @@ void FlowGraphNode::AddOutgoingEdge(BNBranchType type, FlowGraphNode* target, BN
 }
 
 
+void FlowGraphNode::SetOutgoingEdgePoints(size_t edgeNum, const vector<BNPoint>& points)
+{
+	BNFlowGraphNodeSetOutgoingEdgePoints(m_object, edgeNum, (BNPoint*)points.data(), points.size());
+	m_cachedEdges.clear();
+	m_cachedEdgesValid = false;
+}
+
+
 BNHighlightColor FlowGraphNode::GetHighlight() const
 {
 	return BNGetFlowGraphNodeHighlight(m_object);
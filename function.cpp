@@ -317,6 +317,14 @@ vector<Ref<BasicBlock>> Function::GetBasicBlocks() const
 }
 
 
+BasicBlockArray Function::GetBasicBlockArray() const
+{
+	size_t count;
+	BNBasicBlock** blocks = BNGetFunctionBasicBlockList(m_object, &count);
+	return BasicBlockArray(blocks, count);
+}
+
+
 Ref<BasicBlock> Function::GetBasicBlockAtAddress(Architecture* arch, uint64_t addr) const
 {
 	BNBasicBlock* block = BNGetFunctionBasicBlockAtAddress(m_object, arch->GetObject(), addr);
@@ -37,202 +37,339 @@ using namespace std;
 #endif
 
 
-unordered_map<HighLevelILOperandUsage, HighLevelILOperandType> HighLevelILInstructionBase::operandTypeForUsage = {
-    {SourceExprHighLevelOperandUsage, ExprHighLevelOperand},
-    {VariableHighLevelOperandUsage, VariableHighLevelOperand},
-    {DestVariableHighLevelOperandUsage, VariableHighLevelOperand},
-    {SSAVariableHighLevelOperandUsage, SSAVariableHighLevelOperand},
-    {DestSSAVariableHighLevelOperandUsage, SSAVariableHighLevelOperand},
-    {DestExprHighLevelOperandUsage, ExprHighLevelOperand},
-    {LeftExprHighLevelOperandUsage, ExprHighLevelOperand},
-    {RightExprHighLevelOperandUsage, ExprHighLevelOperand},
-    {CarryExprHighLevelOperandUsage, ExprHighLevelOperand},
-    {IndexExprHighLevelOperandUsage, ExprHighLevelOperand},
-    {ConditionExprHighLevelOperandUsage, ExprHighLevelOperand},
-    {ConditionPhiExprHighLevelOperandUsage, ExprHighLevelOperand},
-    {TrueExprHighLevelOperandUsage, ExprHighLevelOperand},
-    {FalseExprHighLevelOperandUsage, ExprHighLevelOperand},
-    {LoopExprHighLevelOperandUsage, ExprHighLevelOperand},
-    {InitExprHighLevelOperandUsage, ExprHighLevelOperand},
-    {UpdateExprHighLevelOperandUsage, ExprHighLevelOperand},
-    {DefaultExprHighLevelOperandUsage, ExprHighLevelOperand},
-    {HighExprHighLevelOperandUsage, ExprHighLevelOperand},
-    {LowExprHighLevelOperandUsage, ExprHighLevelOperand},
-    {OffsetHighLevelOperandUsage, IntegerHighLevelOperand},
-    {MemberIndexHighLevelOperandUsage, IndexHighLevelOperand},
-    {ConstantHighLevelOperandUsage, IntegerHighLevelOperand},
-    {ConstantDataHighLevelOperandUsage, ConstantDataHighLevelOperand},
-    {VectorHighLevelOperandUsage, IntegerHighLevelOperand},
-    {IntrinsicHighLevelOperandUsage, IntrinsicHighLevelOperand},
-    {TargetHighLevelOperandUsage, IndexHighLevelOperand},
-    {ParameterExprsHighLevelOperandUsage, ExprListHighLevelOperand},
-    {SourceExprsHighLevelOperandUsage, ExprListHighLevelOperand},
-    {DestExprsHighLevelOperandUsage, ExprListHighLevelOperand},
-    {BlockExprsHighLevelOperandUsage, ExprListHighLevelOperand},
-    {CasesHighLevelOperandUsage, ExprListHighLevelOperand},
-    {ValueExprsHighLevelOperandUsage, ExprListHighLevelOperand},
-    {SourceSSAVariablesHighLevelOperandUsage, SSAVariableListHighLevelOperand},
-    {SourceMemoryVersionHighLevelOperandUsage, IndexHighLevelOperand},
-    {SourceMemoryVersionsHighLevelOperandUsage, IndexListHighLevelOperand},
-    {DestMemoryVersionHighLevelOperandUsage, IndexHighLevelOperand}};
-
-
-unordered_map<BNHighLevelILOperation, vector<HighLevelILOperandUsage>>
-    HighLevelILInstructionBase::operationOperandUsage = {{HLIL_NOP, {}}, {HLIL_BREAK, {}}, {HLIL_CONTINUE, {}},
-        {HLIL_NORET, {}}, {HLIL_BP, {}}, {HLIL_UNDEF, {}}, {HLIL_UNIMPL, {}}, {HLIL_UNREACHABLE, {}},
-        {HLIL_BLOCK, {BlockExprsHighLevelOperandUsage}},
-        {HLIL_IF, {ConditionExprHighLevelOperandUsage, TrueExprHighLevelOperandUsage, FalseExprHighLevelOperandUsage}},
-        {HLIL_WHILE, {ConditionExprHighLevelOperandUsage, LoopExprHighLevelOperandUsage}},
-        {HLIL_WHILE_SSA,
-            {ConditionPhiExprHighLevelOperandUsage, ConditionExprHighLevelOperandUsage, LoopExprHighLevelOperandUsage}},
-        {HLIL_DO_WHILE, {LoopExprHighLevelOperandUsage, ConditionExprHighLevelOperandUsage}},
-        {HLIL_DO_WHILE_SSA,
-            {LoopExprHighLevelOperandUsage, ConditionPhiExprHighLevelOperandUsage, ConditionExprHighLevelOperandUsage}},
-        {HLIL_FOR, {InitExprHighLevelOperandUsage, ConditionExprHighLevelOperandUsage, UpdateExprHighLevelOperandUsage,
-                       LoopExprHighLevelOperandUsage}},
-        {HLIL_FOR_SSA,
-            {InitExprHighLevelOperandUsage, ConditionPhiExprHighLevelOperandUsage, ConditionExprHighLevelOperandUsage,
-                UpdateExprHighLevelOperandUsage, LoopExprHighLevelOperandUsage}},
-        {HLIL_SWITCH,
-            {ConditionExprHighLevelOperandUsage, DefaultExprHighLevelOperandUsage, CasesHighLevelOperandUsage}},
-        {HLIL_CASE, {ValueExprsHighLevelOperandUsage, TrueExprHighLevelOperandUsage}},
-        {HLIL_JUMP, {DestExprHighLevelOperandUsage}}, {HLIL_RET, {SourceExprsHighLevelOperandUsage}},
-        {HLIL_GOTO, {TargetHighLevelOperandUsage}}, {HLIL_LABEL, {TargetHighLevelOperandUsage}},
-        {HLIL_VAR_DECLARE, {VariableHighLevelOperandUsage}},
-        {HLIL_VAR_INIT, {DestVariableHighLevelOperandUsage, SourceExprHighLevelOperandUsage}},
-        {HLIL_VAR_INIT_SSA, {DestSSAVariableHighLevelOperandUsage, SourceExprHighLevelOperandUsage}},
-        {HLIL_ASSIGN, {DestExprHighLevelOperandUsage, SourceExprHighLevelOperandUsage}},
-        {HLIL_ASSIGN_UNPACK, {DestExprsHighLevelOperandUsage, SourceExprHighLevelOperandUsage}},
-        {HLIL_ASSIGN_MEM_SSA, {DestExprHighLevelOperandUsage, DestMemoryVersionHighLevelOperandUsage,
-                                  SourceExprHighLevelOperandUsage, SourceMemoryVersionHighLevelOperandUsage}},
-        {HLIL_ASSIGN_UNPACK_MEM_SSA, {DestExprsHighLevelOperandUsage, DestMemoryVersionHighLevelOperandUsage,
-                                 SourceExprHighLevelOperandUsage, SourceMemoryVersionHighLevelOperandUsage}},
-        {HLIL_VAR, {VariableHighLevelOperandUsage}}, {HLIL_VAR_SSA, {SSAVariableHighLevelOperandUsage}},
-        {HLIL_VAR_PHI, {DestSSAVariableHighLevelOperandUsage, SourceSSAVariablesHighLevelOperandUsage}},
-        {HLIL_MEM_PHI, {DestMemoryVersionHighLevelOperandUsage, SourceMemoryVersionsHighLevelOperandUsage}},
-        {HLIL_STRUCT_FIELD,
-            {SourceExprHighLevelOperandUsage, OffsetHighLevelOperandUsage, MemberIndexHighLevelOperandUsage}},
-        {HLIL_ARRAY_INDEX, {SourceExprHighLevelOperandUsage, IndexExprHighLevelOperandUsage}},
-        {HLIL_ARRAY_INDEX_SSA, {SourceExprHighLevelOperandUsage, SourceMemoryVersionHighLevelOperandUsage,
-                                   IndexExprHighLevelOperandUsage}},
-        {HLIL_SPLIT, {HighExprHighLevelOperandUsage, LowExprHighLevelOperandUsage}},
-        {HLIL_DEREF, {SourceExprHighLevelOperandUsage}},
-        {HLIL_DEREF_FIELD,
-            {SourceExprHighLevelOperandUsage, OffsetHighLevelOperandUsage, MemberIndexHighLevelOperandUsage}},
-        {HLIL_DEREF_SSA, {SourceExprHighLevelOperandUsage, SourceMemoryVersionHighLevelOperandUsage}},
-        {HLIL_DEREF_FIELD_SSA, {SourceExprHighLevelOperandUsage, SourceMemoryVersionHighLevelOperandUsage,
-                                   OffsetHighLevelOperandUsage, MemberIndexHighLevelOperandUsage}},
-        {HLIL_ADDRESS_OF, {SourceExprHighLevelOperandUsage}},
-        {HLIL_CALL, {DestExprHighLevelOperandUsage, ParameterExprsHighLevelOperandUsage}},
-        {HLIL_SYSCALL, {ParameterExprsHighLevelOperandUsage}},
-        {HLIL_TAILCALL, {DestExprHighLevelOperandUsage, ParameterExprsHighLevelOperandUsage}},
-        {HLIL_INTRINSIC, {IntrinsicHighLevelOperandUsage, ParameterExprsHighLevelOperandUsage}},
-        {HLIL_CALL_SSA, {DestExprHighLevelOperandUsage, ParameterExprsHighLevelOperandUsage,
-                            DestMemoryVersionHighLevelOperandUsage, SourceMemoryVersionHighLevelOperandUsage}},
-        {HLIL_SYSCALL_SSA, {ParameterExprsHighLevelOperandUsage, DestMemoryVersionHighLevelOperandUsage,
-                               SourceMemoryVersionHighLevelOperandUsage}},
-        {HLIL_INTRINSIC_SSA, {IntrinsicHighLevelOperandUsage, ParameterExprsHighLevelOperandUsage,
-                                 DestMemoryVersionHighLevelOperandUsage, SourceMemoryVersionHighLevelOperandUsage}},
-        {HLIL_TRAP, {VectorHighLevelOperandUsage}},
-        {HLIL_CONST, {ConstantHighLevelOperandUsage}},
-        {HLIL_CONST_PTR, {ConstantHighLevelOperandUsage}},
-        {HLIL_EXTERN_PTR, {ConstantHighLevelOperandUsage, OffsetHighLevelOperandUsage}},
-        {HLIL_FLOAT_CONST, {ConstantHighLevelOperandUsage}}, {HLIL_IMPORT, {ConstantHighLevelOperandUsage}},
-        {HLIL_CONST_DATA, {ConstantDataHighLevelOperandUsage}},
-        {HLIL_ADD, {LeftExprHighLevelOperandUsage, RightExprHighLevelOperandUsage}},
-        {HLIL_SUB, {LeftExprHighLevelOperandUsage, RightExprHighLevelOperandUsage}},
-        {HLIL_AND, {LeftExprHighLevelOperandUsage, RightExprHighLevelOperandUsage}},
-        {HLIL_OR, {LeftExprHighLevelOperandUsage, RightExprHighLevelOperandUsage}},
-        {HLIL_XOR, {LeftExprHighLevelOperandUsage, RightExprHighLevelOperandUsage}},
-        {HLIL_LSL, {LeftExprHighLevelOperandUsage, RightExprHighLevelOperandUsage}},
-        {HLIL_LSR, {LeftExprHighLevelOperandUsage, RightExprHighLevelOperandUsage}},
-        {HLIL_ASR, {LeftExprHighLevelOperandUsage, RightExprHighLevelOperandUsage}},
-        {HLIL_ROL, {LeftExprHighLevelOperandUsage, RightExprHighLevelOperandUsage}},
-        {HLIL_ROR, {LeftExprHighLevelOperandUsage, RightExprHighLevelOperandUsage}},
-        {HLIL_MUL, {LeftExprHighLevelOperandUsage, RightExprHighLevelOperandUsage}},
-        {HLIL_MULU_DP, {LeftExprHighLevelOperandUsage, RightExprHighLevelOperandUsage}},
-        {HLIL_MULS_DP, {LeftExprHighLevelOperandUsage, RightExprHighLevelOperandUsage}},
-        {HLIL_DIVU, {LeftExprHighLevelOperandUsage, RightExprHighLevelOperandUsage}},
-        {HLIL_DIVS, {LeftExprHighLevelOperandUsage, RightExprHighLevelOperandUsage}},
-        {HLIL_MODU, {LeftExprHighLevelOperandUsage, RightExprHighLevelOperandUsage}},
-        {HLIL_MODS, {LeftExprHighLevelOperandUsage, RightExprHighLevelOperandUsage}},
-        {HLIL_CMP_E, {LeftExprHighLevelOperandUsage, RightExprHighLevelOperandUsage}},
-        {HLIL_CMP_NE, {LeftExprHighLevelOperandUsage, RightExprHighLevelOperandUsage}},
-        {HLIL_CMP_SLT, {LeftExprHighLevelOperandUsage, RightExprHighLevelOperandUsage}},
-        {HLIL_CMP_ULT, {LeftExprHighLevelOperandUsage, RightExprHighLevelOperandUsage}},
-        {HLIL_CMP_SLE, {LeftExprHighLevelOperandUsage, RightExprHighLevelOperandUsage}},
-        {HLIL_CMP_ULE, {LeftExprHighLevelOperandUsage, RightExprHighLevelOperandUsage}},
-        {HLIL_CMP_SGE, {LeftExprHighLevelOperandUsage, RightExprHighLevelOperandUsage}},
-        {HLIL_CMP_UGE, {LeftExprHighLevelOperandUsage, RightExprHighLevelOperandUsage}},
-        {HLIL_CMP_SGT, {LeftExprHighLevelOperandUsage, RightExprHighLevelOperandUsage}},
-        {HLIL_CMP_UGT, {LeftExprHighLevelOperandUsage, RightExprHighLevelOperandUsage}},
-        {HLIL_TEST_BIT, {LeftExprHighLevelOperandUsage, RightExprHighLevelOperandUsage}},
-        {HLIL_ADD_OVERFLOW, {LeftExprHighLevelOperandUsage, RightExprHighLevelOperandUsage}},
-        {HLIL_ADC, {LeftExprHighLevelOperandUsage, RightExprHighLevelOperandUsage, CarryExprHighLevelOperandUsage}},
-        {HLIL_SBB, {LeftExprHighLevelOperandUsage, RightExprHighLevelOperandUsage, CarryExprHighLevelOperandUsage}},
-        {HLIL_RLC, {LeftExprHighLevelOperandUsage, RightExprHighLevelOperandUsage, CarryExprHighLevelOperandUsage}},
-        {HLIL_RRC, {LeftExprHighLevelOperandUsage, RightExprHighLevelOperandUsage, CarryExprHighLevelOperandUsage}},
-        {HLIL_DIVU_DP, {LeftExprHighLevelOperandUsage, RightExprHighLevelOperandUsage}},
-        {HLIL_DIVS_DP, {LeftExprHighLevelOperandUsage, RightExprHighLevelOperandUsage}},
-        {HLIL_MODU_DP, {LeftExprHighLevelOperandUsage, RightExprHighLevelOperandUsage}},
-        {HLIL_MODS_DP, {LeftExprHighLevelOperandUsage, RightExprHighLevelOperandUsage}},
-        {HLIL_NEG, {SourceExprHighLevelOperandUsage}}, {HLIL_NOT, {SourceExprHighLevelOperandUsage}},
-        {HLIL_SX, {SourceExprHighLevelOperandUsage}}, {HLIL_ZX, {SourceExprHighLevelOperandUsage}},
-        {HLIL_LOW_PART, {SourceExprHighLevelOperandUsage}}, {HLIL_BOOL_TO_INT, {SourceExprHighLevelOperandUsage}},
-        {HLIL_UNIMPL_MEM, {SourceExprHighLevelOperandUsage}},
-        {HLIL_FADD, {LeftExprHighLevelOperandUsage, RightExprHighLevelOperandUsage}},
-        {HLIL_FSUB, {LeftExprHighLevelOperandUsage, RightExprHighLevelOperandUsage}},
-        {HLIL_FMUL, {LeftExprHighLevelOperandUsage, RightExprHighLevelOperandUsage}},
-        {HLIL_FDIV, {LeftExprHighLevelOperandUsage, RightExprHighLevelOperandUsage}},
-        {HLIL_FSQRT, {SourceExprHighLevelOperandUsage}}, {HLIL_FNEG, {SourceExprHighLevelOperandUsage}},
-        {HLIL_FABS, {SourceExprHighLevelOperandUsage}}, {HLIL_FLOAT_TO_INT, {SourceExprHighLevelOperandUsage}},
-        {HLIL_INT_TO_FLOAT, {SourceExprHighLevelOperandUsage}}, {HLIL_FLOAT_CONV, {SourceExprHighLevelOperandUsage}},
-        {HLIL_ROUND_TO_INT, {SourceExprHighLevelOperandUsage}}, {HLIL_FLOOR, {SourceExprHighLevelOperandUsage}},
-        {HLIL_CEIL, {SourceExprHighLevelOperandUsage}}, {HLIL_FTRUNC, {SourceExprHighLevelOperandUsage}},
-        {HLIL_FCMP_E, {LeftExprHighLevelOperandUsage, RightExprHighLevelOperandUsage}},
-        {HLIL_FCMP_NE, {LeftExprHighLevelOperandUsage, RightExprHighLevelOperandUsage}},
-        {HLIL_FCMP_LT, {LeftExprHighLevelOperandUsage, RightExprHighLevelOperandUsage}},
-        {HLIL_FCMP_LE, {LeftExprHighLevelOperandUsage, RightExprHighLevelOperandUsage}},
-        {HLIL_FCMP_GE, {LeftExprHighLevelOperandUsage, RightExprHighLevelOperandUsage}},
-        {HLIL_FCMP_GT, {LeftExprHighLevelOperandUsage, RightExprHighLevelOperandUsage}},
-        {HLIL_FCMP_O, {LeftExprHighLevelOperandUsage, RightExprHighLevelOperandUsage}},
-        {HLIL_FCMP_UO, {LeftExprHighLevelOperandUsage, RightExprHighLevelOperandUsage}}};
-
-
-static unordered_map<BNHighLevelILOperation, unordered_map<HighLevelILOperandUsage, size_t>>
-    GetOperandIndexForOperandUsages()
-{
-	unordered_map<BNHighLevelILOperation, unordered_map<HighLevelILOperandUsage, size_t>> result;
-	result.reserve(HighLevelILInstructionBase::operationOperandUsage.size());
-	for (auto& operation : HighLevelILInstructionBase::operationOperandUsage)
+template <typename... Usages>
+static constexpr HighLevelILOperationOperands OperandUsages(Usages... usages)
+{
+	return HighLevelILOperationOperands {true, sizeof...(usages), {usages...}, {}};
+}
+
+
+// Operand usages of each operation, in operand order. This is the single source of truth for operand layout; the
+// lookup tables below are generated from it at compile time.
+static constexpr HighLevelILOperationOperands OperandUsagesForOperation(BNHighLevelILOperation operation)
+{
+	switch (operation)
+	{
+	case HLIL_NOP:
+	case HLIL_BREAK:
+	case HLIL_CONTINUE:
+	case HLIL_NORET:
+	case HLIL_BP:
+	case HLIL_UNDEF:
+	case HLIL_UNIMPL:
+	case HLIL_UNREACHABLE:
+		return OperandUsages();
+	case HLIL_BLOCK:
+		return OperandUsages(BlockExprsHighLevelOperandUsage);
+	case HLIL_IF:
+		return OperandUsages(
+		    ConditionExprHighLevelOperandUsage, TrueExprHighLevelOperandUsage, FalseExprHighLevelOperandUsage);
+	case HLIL_WHILE:
+		return OperandUsages(ConditionExprHighLevelOperandUsage, LoopExprHighLevelOperandUsage);
+	case HLIL_WHILE_SSA:
+		return OperandUsages(
+		    ConditionPhiExprHighLevelOperandUsage, ConditionExprHighLevelOperandUsage, LoopExprHighLevelOperandUsage);
+	case HLIL_DO_WHILE:
+		return OperandUsages(LoopExprHighLevelOperandUsage, ConditionExprHighLevelOperandUsage);
+	case HLIL_DO_WHILE_SSA:
+		return OperandUsages(
+		    LoopExprHighLevelOperandUsage, ConditionPhiExprHighLevelOperandUsage, ConditionExprHighLevelOperandUsage);
+	case HLIL_FOR:
+		return OperandUsages(
+		    InitExprHighLevelOperandUsage, ConditionExprHighLevelOperandUsage, UpdateExprHighLevelOperandUsage,
+		    LoopExprHighLevelOperandUsage);
+	case HLIL_FOR_SSA:
+		return OperandUsages(
+		    InitExprHighLevelOperandUsage, ConditionPhiExprHighLevelOperandUsage, ConditionExprHighLevelOperandUsage,
+		    UpdateExprHighLevelOperandUsage, LoopExprHighLevelOperandUsage);
+	case HLIL_SWITCH:
+		return OperandUsages(
+		    ConditionExprHighLevelOperandUsage, DefaultExprHighLevelOperandUsage, CasesHighLevelOperandUsage);
+	case HLIL_CASE:
+		return OperandUsages(ValueExprsHighLevelOperandUsage, TrueExprHighLevelOperandUsage);
+	case HLIL_JUMP:
+		return OperandUsages(DestExprHighLevelOperandUsage);
+	case HLIL_RET:
+		return OperandUsages(SourceExprsHighLevelOperandUsage);
+	case HLIL_GOTO:
+	case HLIL_LABEL:
+		return OperandUsages(TargetHighLevelOperandUsage);
+	case HLIL_VAR_DECLARE:
+	case HLIL_VAR:
+		return OperandUsages(VariableHighLevelOperandUsage);
+	case HLIL_VAR_INIT:
+		return OperandUsages(DestVariableHighLevelOperandUsage, SourceExprHighLevelOperandUsage);
+	case HLIL_VAR_INIT_SSA:
+		return OperandUsages(DestSSAVariableHighLevelOperandUsage, SourceExprHighLevelOperandUsage);
+	case HLIL_ASSIGN:
+		return OperandUsages(DestExprHighLevelOperandUsage, SourceExprHighLevelOperandUsage);
+	case HLIL_ASSIGN_UNPACK:
+		return OperandUsages(DestExprsHighLevelOperandUsage, SourceExprHighLevelOperandUsage);
+	case HLIL_ASSIGN_MEM_SSA:
+		return OperandUsages(
+		    DestExprHighLevelOperandUsage, DestMemoryVersionHighLevelOperandUsage, SourceExprHighLevelOperandUsage,
+		    SourceMemoryVersionHighLevelOperandUsage);
+	case HLIL_ASSIGN_UNPACK_MEM_SSA:
+		return OperandUsages(
+		    DestExprsHighLevelOperandUsage, DestMemoryVersionHighLevelOperandUsage, SourceExprHighLevelOperandUsage,
+		    SourceMemoryVersionHighLevelOperandUsage);
+	case HLIL_VAR_SSA:
+		return OperandUsages(SSAVariableHighLevelOperandUsage);
+	case HLIL_VAR_PHI:
+		return OperandUsages(DestSSAVariableHighLevelOperandUsage, SourceSSAVariablesHighLevelOperandUsage);
+	case HLIL_MEM_PHI:
+		return OperandUsages(DestMemoryVersionHighLevelOperandUsage, SourceMemoryVersionsHighLevelOperandUsage);
+	case HLIL_STRUCT_FIELD:
+	case HLIL_DEREF_FIELD:
+		return OperandUsages(
+		    SourceExprHighLevelOperandUsage, OffsetHighLevelOperandUsage, MemberIndexHighLevelOperandUsage);
+	case HLIL_ARRAY_INDEX:
+		return OperandUsages(SourceExprHighLevelOperandUsage, IndexExprHighLevelOperandUsage);
+	case HLIL_ARRAY_INDEX_SSA:
+		return OperandUsages(
+		    SourceExprHighLevelOperandUsage, SourceMemoryVersionHighLevelOperandUsage, IndexExprHighLevelOperandUsage);
+	case HLIL_SPLIT:
+		return OperandUsages(HighExprHighLevelOperandUsage, LowExprHighLevelOperandUsage);
+	case HLIL_DEREF:
+	case HLIL_ADDRESS_OF:
+	case HLIL_NEG:
+	case HLIL_NOT:
+	case HLIL_SX:
+	case HLIL_ZX:
+	case HLIL_LOW_PART:
+	case HLIL_BOOL_TO_INT:
+	case HLIL_UNIMPL_MEM:
+	case HLIL_FSQRT:
+	case HLIL_FNEG:
+	case HLIL_FABS:
+	case HLIL_FLOAT_TO_INT:
+	case HLIL_INT_TO_FLOAT:
+	case HLIL_FLOAT_CONV:
+	case HLIL_ROUND_TO_INT:
+	case HLIL_FLOOR:
+	case HLIL_CEIL:
+	case HLIL_FTRUNC:
+		return OperandUsages(SourceExprHighLevelOperandUsage);
+	case HLIL_DEREF_SSA:
+		return OperandUsages(SourceExprHighLevelOperandUsage, SourceMemoryVersionHighLevelOperandUsage);
+	case HLIL_DEREF_FIELD_SSA:
+		return OperandUsages(
+		    SourceExprHighLevelOperandUsage, SourceMemoryVersionHighLevelOperandUsage, OffsetHighLevelOperandUsage,
+		    MemberIndexHighLevelOperandUsage);
+	case HLIL_CALL:
+	case HLIL_TAILCALL:
+		return OperandUsages(DestExprHighLevelOperandUsage, ParameterExprsHighLevelOperandUsage);
+	case HLIL_SYSCALL:
+		return OperandUsages(ParameterExprsHighLevelOperandUsage);
+	case HLIL_INTRINSIC:
+		return OperandUsages(IntrinsicHighLevelOperandUsage, ParameterExprsHighLevelOperandUsage);
+	case HLIL_CALL_SSA:
+		return OperandUsages(
+		    DestExprHighLevelOperandUsage, ParameterExprsHighLevelOperandUsage, DestMemoryVersionHighLevelOperandUsage,
+		    SourceMemoryVersionHighLevelOperandUsage);
+	case HLIL_SYSCALL_SSA:
+		return OperandUsages(
+		    ParameterExprsHighLevelOperandUsage, DestMemoryVersionHighLevelOperandUsage,
+		    SourceMemoryVersionHighLevelOperandUsage);
+	case HLIL_INTRINSIC_SSA:
+		return OperandUsages(
+		    IntrinsicHighLevelOperandUsage, ParameterExprsHighLevelOperandUsage, DestMemoryVersionHighLevelOperandUsage,
+		    SourceMemoryVersionHighLevelOperandUsage);
+	case HLIL_TRAP:
+		return OperandUsages(VectorHighLevelOperandUsage);
+	case HLIL_CONST:
+	case HLIL_CONST_PTR:
+	case HLIL_FLOAT_CONST:
+	case HLIL_IMPORT:
+		return OperandUsages(ConstantHighLevelOperandUsage);
+	case HLIL_EXTERN_PTR:
+		return OperandUsages(ConstantHighLevelOperandUsage, OffsetHighLevelOperandUsage);
+	case HLIL_CONST_DATA:
+		return OperandUsages(ConstantDataHighLevelOperandUsage);
+	case HLIL_ADD:
+	case HLIL_SUB:
+	case HLIL_AND:
+	case HLIL_OR:
+	case HLIL_XOR:
+	case HLIL_LSL:
+	case HLIL_LSR:
+	case HLIL_ASR:
+	case HLIL_ROL:
+	case HLIL_ROR:
+	case HLIL_MUL:
+	case HLIL_MULU_DP:
+	case HLIL_MULS_DP:
+	case HLIL_DIVU:
+	case HLIL_DIVS:
+	case HLIL_MODU:
+	case HLIL_MODS:
+	case HLIL_CMP_E:
+	case HLIL_CMP_NE:
+	case HLIL_CMP_SLT:
+	case HLIL_CMP_ULT:
+	case HLIL_CMP_SLE:
+	case HLIL_CMP_ULE:
+	case HLIL_CMP_SGE:
+	case HLIL_CMP_UGE:
+	case HLIL_CMP_SGT:
+	case HLIL_CMP_UGT:
+	case HLIL_TEST_BIT:
+	case HLIL_ADD_OVERFLOW:
+	case HLIL_DIVU_DP:
+	case HLIL_DIVS_DP:
+	case HLIL_MODU_DP:
+	case HLIL_MODS_DP:
+	case HLIL_FADD:
+	case HLIL_FSUB:
+	case HLIL_FMUL:
+	case HLIL_FDIV:
+	case HLIL_FCMP_E:
+	case HLIL_FCMP_NE:
+	case HLIL_FCMP_LT:
+	case HLIL_FCMP_LE:
+	case HLIL_FCMP_GE:
+	case HLIL_FCMP_GT:
+	case HLIL_FCMP_O:
+	case HLIL_FCMP_UO:
+		return OperandUsages(LeftExprHighLevelOperandUsage, RightExprHighLevelOperandUsage);
+	case HLIL_ADC:
+	case HLIL_SBB:
+	case HLIL_RLC:
+	case HLIL_RRC:
+		return OperandUsages(
+		    LeftExprHighLevelOperandUsage, RightExprHighLevelOperandUsage, CarryExprHighLevelOperandUsage);
+	default:
+		return HighLevelILOperationOperands {};
+	}
+}
+
+
+static constexpr HighLevelILOperandType OperandTypeForUsage(HighLevelILOperandUsage usage)
+{
+	switch (usage)
+	{
+	case SourceExprHighLevelOperandUsage:
+	case DestExprHighLevelOperandUsage:
+	case LeftExprHighLevelOperandUsage:
+	case RightExprHighLevelOperandUsage:
+	case CarryExprHighLevelOperandUsage:
+	case IndexExprHighLevelOperandUsage:
+	case ConditionExprHighLevelOperandUsage:
+	case ConditionPhiExprHighLevelOperandUsage:
+	case TrueExprHighLevelOperandUsage:
+	case FalseExprHighLevelOperandUsage:
+	case LoopExprHighLevelOperandUsage:
+	case InitExprHighLevelOperandUsage:
+	case UpdateExprHighLevelOperandUsage:
+	case DefaultExprHighLevelOperandUsage:
+	case HighExprHighLevelOperandUsage:
+	case LowExprHighLevelOperandUsage:
+		return ExprHighLevelOperand;
+	case VariableHighLevelOperandUsage:
+	case DestVariableHighLevelOperandUsage:
+		return VariableHighLevelOperand;
+	case SSAVariableHighLevelOperandUsage:
+	case DestSSAVariableHighLevelOperandUsage:
+		return SSAVariableHighLevelOperand;
+	case OffsetHighLevelOperandUsage:
+	case ConstantHighLevelOperandUsage:
+	case VectorHighLevelOperandUsage:
+		return IntegerHighLevelOperand;
+	case MemberIndexHighLevelOperandUsage:
+	case TargetHighLevelOperandUsage:
+	case SourceMemoryVersionHighLevelOperandUsage:
+	case DestMemoryVersionHighLevelOperandUsage:
+		return IndexHighLevelOperand;
+	case ConstantDataHighLevelOperandUsage:
+		return ConstantDataHighLevelOperand;
+	case IntrinsicHighLevelOperandUsage:
+		return IntrinsicHighLevelOperand;
+	case ParameterExprsHighLevelOperandUsage:
+	case SourceExprsHighLevelOperandUsage:
+	case DestExprsHighLevelOperandUsage:
+	case BlockExprsHighLevelOperandUsage:
+	case CasesHighLevelOperandUsage:
+	case ValueExprsHighLevelOperandUsage:
+		return ExprListHighLevelOperand;
+	case SourceSSAVariablesHighLevelOperandUsage:
+		return SSAVariableListHighLevelOperand;
+	case SourceMemoryVersionsHighLevelOperandUsage:
+		return IndexListHighLevelOperand;
+	}
+	throw HighLevelILInstructionAccessException();
+}
+
+
+static constexpr HighLevelILOperationOperands ComputeOperationOperands(BNHighLevelILOperation operation)
+{
+	HighLevelILOperationOperands result = OperandUsagesForOperation(operation);
+	size_t operand = 0;
+	for (size_t i = 0; i < result.count; i++)
 	{
-		result[operation.first] = unordered_map<HighLevelILOperandUsage, size_t>();
-		result[operation.first].reserve(operation.second.size());
-		size_t operand = 0;
-		for (auto usage : operation.second)
+		HighLevelILOperandUsage usage = result.usages[i];
+		result.operandIndices[i] = (uint8_t)operand;
+		switch (OperandTypeForUsage(usage))
 		{
-			result[operation.first][usage] = operand;
-			switch (HighLevelILInstructionBase::operandTypeForUsage[usage])
-			{
-			case SSAVariableHighLevelOperand:
-			case SSAVariableListHighLevelOperand:
-			case ExprListHighLevelOperand:
-			case IndexListHighLevelOperand:
-				// SSA variables and lists take two operand slots
-				operand += 2;
-				break;
-			default:
-				operand++;
-				break;
-			}
+		case SSAVariableHighLevelOperand:
+		case SSAVariableListHighLevelOperand:
+		case ExprListHighLevelOperand:
+		case IndexListHighLevelOperand:
+			// SSA variables and lists take two operand slots
+			operand += 2;
+			break;
+		default:
+			operand++;
+			break;
 		}
 	}
 	return result;
 }
 
 
-unordered_map<BNHighLevelILOperation, unordered_map<HighLevelILOperandUsage, size_t>>
-    HighLevelILInstructionBase::operationOperandIndex = GetOperandIndexForOperandUsages();
+namespace
+{
+	constexpr size_t HighLevelILOperationCount = HLIL_MEM_PHI + 1;
+	constexpr size_t HighLevelILOperandUsageCount = DestMemoryVersionHighLevelOperandUsage + 1;
+	constexpr uint8_t InvalidOperandIndex = 0xff;
+
+	struct HighLevelILOperandTables
+	{
+		HighLevelILOperationOperands operations[HighLevelILOperationCount];
+		uint8_t operandIndex[HighLevelILOperationCount][HighLevelILOperandUsageCount];
+	};
+}  // namespace
+
+
+static constexpr HighLevelILOperandTables BuildOperandTables()
+{
+	HighLevelILOperandTables result {};
+	for (size_t i = 0; i < HighLevelILOperationCount; i++)
+	{
+		result.operations[i] = ComputeOperationOperands((BNHighLevelILOperation)i);
+		for (size_t j = 0; j < HighLevelILOperandUsageCount; j++)
+			result.operandIndex[i][j] = InvalidOperandIndex;
+		for (size_t j = 0; j < result.operations[i].count; j++)
+			result.operandIndex[i][result.operations[i].usages[j]] = result.operations[i].operandIndices[j];
+	}
+	return result;
+}
+
+
+static constexpr HighLevelILOperandTables s_operandTables = BuildOperandTables();
+
+
+HighLevelILOperandType HighLevelILInstructionBase::GetOperandTypeForUsage(HighLevelILOperandUsage usage)
+{
+	return OperandTypeForUsage(usage);
+}
+
+
+const HighLevelILOperationOperands* HighLevelILInstructionBase::GetOperationOperands(BNHighLevelILOperation operation)
+{
+	if ((size_t)operation >= HighLevelILOperationCount || !s_operandTables.operations[operation].valid)
+		return nullptr;
+	return &s_operandTables.operations[operation];
+}
 
 
 bool HighLevelILIntegerList::ListIterator::operator==(const ListIterator& a) const
@@ -509,10 +646,7 @@ HighLevelILOperand::HighLevelILOperand(
     m_instr(instr),
     m_usage(usage), m_operandIndex(operandIndex)
 {
-	auto i = HighLevelILInstructionBase::operandTypeForUsage.find(m_usage);
-	if (i == HighLevelILInstructionBase::operandTypeForUsage.end())
-		throw HighLevelILInstructionAccessException();
-	m_type = i->second;
+	m_type = HighLevelILInstructionBase::GetOperandTypeForUsage(m_usage);
 }
 
 
@@ -598,19 +732,14 @@ HighLevelILIndexList HighLevelILOperand::GetIndexList() const
 
 const HighLevelILOperand HighLevelILOperandList::ListIterator::operator*()
 {
-	HighLevelILOperandUsage usage = *pos;
-	auto i = owner->m_operandIndexMap.find(usage);
-	if (i == owner->m_operandIndexMap.end())
-		throw HighLevelILInstructionAccessException();
-	return HighLevelILOperand(owner->m_instr, usage, i->second);
+	return HighLevelILOperand(owner->m_instr, owner->m_operands.usages[pos], owner->m_operands.operandIndices[pos]);
 }
 
 
-HighLevelILOperandList::HighLevelILOperandList(const HighLevelILInstruction& instr,
-    const vector<HighLevelILOperandUsage>& usageList,
-    const unordered_map<HighLevelILOperandUsage, size_t>& operandIndexMap) :
+HighLevelILOperandList::HighLevelILOperandList(
+    const HighLevelILInstruction& instr, const HighLevelILOperationOperands& operands) :
     m_instr(instr),
-    m_usageList(usageList), m_operandIndexMap(operandIndexMap)
+    m_operands(operands)
 {}
 
 
@@ -618,7 +747,7 @@ HighLevelILOperandList::const_iterator HighLevelILOperandList::begin() const
 {
 	const_iterator result;
 	result.owner = this;
-	result.pos = m_usageList.begin();
+	result.pos = 0;
 	return result;
 }
 
@@ -627,24 +756,22 @@ HighLevelILOperandList::const_iterator HighLevelILOperandList::end() const
 {
 	const_iterator result;
 	result.owner = this;
-	result.pos = m_usageList.end();
+	result.pos = m_operands.count;
 	return result;
 }
 
 
 size_t HighLevelILOperandList::size() const
 {
-	return m_usageList.size();
+	return m_operands.count;
 }
 
 
 const HighLevelILOperand HighLevelILOperandList::operator[](size_t i) const
 {
-	HighLevelILOperandUsage usage = m_usageList[i];
-	auto indexMap = m_operandIndexMap.find(usage);
-	if (indexMap == m_operandIndexMap.end())
+	if (i >= m_operands.count)
 		throw HighLevelILInstructionAccessException();
-	return HighLevelILOperand(m_instr, usage, indexMap->second);
+	return HighLevelILOperand(m_instr, m_operands.usages[i], m_operands.operandIndices[i]);
 }
 
 
@@ -713,13 +840,10 @@ HighLevelILInstruction::HighLevelILInstruction(const HighLevelILInstructionBase&
 
 HighLevelILOperandList HighLevelILInstructionBase::GetOperands() const
 {
-	auto usage = operationOperandUsage.find(operation);
-	if (usage == operationOperandUsage.end())
-		throw HighLevelILInstructionAccessException();
-	auto operandIndex = operationOperandIndex.find(operation);
-	if (operandIndex == operationOperandIndex.end())
+	const HighLevelILOperationOperands* operands = GetOperationOperands(operation);
+	if (!operands)
 		throw HighLevelILInstructionAccessException();
-	return HighLevelILOperandList(*(const HighLevelILInstruction*)this, usage->second, operandIndex->second);
+	return HighLevelILOperandList(*(const HighLevelILInstruction*)this, *operands);
 }
 
 
@@ -1288,16 +1412,7 @@ void HighLevelILInstruction::CollectSubExprs(stack<size_t>& toProcess) const
 
 void HighLevelILInstruction::VisitExprs(const std::function<bool(const HighLevelILInstruction& expr)>& func) const
 {
-	stack<size_t> toProcess;
-	toProcess.push(exprIndex);
-	while (!toProcess.empty())
-	{
-		HighLevelILInstruction cur = function->GetExpr(toProcess.top(), ast);
-		toProcess.pop();
-		if (!func(cur))
-			continue;
-		cur.CollectSubExprs(toProcess);
-	}
+	VisitExprs<const std::function<bool(const HighLevelILInstruction& expr)>&>(func);
 }
 
 
@@ -2136,13 +2251,12 @@ bool HighLevelILInstruction::operator!=(const HighLevelILInstruction& other) con
 
 bool HighLevelILInstruction::GetOperandIndexForUsage(HighLevelILOperandUsage usage, size_t& operandIndex) const
 {
-	auto operationIter = HighLevelILInstructionBase::operationOperandIndex.find(operation);
-	if (operationIter == HighLevelILInstructionBase::operationOperandIndex.end())
+	if ((size_t)operation >= HighLevelILOperationCount)
 		return false;
-	auto usageIter = operationIter->second.find(usage);
-	if (usageIter == operationIter->second.end())
+	uint8_t index = s_operandTables.operandIndex[operation][usage];
+	if (index == InvalidOperandIndex)
 		return false;
-	operandIndex = usageIter->second;
+	operandIndex = index;
 	return true;
 }
 
@@ -118,6 +118,21 @@ namespace BinaryNinja
 		SourceMemoryVersionsHighLevelOperandUsage,
 		DestMemoryVersionHighLevelOperandUsage
 	};
+
+	/*!
+		Operand layout of an operation: the usage of each operand, in order, and the raw operand slot it starts at.
+
+		\ingroup highlevelil
+	*/
+	struct HighLevelILOperationOperands
+	{
+		static constexpr size_t MaxUsages = 5;
+
+		bool valid;
+		uint8_t count;
+		HighLevelILOperandUsage usages[MaxUsages];
+		uint8_t operandIndices[MaxUsages];
+	};
 }  // namespace BinaryNinjaCore
 
 namespace std {
@@ -333,10 +348,8 @@ namespace BinaryNinja
 		size_t exprIndex, instructionIndex;
 		bool ast;
 
-		static _STD_UNORDERED_MAP<HighLevelILOperandUsage, HighLevelILOperandType> operandTypeForUsage;
-		static _STD_UNORDERED_MAP<BNHighLevelILOperation, _STD_VECTOR<HighLevelILOperandUsage>> operationOperandUsage;
-		static _STD_UNORDERED_MAP<BNHighLevelILOperation, _STD_UNORDERED_MAP<HighLevelILOperandUsage, size_t>>
-		    operationOperandIndex;
+		static HighLevelILOperandType GetOperandTypeForUsage(HighLevelILOperandUsage usage);
+		static const HighLevelILOperationOperands* GetOperationOperands(BNHighLevelILOperation operation);
 
 		HighLevelILOperandList GetOperands() const;
 
@@ -455,6 +468,27 @@ namespace BinaryNinja
 
 		void CollectSubExprs(_STD_STACK<size_t>& toProcess) const;
 		void VisitExprs(const std::function<bool(const HighLevelILInstruction& expr)>& func) const;
+
+		/*! Visit this expression and all of its sub-expressions in pre-order. Returning false from the callback
+			skips the sub-expressions of the current expression. Unlike the std::function overload, the callback
+			is inlined into the traversal loop.
+
+			\param func Callback taking a const HighLevelILInstruction& and returning whether to visit its sub-expressions
+		*/
+		template <typename T>
+		void VisitExprs(T&& func) const
+		{
+			_STD_STACK<size_t> toProcess;
+			toProcess.push(exprIndex);
+			while (!toProcess.empty())
+			{
+				HighLevelILInstruction cur = function->GetExpr(toProcess.top(), ast);
+				toProcess.pop();
+				if (!func(cur))
+					continue;
+				cur.CollectSubExprs(toProcess);
+			}
+		}
 		void VisitExprs(const std::function<bool(const HighLevelILInstruction& expr)>& preFunc,
 			const std::function<void(const HighLevelILInstruction& expr)>& postFunc) const;
 
@@ -814,7 +848,7 @@ namespace BinaryNinja
 		struct ListIterator
 		{
 			const HighLevelILOperandList* owner;
-			_STD_VECTOR<HighLevelILOperandUsage>::const_iterator pos;
+			size_t pos;
 			bool operator==(const ListIterator& a) const { return pos == a.pos; }
 			bool operator!=(const ListIterator& a) const { return pos != a.pos; }
 			bool operator<(const ListIterator& a) const { return pos < a.pos; }
@@ -827,15 +861,12 @@ namespace BinaryNinja
 		};
 
 		HighLevelILInstruction m_instr;
-		const _STD_VECTOR<HighLevelILOperandUsage>& m_usageList;
-		const _STD_UNORDERED_MAP<HighLevelILOperandUsage, size_t>& m_operandIndexMap;
+		const HighLevelILOperationOperands& m_operands;
 
 	  public:
 		typedef ListIterator const_iterator;
 
-		HighLevelILOperandList(const HighLevelILInstruction& instr,
-		    const _STD_VECTOR<HighLevelILOperandUsage>& usageList,
-		    const _STD_UNORDERED_MAP<HighLevelILOperandUsage, size_t>& operandIndexMap);
+		HighLevelILOperandList(const HighLevelILInstruction& instr, const HighLevelILOperationOperands& operands);
 
 		const_iterator begin() const;
 		const_iterator end() const;
@@ -19,14 +19,62 @@
 // IN THE SOFTWARE.
 
 #define _CRT_SECURE_NO_WARNINGS
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
 #include <cstdarg>
 #include <cstdio>
+#include <cstdlib>
+#include <mutex>
 #include <thread>
 #include "binaryninjaapi.h"
 
 using namespace BinaryNinja;
 using namespace std;
 
+// Sinks registered outside of this module (UI log view, Python listeners, other plugins) are not visible here and the
+// core has no call that reports their levels, so the effective minimum level is the lowest of the externally declared
+// level and every sink registered through this API. The external level defaults to DebugLog, which keeps the gate
+// open until the host declares otherwise with SetExternalLogLevel. Messages below it are dropped before formatting or
+// calling into the core.
+static constexpr int NoLogSink = AlertLog + 1;
+static mutex g_logLevelMutex;
+static vector<LogListener*> g_logListeners;
+static int g_externalLogLevel = DebugLog;
+static int g_logSinkLevel = NoLogSink;
+static atomic<int> g_minimumLogLevel {DebugLog};
+
+
+static void RefreshMinimumLogLevel()
+{
+	// Caller must hold g_logLevelMutex
+	int level = min(g_externalLogLevel, g_logSinkLevel);
+	for (auto listener : g_logListeners)
+		level = min(level, (int)listener->GetLogLevel());
+	g_minimumLogLevel.store(level, memory_order_relaxed);
+}
+
+
+static void AddLogSink(BNLogLevel minimumLevel)
+{
+	unique_lock<mutex> lock(g_logLevelMutex);
+	g_logSinkLevel = min(g_logSinkLevel, (int)minimumLevel);
+	RefreshMinimumLogLevel();
+}
+
+
+LogListener::~LogListener()
+{
+	bool registered;
+	{
+		unique_lock<mutex> lock(g_logLevelMutex);
+		registered = find(g_logListeners.begin(), g_logListeners.end(), this) != g_logListeners.end();
+	}
+	if (registered)
+		UnregisterLogListener(this);
+}
+
+
 void LogListener::LogMessageCallback(void* ctxt, size_t session, BNLogLevel level, const char* msg, const char* logger_name, size_t tid)
 {
 	LogListener* listener = (LogListener*)ctxt;
@@ -56,6 +104,10 @@ void LogListener::RegisterLogListener(LogListener* listener)
 	callbacks.close = CloseLogCallback;
 	callbacks.getLogLevel = GetLogLevelCallback;
 	BNRegisterLogListener(&callbacks);
+
+	unique_lock<mutex> lock(g_logLevelMutex);
+	g_logListeners.push_back(listener);
+	RefreshMinimumLogLevel();
 }
 
 
@@ -66,12 +118,336 @@ void LogListener::UnregisterLogListener(LogListener* listener)
 	callbacks.log = LogMessageCallback;
 	callbacks.close = CloseLogCallback;
 	BNUnregisterLogListener(&callbacks);
+
+	unique_lock<mutex> lock(g_logLevelMutex);
+	g_logListeners.erase(remove(g_logListeners.begin(), g_logListeners.end(), listener), g_logListeners.end());
+	RefreshMinimumLogLevel();
 }
 
 
 void LogListener::UpdateLogListeners()
 {
 	BNUpdateLogListeners();
+
+	unique_lock<mutex> lock(g_logLevelMutex);
+	RefreshMinimumLogLevel();
+}
+
+
+// Bounded multi-producer, single-consumer ring buffer. Each cell carries a sequence number that tells producers
+// and the drain thread whose turn it is, so logging threads only contend on a single atomic increment.
+struct AsyncLogListener::Queue
+{
+	struct Cell
+	{
+		atomic<size_t> sequence;
+		Message message;
+	};
+
+	unique_ptr<Cell[]> cells;
+	size_t mask;
+	OverflowPolicy policy;
+	size_t maxBatchSize;
+
+	alignas(64) atomic<size_t> enqueuePos {0};
+	alignas(64) atomic<size_t> dequeuePos {0};
+	atomic<uint64_t> delivered {0};
+	atomic<uint64_t> dropped {0};
+	atomic<bool> drainWaiting {false};
+	atomic<size_t> producersWaiting {0};
+	atomic<bool> started {false};
+	atomic<bool> stopping {false};
+	atomic<bool> stopped {false};
+
+	mutex lock;
+	condition_variable drainCv, spaceCv, flushCv;
+	thread drainThread;
+
+	// Set by the drain thread itself, so that it can be compared without touching drainThread while Stop joins it
+	atomic<thread::id> drainThreadId;
+
+	bool TryEnqueue(size_t session, BNLogLevel level, const string& msg, const string& loggerName, size_t tid)
+	{
+		size_t pos = enqueuePos.load(memory_order_relaxed);
+		Cell* cell;
+		while (true)
+		{
+			cell = &cells[pos & mask];
+			size_t seq = cell->sequence.load(memory_order_acquire);
+			intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+			if (diff == 0)
+			{
+				if (enqueuePos.compare_exchange_weak(pos, pos + 1, memory_order_relaxed))
+					break;
+			}
+			else if (diff < 0)
+			{
+				return false;
+			}
+			else
+			{
+				pos = enqueuePos.load(memory_order_relaxed);
+			}
+		}
+
+		// Assigning into the cell reuses string capacity left behind by earlier messages
+		cell->message.session = session;
+		cell->message.level = level;
+		cell->message.msg.assign(msg);
+		cell->message.loggerName.assign(loggerName);
+		cell->message.tid = tid;
+		cell->sequence.store(pos + 1, memory_order_release);
+		return true;
+	}
+
+	bool TryDequeue(Message& out)
+	{
+		size_t pos = dequeuePos.load(memory_order_relaxed);
+		Cell* cell = &cells[pos & mask];
+		size_t seq = cell->sequence.load(memory_order_acquire);
+		if ((intptr_t)seq - (intptr_t)(pos + 1) < 0)
+			return false;
+
+		// Swap rather than move so that both sides keep their allocated string capacity
+		out.session = cell->message.session;
+		out.level = cell->message.level;
+		out.msg.swap(cell->message.msg);
+		out.loggerName.swap(cell->message.loggerName);
+		out.tid = cell->message.tid;
+		cell->sequence.store(pos + mask + 1, memory_order_release);
+		dequeuePos.store(pos + 1, memory_order_relaxed);
+		return true;
+	}
+
+	bool IsEmpty() const
+	{
+		size_t pos = dequeuePos.load(memory_order_relaxed);
+		size_t seq = cells[pos & mask].sequence.load(memory_order_acquire);
+		return (intptr_t)seq - (intptr_t)(pos + 1) < 0;
+	}
+
+	bool IsDrainThread() const
+	{
+		return this_thread::get_id() == drainThreadId.load(memory_order_acquire);
+	}
+};
+
+
+AsyncLogListener::AsyncLogListener(size_t capacity, OverflowPolicy policy, size_t maxBatchSize)
+{
+	size_t size = 2;
+	while (size < capacity)
+		size <<= 1;
+
+	m_queue = make_unique<Queue>();
+	m_queue->cells.reset(new Queue::Cell[size]);
+	for (size_t i = 0; i < size; i++)
+		m_queue->cells[i].sequence.store(i, memory_order_relaxed);
+	m_queue->mask = size - 1;
+	m_queue->policy = policy;
+	m_queue->maxBatchSize = max<size_t>(maxBatchSize, 1);
+}
+
+
+AsyncLogListener::~AsyncLogListener()
+{
+	// LogMessages belongs to the derived class, which is already destroyed by now. A drain thread that is still
+	// running could call into it at any moment, so there is no safe way to continue.
+	if (m_queue->started.load() && !m_queue->stopped.load())
+	{
+		fprintf(stderr, "AsyncLogListener destroyed without calling Stop\n");
+		abort();
+	}
+}
+
+
+void AsyncLogListener::StartDrainThread()
+{
+	// The thread is started by the first message rather than by the constructor, so it can never call LogMessages
+	// before the derived class is fully constructed
+	unique_lock<mutex> lock(m_queue->lock);
+	if (m_queue->started.load(memory_order_relaxed) || m_queue->stopping)
+		return;
+	m_queue->drainThread = thread([this]() { DrainThread(); });
+	m_queue->started.store(true, memory_order_release);
+}
+
+
+void AsyncLogListener::DrainThread()
+{
+	// Messages are moved into the batch and back into the spare slots after delivery, so the string storage they
+	// carry is reused by later batches instead of being reallocated
+	m_queue->drainThreadId.store(this_thread::get_id(), memory_order_release);
+
+	vector<Message> spare(m_queue->maxBatchSize);
+	vector<Message> batch;
+	batch.reserve(m_queue->maxBatchSize);
+	while (true)
+	{
+		size_t count = 0;
+		while (count < spare.size() && m_queue->TryDequeue(spare[count]))
+			batch.push_back(std::move(spare[count++]));
+
+		if (count == 0)
+		{
+			unique_lock<mutex> lock(m_queue->lock);
+			if (m_queue->stopped)
+				return;
+			m_queue->drainWaiting.store(true);
+			atomic_thread_fence(memory_order_seq_cst);
+			m_queue->drainCv.wait(lock, [this]() { return m_queue->stopping.load() || !m_queue->IsEmpty(); });
+			m_queue->drainWaiting.store(false);
+			if (m_queue->stopping && m_queue->IsEmpty())
+				return;
+			continue;
+		}
+
+		if (m_queue->producersWaiting.load() != 0)
+		{
+			unique_lock<mutex> lock(m_queue->lock);
+			m_queue->spaceCv.notify_all();
+		}
+
+		if (!m_queue->stopped)
+			LogMessages(batch);
+		for (size_t i = 0; i < count; i++)
+			spare[i] = std::move(batch[i]);
+		batch.clear();
+
+		m_queue->delivered.fetch_add(count);
+		unique_lock<mutex> lock(m_queue->lock);
+		m_queue->flushCv.notify_all();
+	}
+}
+
+
+void AsyncLogListener::LogMessage(
+	size_t session, BNLogLevel level, const string& msg, const string& logger_name, size_t tid)
+{
+	Queue& queue = *m_queue;
+	if (queue.stopping.load(memory_order_relaxed))
+	{
+		queue.dropped.fetch_add(1, memory_order_relaxed);
+		return;
+	}
+
+	while (!queue.TryEnqueue(session, level, msg, logger_name, tid))
+	{
+		// Blocking on the drain thread itself (a listener that logs) would never make progress
+		if (queue.policy == DropOnOverflow || queue.IsDrainThread())
+		{
+			queue.dropped.fetch_add(1, memory_order_relaxed);
+			return;
+		}
+
+		unique_lock<mutex> lock(queue.lock);
+		if (queue.stopping)
+		{
+			queue.dropped.fetch_add(1, memory_order_relaxed);
+			return;
+		}
+		queue.producersWaiting.fetch_add(1);
+		queue.spaceCv.wait_for(lock, chrono::milliseconds(10));
+		queue.producersWaiting.fetch_sub(1);
+	}
+
+	if (!queue.started.load(memory_order_acquire))
+	{
+		StartDrainThread();
+		return;
+	}
+
+	atomic_thread_fence(memory_order_seq_cst);
+	if (queue.drainWaiting.load())
+	{
+		unique_lock<mutex> lock(queue.lock);
+		queue.drainCv.notify_one();
+	}
+}
+
+
+void AsyncLogListener::CloseLog()
+{
+	Flush();
+}
+
+
+void AsyncLogListener::Flush()
+{
+	Queue& queue = *m_queue;
+	if (queue.IsDrainThread())
+		return;
+
+	uint64_t target = queue.enqueuePos.load();
+	unique_lock<mutex> lock(queue.lock);
+	queue.drainCv.notify_one();
+	queue.flushCv.wait(lock, [&]() { return queue.stopped || queue.delivered.load() >= target; });
+}
+
+
+void AsyncLogListener::Stop()
+{
+	Queue& queue = *m_queue;
+	if (queue.IsDrainThread())
+		return;
+	bool started;
+	{
+		unique_lock<mutex> lock(queue.lock);
+		if (queue.stopping)
+		{
+			// Another thread is already stopping the listener
+			queue.flushCv.wait(lock, [&]() { return queue.stopped.load(); });
+			return;
+		}
+		queue.stopping = true;
+		started = queue.started.load(memory_order_relaxed);
+		queue.drainCv.notify_all();
+		queue.spaceCv.notify_all();
+	}
+	if (started)
+		queue.drainThread.join();
+
+	unique_lock<mutex> lock(queue.lock);
+	queue.stopped = true;
+	queue.flushCv.notify_all();
+}
+
+
+size_t AsyncLogListener::GetCapacity() const
+{
+	return m_queue->mask + 1;
+}
+
+
+AsyncLogListener::OverflowPolicy AsyncLogListener::GetOverflowPolicy() const
+{
+	return m_queue->policy;
+}
+
+
+uint64_t AsyncLogListener::GetDroppedMessageCount() const
+{
+	return m_queue->dropped.load(memory_order_relaxed);
+}
+
+
+void BinaryNinja::SetExternalLogLevel(BNLogLevel level)
+{
+	unique_lock<mutex> lock(g_logLevelMutex);
+	g_externalLogLevel = level;
+	RefreshMinimumLogLevel();
+}
+
+
+BNLogLevel BinaryNinja::GetMinimumLogLevel()
+{
+	return (BNLogLevel)min(g_minimumLogLevel.load(memory_order_relaxed), (int)AlertLog);
+}
+
+
+bool BinaryNinja::IsLogLevelEnabled(BNLogLevel level)
+{
+	return (int)level >= g_minimumLogLevel.load(memory_order_relaxed);
 }
 
 
@@ -97,8 +473,16 @@ static void PerformLog(size_t session, BNLogLevel level, const string& logger_na
 }
 
 
+static void PerformLogString(size_t session, BNLogLevel level, const string& logger_name, size_t tid, const string& msg)
+{
+	BNLogString(session, level, logger_name.c_str(), tid, msg.c_str());
+}
+
+
 void BinaryNinja::Log(BNLogLevel level, const char* fmt, ...)
 {
+	if (!IsLogLevelEnabled(level))
+		return;
 	va_list args;
 	va_start(args, fmt);
 	PerformLog(0, level, "", 0, fmt, args);
@@ -109,6 +493,8 @@ void BinaryNinja::Log(BNLogLevel level, const char* fmt, ...)
 void BinaryNinja::LogTrace(const char* fmt, ...)
 {
 #ifdef _DEBUG
+	if (!IsLogLevelEnabled(DebugLog))
+		return;
 	va_list args;
 	va_start(args, fmt);
 	PerformLog(0, DebugLog, "", 0, fmt, args);
@@ -119,6 +505,8 @@ void BinaryNinja::LogTrace(const char* fmt, ...)
 
 void BinaryNinja::LogDebug(const char* fmt, ...)
 {
+	if (!IsLogLevelEnabled(DebugLog))
+		return;
 	va_list args;
 	va_start(args, fmt);
 	PerformLog(0, DebugLog, "", 0, fmt, args);
@@ -128,6 +516,8 @@ void BinaryNinja::LogDebug(const char* fmt, ...)
 
 void BinaryNinja::LogInfo(const char* fmt, ...)
 {
+	if (!IsLogLevelEnabled(InfoLog))
+		return;
 	va_list args;
 	va_start(args, fmt);
 	PerformLog(0, InfoLog, "", 0, fmt, args);
@@ -137,6 +527,8 @@ void BinaryNinja::LogInfo(const char* fmt, ...)
 
 void BinaryNinja::LogWarn(const char* fmt, ...)
 {
+	if (!IsLogLevelEnabled(WarningLog))
+		return;
 	va_list args;
 	va_start(args, fmt);
 	PerformLog(0, WarningLog, "", 0, fmt, args);
@@ -146,6 +538,8 @@ void BinaryNinja::LogWarn(const char* fmt, ...)
 
 void BinaryNinja::LogError(const char* fmt, ...)
 {
+	if (!IsLogLevelEnabled(ErrorLog))
+		return;
 	va_list args;
 	va_start(args, fmt);
 	PerformLog(0, ErrorLog, "", 0, fmt, args);
@@ -155,6 +549,8 @@ void BinaryNinja::LogError(const char* fmt, ...)
 
 void BinaryNinja::LogAlert(const char* fmt, ...)
 {
+	if (!IsLogLevelEnabled(AlertLog))
+		return;
 	va_list args;
 	va_start(args, fmt);
 	PerformLog(0, AlertLog, "", 0, fmt, args);
@@ -164,74 +560,99 @@ void BinaryNinja::LogAlert(const char* fmt, ...)
 
 void BinaryNinja::LogFV(BNLogLevel level, fmt::string_view format, fmt::format_args args)
 {
-	std::string value = fmt::vformat(format, args);
-	Log(level, "%s", value.c_str());
+	if (!IsLogLevelEnabled(level))
+		return;
+	string value = fmt::vformat(format, args);
+	PerformLogString(0, level, "", 0, value);
 }
 
 
 void BinaryNinja::LogTraceFV(fmt::string_view format, fmt::format_args args)
 {
-	std::string value = fmt::vformat(format, args);
-	LogTrace("%s", value.c_str());
+#ifdef _DEBUG
+	if (!IsLogLevelEnabled(DebugLog))
+		return;
+	string value = fmt::vformat(format, args);
+	PerformLogString(0, DebugLog, "", 0, value);
+#endif
 }
 
 
 void BinaryNinja::LogDebugFV(fmt::string_view format, fmt::format_args args)
 {
-	std::string value = fmt::vformat(format, args);
-	LogDebug("%s", value.c_str());
+	if (!IsLogLevelEnabled(DebugLog))
+		return;
+	string value = fmt::vformat(format, args);
+	PerformLogString(0, DebugLog, "", 0, value);
 }
 
 
 void BinaryNinja::LogInfoFV(fmt::string_view format, fmt::format_args args)
 {
-	std::string value = fmt::vformat(format, args);
-	LogInfo("%s", value.c_str());
+	if (!IsLogLevelEnabled(InfoLog))
+		return;
+	string value = fmt::vformat(format, args);
+	PerformLogString(0, InfoLog, "", 0, value);
 }
 
 
 void BinaryNinja::LogWarnFV(fmt::string_view format, fmt::format_args args)
 {
-	std::string value = fmt::vformat(format, args);
-	LogWarn("%s", value.c_str());
+	if (!IsLogLevelEnabled(WarningLog))
+		return;
+	string value = fmt::vformat(format, args);
+	PerformLogString(0, WarningLog, "", 0, value);
 }
 
 
 void BinaryNinja::LogErrorFV(fmt::string_view format, fmt::format_args args)
 {
-	std::string value = fmt::vformat(format, args);
-	LogError("%s", value.c_str());
+	if (!IsLogLevelEnabled(ErrorLog))
+		return;
+	string value = fmt::vformat(format, args);
+	PerformLogString(0, ErrorLog, "", 0, value);
 }
 
 
 void BinaryNinja::LogAlertFV(fmt::string_view format, fmt::format_args args)
 {
-	std::string value = fmt::vformat(format, args);
-	LogAlert("%s", value.c_str());
+	if (!IsLogLevelEnabled(AlertLog))
+		return;
+	string value = fmt::vformat(format, args);
+	PerformLogString(0, AlertLog, "", 0, value);
 }
 
 
 void BinaryNinja::LogToStdout(BNLogLevel minimumLevel)
 {
 	BNLogToStdout(minimumLevel);
+	AddLogSink(minimumLevel);
 }
 
 
 void BinaryNinja::LogToStderr(BNLogLevel minimumLevel)
 {
 	BNLogToStderr(minimumLevel);
+	AddLogSink(minimumLevel);
 }
 
 
 bool BinaryNinja::LogToFile(BNLogLevel minimumLevel, const string& path, bool append)
 {
-	return BNLogToFile(minimumLevel, path.c_str(), append);
+	if (!BNLogToFile(minimumLevel, path.c_str(), append))
+		return false;
+	AddLogSink(minimumLevel);
+	return true;
 }
 
 
 void BinaryNinja::CloseLogs()
 {
 	BNCloseLogs();
+
+	unique_lock<mutex> lock(g_logLevelMutex);
+	g_logSinkLevel = NoLogSink;
+	RefreshMinimumLogLevel();
 }
 
 size_t Logger::GetThreadId() const
@@ -251,8 +672,16 @@ Logger::Logger(const string& loggerName, size_t sessionId)
 }
 
 
+bool Logger::IsLevelEnabled(BNLogLevel level)
+{
+	return IsLogLevelEnabled(level);
+}
+
+
 void Logger::Log(BNLogLevel level, const char* fmt, ...)
 {
+	if (!IsLevelEnabled(level))
+		return;
 	va_list args;
 	va_start(args, fmt);
 	PerformLog(GetSessionId(), level, GetName(), GetThreadId(), fmt, args);
@@ -263,6 +692,8 @@ void Logger::Log(BNLogLevel level, const char* fmt, ...)
 void Logger::LogTrace(const char* fmt, ...)
 {
 #ifdef _DEBUG
+	if (!IsLevelEnabled(DebugLog))
+		return;
 	va_list args;
 	va_start(args, fmt);
 	PerformLog(GetSessionId(), DebugLog, GetName(), GetThreadId(), fmt, args);
@@ -273,6 +704,8 @@ void Logger::LogTrace(const char* fmt, ...)
 
 void Logger::LogDebug(const char* fmt, ...)
 {
+	if (!IsLevelEnabled(DebugLog))
+		return;
 	va_list args;
 	va_start(args, fmt);
 	PerformLog(GetSessionId(), DebugLog, GetName(), GetThreadId(), fmt, args);
@@ -282,6 +715,8 @@ void Logger::LogDebug(const char* fmt, ...)
 
 void Logger::LogInfo(const char* fmt, ...)
 {
+	if (!IsLevelEnabled(InfoLog))
+		return;
 	va_list args;
 	va_start(args, fmt);
 	PerformLog(GetSessionId(), InfoLog, GetName(), GetThreadId(), fmt, args);
@@ -291,6 +726,8 @@ void Logger::LogInfo(const char* fmt, ...)
 
 void Logger::LogWarn(const char* fmt, ...)
 {
+	if (!IsLevelEnabled(WarningLog))
+		return;
 	va_list args;
 	va_start(args, fmt);
 	PerformLog(GetSessionId(), WarningLog, GetName(), GetThreadId(), fmt, args);
@@ -300,6 +737,8 @@ void Logger::LogWarn(const char* fmt, ...)
 
 void Logger::LogError(const char* fmt, ...)
 {
+	if (!IsLevelEnabled(ErrorLog))
+		return;
 	va_list args;
 	va_start(args, fmt);
 	PerformLog(GetSessionId(), ErrorLog, GetName(), GetThreadId(), fmt, args);
@@ -309,6 +748,8 @@ void Logger::LogError(const char* fmt, ...)
 
 void Logger::LogAlert(const char* fmt, ...)
 {
+	if (!IsLevelEnabled(AlertLog))
+		return;
 	va_list args;
 	va_start(args, fmt);
 	PerformLog(GetSessionId(), AlertLog, GetName(), GetThreadId(), fmt, args);
@@ -318,50 +759,66 @@ void Logger::LogAlert(const char* fmt, ...)
 
 void Logger::LogFV(BNLogLevel level, fmt::string_view format, fmt::format_args args)
 {
-	std::string value = fmt::vformat(format, args);
-	Log(level, "%s", value.c_str());
+	if (!IsLevelEnabled(level))
+		return;
+	string value = fmt::vformat(format, args);
+	PerformLogString(GetSessionId(), level, GetName(), GetThreadId(), value);
 }
 
 
 void Logger::LogTraceFV(fmt::string_view format, fmt::format_args args)
 {
-	std::string value = fmt::vformat(format, args);
-	LogTrace("%s", value.c_str());
+#ifdef _DEBUG
+	if (!IsLevelEnabled(DebugLog))
+		return;
+	string value = fmt::vformat(format, args);
+	PerformLogString(GetSessionId(), DebugLog, GetName(), GetThreadId(), value);
+#endif
 }
 
 
 void Logger::LogDebugFV(fmt::string_view format, fmt::format_args args)
 {
-	std::string value = fmt::vformat(format, args);
-	LogDebug("%s", value.c_str());
+	if (!IsLevelEnabled(DebugLog))
+		return;
+	string value = fmt::vformat(format, args);
+	PerformLogString(GetSessionId(), DebugLog, GetName(), GetThreadId(), value);
 }
 
 
 void Logger::LogInfoFV(fmt::string_view format, fmt::format_args args)
 {
-	std::string value = fmt::vformat(format, args);
-	LogInfo("%s", value.c_str());
+	if (!IsLevelEnabled(InfoLog))
+		return;
+	string value = fmt::vformat(format, args);
+	PerformLogString(GetSessionId(), InfoLog, GetName(), GetThreadId(), value);
 }
 
 
 void Logger::LogWarnFV(fmt::string_view format, fmt::format_args args)
 {
-	std::string value = fmt::vformat(format, args);
-	LogWarn("%s", value.c_str());
+	if (!IsLevelEnabled(WarningLog))
+		return;
+	string value = fmt::vformat(format, args);
+	PerformLogString(GetSessionId(), WarningLog, GetName(), GetThreadId(), value);
 }
 
 
 void Logger::LogErrorFV(fmt::string_view format, fmt::format_args args)
 {
-	std::string value = fmt::vformat(format, args);
-	LogError("%s", value.c_str());
+	if (!IsLevelEnabled(ErrorLog))
+		return;
+	string value = fmt::vformat(format, args);
+	PerformLogString(GetSessionId(), ErrorLog, GetName(), GetThreadId(), value);
 }
 
 
 void Logger::LogAlertFV(fmt::string_view format, fmt::format_args args)
 {
-	std::string value = fmt::vformat(format, args);
-	LogAlert("%s", value.c_str());
+	if (!IsLevelEnabled(AlertLog))
+		return;
+	string value = fmt::vformat(format, args);
+	PerformLogString(GetSessionId(), AlertLog, GetName(), GetThreadId(), value);
 }
 
 
@@ -527,6 +527,7 @@ ExprId LowLevelILFunction::GetExprForRegisterOrConstantOperation(
 
 ExprId LowLevelILFunction::Operand(size_t n, ExprId expr)
 {
+	ReleaseExprSnapshot();
 	BNLowLevelILSetExprSourceOperand(m_object, expr, (uint32_t)n);
 	return expr;
 }
@@ -534,10 +535,27 @@ ExprId LowLevelILFunction::Operand(size_t n, ExprId expr)
 
 BNLowLevelILInstruction LowLevelILFunction::GetRawExpr(size_t i) const
 {
+	if (m_exprSnapshot && i < m_exprSnapshot->size())
+		return (*m_exprSnapshot)[i];
 	return BNGetLowLevelILByIndex(m_object, i);
 }
 
 
+const vector<BNLowLevelILInstruction>& LowLevelILFunction::GetExprSnapshot()
+{
+	if (!m_exprSnapshot)
+	{
+		vector<BNLowLevelILInstruction> exprs;
+		size_t count = GetExprCount();
+		exprs.reserve(count);
+		for (size_t i = 0; i < count; i++)
+			exprs.push_back(BNGetLowLevelILByIndex(m_object, i));
+		m_exprSnapshot = std::move(exprs);
+	}
+	return *m_exprSnapshot;
+}
+
+
 LowLevelILInstruction LowLevelILFunction::operator[](size_t i)
 {
 	return GetInstruction(i);
@@ -583,18 +601,21 @@ size_t LowLevelILFunction::GetExprCount() const
 
 void LowLevelILFunction::UpdateInstructionOperand(size_t i, size_t operandIndex, ExprId value)
 {
+	ReleaseExprSnapshot();
 	BNUpdateLowLevelILOperand(m_object, i, operandIndex, value);
 }
 
 
 void LowLevelILFunction::ReplaceExpr(size_t expr, size_t newExpr)
 {
+	ReleaseExprSnapshot();
 	BNReplaceLowLevelILExpr(m_object, expr, newExpr);
 }
 
 
 void LowLevelILFunction::SetExprAttributes(size_t expr, uint32_t attributes)
 {
+	ReleaseExprSnapshot();
 	BNSetLowLevelILExprAttributes(m_object, expr, attributes);
 }
 
@@ -613,12 +634,14 @@ BNLowLevelILLabel* LowLevelILFunction::GetLabelForAddress(Architecture* arch, ui
 
 void LowLevelILFunction::Finalize()
 {
+	ReleaseExprSnapshot();
 	BNFinalizeLowLevelILFunction(m_object);
 }
 
 
 void LowLevelILFunction::GenerateSSAForm()
 {
+	ReleaseExprSnapshot();
 	BNGenerateLowLevelILSSAForm(m_object);
 }
 
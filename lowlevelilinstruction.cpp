@@ -18,6 +18,7 @@
 // FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
 // IN THE SOFTWARE.
 
+#include <algorithm>
 #include <cstring>
 #ifdef BINARYNINJACORE_LIBRARY
 	#include "lowlevelilfunction.h"
@@ -36,274 +37,442 @@ using namespace std;
 #endif
 
 
-unordered_map<LowLevelILOperandUsage, LowLevelILOperandType> LowLevelILInstructionBase::operandTypeForUsage = {
-    {SourceExprLowLevelOperandUsage, ExprLowLevelOperand},
-    {SourceRegisterLowLevelOperandUsage, RegisterLowLevelOperand},
-    {SourceRegisterStackLowLevelOperandUsage, RegisterStackLowLevelOperand},
-    {SourceFlagLowLevelOperandUsage, FlagLowLevelOperand},
-    {SourceSSARegisterLowLevelOperandUsage, SSARegisterLowLevelOperand},
-    {SourceSSARegisterStackLowLevelOperandUsage, SSARegisterStackLowLevelOperand},
-    {SourceSSAFlagLowLevelOperandUsage, SSAFlagLowLevelOperand}, {DestExprLowLevelOperandUsage, ExprLowLevelOperand},
-    {DestRegisterLowLevelOperandUsage, RegisterLowLevelOperand},
-    {DestRegisterStackLowLevelOperandUsage, RegisterStackLowLevelOperand},
-    {DestFlagLowLevelOperandUsage, FlagLowLevelOperand},
-    {DestSSARegisterLowLevelOperandUsage, SSARegisterLowLevelOperand},
-    {DestSSARegisterStackLowLevelOperandUsage, SSARegisterStackLowLevelOperand},
-    {DestSSAFlagLowLevelOperandUsage, SSAFlagLowLevelOperand},
-    {SemanticFlagClassLowLevelOperandUsage, SemanticFlagClassLowLevelOperand},
-    {SemanticFlagGroupLowLevelOperandUsage, SemanticFlagGroupLowLevelOperand},
-    {PartialRegisterLowLevelOperandUsage, RegisterLowLevelOperand},
-    {PartialSSARegisterStackSourceLowLevelOperandUsage, SSARegisterStackLowLevelOperand},
-    {StackSSARegisterLowLevelOperandUsage, SSARegisterLowLevelOperand},
-    {StackMemoryVersionLowLevelOperandUsage, IndexLowLevelOperand},
-    {TopSSARegisterLowLevelOperandUsage, SSARegisterLowLevelOperand},
-    {LeftExprLowLevelOperandUsage, ExprLowLevelOperand}, {RightExprLowLevelOperandUsage, ExprLowLevelOperand},
-    {CarryExprLowLevelOperandUsage, ExprLowLevelOperand}, {ConditionExprLowLevelOperandUsage, ExprLowLevelOperand},
-    {HighRegisterLowLevelOperandUsage, RegisterLowLevelOperand},
-    {HighSSARegisterLowLevelOperandUsage, SSARegisterLowLevelOperand},
-    {LowRegisterLowLevelOperandUsage, RegisterLowLevelOperand},
-    {LowSSARegisterLowLevelOperandUsage, SSARegisterLowLevelOperand},
-    {IntrinsicLowLevelOperandUsage, IntrinsicLowLevelOperand}, {ConstantLowLevelOperandUsage, IntegerLowLevelOperand},
-    {VectorLowLevelOperandUsage, IntegerLowLevelOperand}, {StackAdjustmentLowLevelOperandUsage, IntegerLowLevelOperand},
-    {TargetLowLevelOperandUsage, IndexLowLevelOperand}, {TrueTargetLowLevelOperandUsage, IndexLowLevelOperand},
-    {FalseTargetLowLevelOperandUsage, IndexLowLevelOperand}, {BitIndexLowLevelOperandUsage, IndexLowLevelOperand},
-    {SourceMemoryVersionLowLevelOperandUsage, IndexLowLevelOperand},
-    {DestMemoryVersionLowLevelOperandUsage, IndexLowLevelOperand},
-    {FlagConditionLowLevelOperandUsage, FlagConditionLowLevelOperand},
-    {OutputSSARegistersLowLevelOperandUsage, SSARegisterListLowLevelOperand},
-    {OutputMemoryVersionLowLevelOperandUsage, IndexLowLevelOperand},
-    {ParameterExprsLowLevelOperandUsage, ExprListLowLevelOperand},
-    {SourceSSARegistersLowLevelOperandUsage, SSARegisterListLowLevelOperand},
-    {SourceSSARegisterStacksLowLevelOperandUsage, SSARegisterStackListLowLevelOperand},
-    {SourceSSAFlagsLowLevelOperandUsage, SSAFlagListLowLevelOperand},
-    {OutputRegisterOrFlagListLowLevelOperandUsage, RegisterOrFlagListLowLevelOperand},
-    {OutputSSARegisterOrFlagListLowLevelOperandUsage, SSARegisterOrFlagListLowLevelOperand},
-    {OutputMemoryIntrinsicLowLevelOperandUsage, SSARegisterOrFlagListLowLevelOperand},
-    {SourceMemoryVersionsLowLevelOperandUsage, IndexListLowLevelOperand},
-    {TargetsLowLevelOperandUsage, IndexMapLowLevelOperand},
-    {RegisterStackAdjustmentsLowLevelOperandUsage, RegisterStackAdjustmentsLowLevelOperand}};
-
-
-unordered_map<BNLowLevelILOperation, vector<LowLevelILOperandUsage>> LowLevelILInstructionBase::operationOperandUsage =
-    {{LLIL_NOP, {}}, {LLIL_POP, {}}, {LLIL_NORET, {}}, {LLIL_SYSCALL, {}}, {LLIL_BP, {}}, {LLIL_UNDEF, {}},
-        {LLIL_UNIMPL, {}}, {LLIL_SET_REG, {DestRegisterLowLevelOperandUsage, SourceExprLowLevelOperandUsage}},
-        {LLIL_SET_REG_SPLIT,
-            {HighRegisterLowLevelOperandUsage, LowRegisterLowLevelOperandUsage, SourceExprLowLevelOperandUsage}},
-        {LLIL_SET_REG_SSA, {DestSSARegisterLowLevelOperandUsage, SourceExprLowLevelOperandUsage}},
-        {LLIL_SET_REG_SSA_PARTIAL,
-            {DestSSARegisterLowLevelOperandUsage, PartialRegisterLowLevelOperandUsage, SourceExprLowLevelOperandUsage}},
-        {LLIL_SET_REG_SPLIT_SSA,
-            {HighSSARegisterLowLevelOperandUsage, LowSSARegisterLowLevelOperandUsage, SourceExprLowLevelOperandUsage}},
-        {LLIL_SET_REG_STACK_REL,
-            {DestRegisterStackLowLevelOperandUsage, DestExprLowLevelOperandUsage, SourceExprLowLevelOperandUsage}},
-        {LLIL_REG_STACK_PUSH, {DestRegisterStackLowLevelOperandUsage, SourceExprLowLevelOperandUsage}},
-        {LLIL_SET_REG_STACK_REL_SSA,
-            {DestSSARegisterStackLowLevelOperandUsage, PartialSSARegisterStackSourceLowLevelOperandUsage,
-                DestExprLowLevelOperandUsage, TopSSARegisterLowLevelOperandUsage, SourceExprLowLevelOperandUsage}},
-        {LLIL_SET_REG_STACK_ABS_SSA,
-            {DestSSARegisterStackLowLevelOperandUsage, PartialSSARegisterStackSourceLowLevelOperandUsage,
-                DestRegisterLowLevelOperandUsage, SourceExprLowLevelOperandUsage}},
-        {LLIL_SET_FLAG, {DestFlagLowLevelOperandUsage, SourceExprLowLevelOperandUsage}},
-        {LLIL_SET_FLAG_SSA, {DestSSAFlagLowLevelOperandUsage, SourceExprLowLevelOperandUsage}},
-        {LLIL_LOAD, {SourceExprLowLevelOperandUsage}},
-        {LLIL_LOAD_SSA, {SourceExprLowLevelOperandUsage, SourceMemoryVersionLowLevelOperandUsage}},
-        {LLIL_STORE, {DestExprLowLevelOperandUsage, SourceExprLowLevelOperandUsage}},
-        {LLIL_STORE_SSA, {DestExprLowLevelOperandUsage, DestMemoryVersionLowLevelOperandUsage,
-                             SourceMemoryVersionLowLevelOperandUsage, SourceExprLowLevelOperandUsage}},
-        {LLIL_REG, {SourceRegisterLowLevelOperandUsage}}, {LLIL_REG_SSA, {SourceSSARegisterLowLevelOperandUsage}},
-        {LLIL_REG_SSA_PARTIAL, {SourceSSARegisterLowLevelOperandUsage, PartialRegisterLowLevelOperandUsage}},
-        {LLIL_REG_SPLIT, {HighRegisterLowLevelOperandUsage, LowRegisterLowLevelOperandUsage}},
-        {LLIL_REG_SPLIT_SSA, {HighSSARegisterLowLevelOperandUsage, LowSSARegisterLowLevelOperandUsage}},
-        {LLIL_REG_STACK_REL, {SourceRegisterStackLowLevelOperandUsage, SourceExprLowLevelOperandUsage}},
-        {LLIL_REG_STACK_POP, {SourceRegisterStackLowLevelOperandUsage}},
-        {LLIL_REG_STACK_FREE_REG, {DestRegisterLowLevelOperandUsage}},
-        {LLIL_REG_STACK_FREE_REL, {DestRegisterStackLowLevelOperandUsage, DestExprLowLevelOperandUsage}},
-        {LLIL_REG_STACK_REL_SSA, {SourceSSARegisterStackLowLevelOperandUsage, TopSSARegisterLowLevelOperandUsage,
-                                     SourceExprLowLevelOperandUsage}},
-        {LLIL_REG_STACK_ABS_SSA, {SourceSSARegisterStackLowLevelOperandUsage, SourceRegisterLowLevelOperandUsage}},
-        {LLIL_REG_STACK_FREE_REL_SSA,
-            {DestSSARegisterStackLowLevelOperandUsage, PartialSSARegisterStackSourceLowLevelOperandUsage,
-                DestExprLowLevelOperandUsage, TopSSARegisterLowLevelOperandUsage}},
-        {LLIL_REG_STACK_FREE_ABS_SSA,
-            {DestSSARegisterStackLowLevelOperandUsage, PartialSSARegisterStackSourceLowLevelOperandUsage,
-                DestRegisterLowLevelOperandUsage}},
-        {LLIL_FLAG, {SourceFlagLowLevelOperandUsage}},
-        {LLIL_FLAG_BIT, {SourceFlagLowLevelOperandUsage, BitIndexLowLevelOperandUsage}},
-        {LLIL_FLAG_SSA, {SourceSSAFlagLowLevelOperandUsage}},
-        {LLIL_FLAG_BIT_SSA, {SourceSSAFlagLowLevelOperandUsage, BitIndexLowLevelOperandUsage}},
-        {LLIL_JUMP, {DestExprLowLevelOperandUsage}},
-        {LLIL_JUMP_TO, {DestExprLowLevelOperandUsage, TargetsLowLevelOperandUsage}},
-        {LLIL_CALL, {DestExprLowLevelOperandUsage}},
-        {LLIL_CALL_STACK_ADJUST, {DestExprLowLevelOperandUsage, StackAdjustmentLowLevelOperandUsage,
-                                     RegisterStackAdjustmentsLowLevelOperandUsage}},
-        {LLIL_TAILCALL, {DestExprLowLevelOperandUsage}}, {LLIL_RET, {DestExprLowLevelOperandUsage}},
-        {LLIL_IF, {ConditionExprLowLevelOperandUsage, TrueTargetLowLevelOperandUsage, FalseTargetLowLevelOperandUsage}},
-        {LLIL_GOTO, {TargetLowLevelOperandUsage}},
-        {LLIL_FLAG_COND, {FlagConditionLowLevelOperandUsage, SemanticFlagClassLowLevelOperandUsage}},
-        {LLIL_FLAG_GROUP, {SemanticFlagGroupLowLevelOperandUsage}}, {LLIL_TRAP, {VectorLowLevelOperandUsage}},
-        {LLIL_CALL_SSA, {OutputSSARegistersLowLevelOperandUsage, OutputMemoryVersionLowLevelOperandUsage,
-                            DestExprLowLevelOperandUsage, StackSSARegisterLowLevelOperandUsage,
-                            StackMemoryVersionLowLevelOperandUsage, ParameterExprsLowLevelOperandUsage}},
-        {LLIL_SYSCALL_SSA, {OutputSSARegistersLowLevelOperandUsage, OutputMemoryVersionLowLevelOperandUsage,
-                               StackSSARegisterLowLevelOperandUsage, StackMemoryVersionLowLevelOperandUsage,
-                               ParameterExprsLowLevelOperandUsage}},
-        {LLIL_TAILCALL_SSA, {OutputSSARegistersLowLevelOperandUsage, OutputMemoryVersionLowLevelOperandUsage,
-                                DestExprLowLevelOperandUsage, StackSSARegisterLowLevelOperandUsage,
-                                StackMemoryVersionLowLevelOperandUsage, ParameterExprsLowLevelOperandUsage}},
-		{LLIL_SEPARATE_PARAM_LIST_SSA, {ParameterExprsLowLevelOperandUsage}},
-		{LLIL_SHARED_PARAM_SLOT_SSA, {ParameterExprsLowLevelOperandUsage}},
-        {LLIL_REG_PHI, {DestSSARegisterLowLevelOperandUsage, SourceSSARegistersLowLevelOperandUsage}},
-        {LLIL_REG_STACK_PHI, {DestSSARegisterStackLowLevelOperandUsage, SourceSSARegisterStacksLowLevelOperandUsage}},
-        {LLIL_FLAG_PHI, {DestSSAFlagLowLevelOperandUsage, SourceSSAFlagsLowLevelOperandUsage}},
-        {LLIL_MEM_PHI, {DestMemoryVersionLowLevelOperandUsage, SourceMemoryVersionsLowLevelOperandUsage}},
-        {LLIL_CONST, {ConstantLowLevelOperandUsage}}, {LLIL_CONST_PTR, {ConstantLowLevelOperandUsage}},
-        {LLIL_EXTERN_PTR, {ConstantLowLevelOperandUsage, OffsetLowLevelOperandUsage}},
-        {LLIL_FLOAT_CONST, {ConstantLowLevelOperandUsage}},
-        {LLIL_ADD, {LeftExprLowLevelOperandUsage, RightExprLowLevelOperandUsage}},
-        {LLIL_SUB, {LeftExprLowLevelOperandUsage, RightExprLowLevelOperandUsage}},
-        {LLIL_AND, {LeftExprLowLevelOperandUsage, RightExprLowLevelOperandUsage}},
-        {LLIL_OR, {LeftExprLowLevelOperandUsage, RightExprLowLevelOperandUsage}},
-        {LLIL_XOR, {LeftExprLowLevelOperandUsage, RightExprLowLevelOperandUsage}},
-        {LLIL_LSL, {LeftExprLowLevelOperandUsage, RightExprLowLevelOperandUsage}},
-        {LLIL_LSR, {LeftExprLowLevelOperandUsage, RightExprLowLevelOperandUsage}},
-        {LLIL_ASR, {LeftExprLowLevelOperandUsage, RightExprLowLevelOperandUsage}},
-        {LLIL_ROL, {LeftExprLowLevelOperandUsage, RightExprLowLevelOperandUsage}},
-        {LLIL_ROR, {LeftExprLowLevelOperandUsage, RightExprLowLevelOperandUsage}},
-        {LLIL_MUL, {LeftExprLowLevelOperandUsage, RightExprLowLevelOperandUsage}},
-        {LLIL_MULU_DP, {LeftExprLowLevelOperandUsage, RightExprLowLevelOperandUsage}},
-        {LLIL_MULS_DP, {LeftExprLowLevelOperandUsage, RightExprLowLevelOperandUsage}},
-        {LLIL_DIVU, {LeftExprLowLevelOperandUsage, RightExprLowLevelOperandUsage}},
-        {LLIL_DIVS, {LeftExprLowLevelOperandUsage, RightExprLowLevelOperandUsage}},
-        {LLIL_MODU, {LeftExprLowLevelOperandUsage, RightExprLowLevelOperandUsage}},
-        {LLIL_MODS, {LeftExprLowLevelOperandUsage, RightExprLowLevelOperandUsage}},
-        {LLIL_CMP_E, {LeftExprLowLevelOperandUsage, RightExprLowLevelOperandUsage}},
-        {LLIL_CMP_NE, {LeftExprLowLevelOperandUsage, RightExprLowLevelOperandUsage}},
-        {LLIL_CMP_SLT, {LeftExprLowLevelOperandUsage, RightExprLowLevelOperandUsage}},
-        {LLIL_CMP_ULT, {LeftExprLowLevelOperandUsage, RightExprLowLevelOperandUsage}},
-        {LLIL_CMP_SLE, {LeftExprLowLevelOperandUsage, RightExprLowLevelOperandUsage}},
-        {LLIL_CMP_ULE, {LeftExprLowLevelOperandUsage, RightExprLowLevelOperandUsage}},
-        {LLIL_CMP_SGE, {LeftExprLowLevelOperandUsage, RightExprLowLevelOperandUsage}},
-        {LLIL_CMP_UGE, {LeftExprLowLevelOperandUsage, RightExprLowLevelOperandUsage}},
-        {LLIL_CMP_SGT, {LeftExprLowLevelOperandUsage, RightExprLowLevelOperandUsage}},
-        {LLIL_CMP_UGT, {LeftExprLowLevelOperandUsage, RightExprLowLevelOperandUsage}},
-        {LLIL_TEST_BIT, {LeftExprLowLevelOperandUsage, RightExprLowLevelOperandUsage}},
-        {LLIL_ADD_OVERFLOW, {LeftExprLowLevelOperandUsage, RightExprLowLevelOperandUsage}},
-        {LLIL_ADC, {LeftExprLowLevelOperandUsage, RightExprLowLevelOperandUsage, CarryExprLowLevelOperandUsage}},
-        {LLIL_SBB, {LeftExprLowLevelOperandUsage, RightExprLowLevelOperandUsage, CarryExprLowLevelOperandUsage}},
-        {LLIL_RLC, {LeftExprLowLevelOperandUsage, RightExprLowLevelOperandUsage, CarryExprLowLevelOperandUsage}},
-        {LLIL_RRC, {LeftExprLowLevelOperandUsage, RightExprLowLevelOperandUsage, CarryExprLowLevelOperandUsage}},
-        {LLIL_DIVU_DP, {LeftExprLowLevelOperandUsage, RightExprLowLevelOperandUsage}},
-        {LLIL_DIVS_DP, {LeftExprLowLevelOperandUsage, RightExprLowLevelOperandUsage}},
-        {LLIL_MODU_DP, {LeftExprLowLevelOperandUsage, RightExprLowLevelOperandUsage}},
-        {LLIL_MODS_DP, {LeftExprLowLevelOperandUsage, RightExprLowLevelOperandUsage}},
-        {LLIL_PUSH, {SourceExprLowLevelOperandUsage}}, {LLIL_NEG, {SourceExprLowLevelOperandUsage}},
-        {LLIL_NOT, {SourceExprLowLevelOperandUsage}}, {LLIL_SX, {SourceExprLowLevelOperandUsage}},
-        {LLIL_ZX, {SourceExprLowLevelOperandUsage}}, {LLIL_LOW_PART, {SourceExprLowLevelOperandUsage}},
-        {LLIL_BOOL_TO_INT, {SourceExprLowLevelOperandUsage}},
-        {LLIL_INTRINSIC, {OutputRegisterOrFlagListLowLevelOperandUsage, IntrinsicLowLevelOperandUsage,
-                             ParameterExprsLowLevelOperandUsage}},
-        {LLIL_INTRINSIC_SSA, {OutputSSARegisterOrFlagListLowLevelOperandUsage, IntrinsicLowLevelOperandUsage,
-                                 ParameterExprsLowLevelOperandUsage}},
-        {LLIL_MEMORY_INTRINSIC_SSA, {OutputMemoryIntrinsicLowLevelOperandUsage, OutputMemoryVersionLowLevelOperandUsage, IntrinsicLowLevelOperandUsage,
-                                 ParameterExprsLowLevelOperandUsage, SourceMemoryVersionLowLevelOperandUsage}},
-        {LLIL_UNIMPL_MEM, {SourceExprLowLevelOperandUsage}},
-        {LLIL_FADD, {LeftExprLowLevelOperandUsage, RightExprLowLevelOperandUsage}},
-        {LLIL_FSUB, {LeftExprLowLevelOperandUsage, RightExprLowLevelOperandUsage}},
-        {LLIL_FMUL, {LeftExprLowLevelOperandUsage, RightExprLowLevelOperandUsage}},
-        {LLIL_FDIV, {LeftExprLowLevelOperandUsage, RightExprLowLevelOperandUsage}},
-        {LLIL_FSQRT, {SourceExprLowLevelOperandUsage}}, {LLIL_FNEG, {SourceExprLowLevelOperandUsage}},
-        {LLIL_FABS, {SourceExprLowLevelOperandUsage}}, {LLIL_FLOAT_TO_INT, {SourceExprLowLevelOperandUsage}},
-        {LLIL_INT_TO_FLOAT, {SourceExprLowLevelOperandUsage}}, {LLIL_FLOAT_CONV, {SourceExprLowLevelOperandUsage}},
-        {LLIL_ROUND_TO_INT, {SourceExprLowLevelOperandUsage}}, {LLIL_FLOOR, {SourceExprLowLevelOperandUsage}},
-        {LLIL_CEIL, {SourceExprLowLevelOperandUsage}}, {LLIL_FTRUNC, {SourceExprLowLevelOperandUsage}},
-        {LLIL_FCMP_E, {LeftExprLowLevelOperandUsage, RightExprLowLevelOperandUsage}},
-        {LLIL_FCMP_NE, {LeftExprLowLevelOperandUsage, RightExprLowLevelOperandUsage}},
-        {LLIL_FCMP_LT, {LeftExprLowLevelOperandUsage, RightExprLowLevelOperandUsage}},
-        {LLIL_FCMP_LE, {LeftExprLowLevelOperandUsage, RightExprLowLevelOperandUsage}},
-        {LLIL_FCMP_GE, {LeftExprLowLevelOperandUsage, RightExprLowLevelOperandUsage}},
-        {LLIL_FCMP_GT, {LeftExprLowLevelOperandUsage, RightExprLowLevelOperandUsage}},
-        {LLIL_FCMP_O, {LeftExprLowLevelOperandUsage, RightExprLowLevelOperandUsage}},
-        {LLIL_FCMP_UO, {LeftExprLowLevelOperandUsage, RightExprLowLevelOperandUsage}}};
-
-
-static unordered_map<BNLowLevelILOperation, unordered_map<LowLevelILOperandUsage, size_t>>
-    GetOperandIndexForOperandUsages()
-{
-	unordered_map<BNLowLevelILOperation, unordered_map<LowLevelILOperandUsage, size_t>> result;
-	result.reserve(LowLevelILInstructionBase::operationOperandUsage.size());
-	for (auto& operation : LowLevelILInstructionBase::operationOperandUsage)
+template <typename... Usages>
+static constexpr LowLevelILOperationOperands OperandUsages(Usages... usages)
+{
+	return LowLevelILOperationOperands {true, sizeof...(usages), {usages...}, {}};
+}
+
+
+// Operand usages of each operation, in operand order. This is the single source of truth for operand layout; the
+// lookup tables below are generated from it at compile time.
+static constexpr LowLevelILOperationOperands OperandUsagesForOperation(BNLowLevelILOperation operation)
+{
+	switch (operation)
 	{
-		result[operation.first] = unordered_map<LowLevelILOperandUsage, size_t>();
+	case LLIL_NOP:
+	case LLIL_POP:
+	case LLIL_NORET:
+	case LLIL_SYSCALL:
+	case LLIL_BP:
+	case LLIL_UNDEF:
+	case LLIL_UNIMPL:
+		return OperandUsages();
+	case LLIL_SET_REG:
+		return OperandUsages(DestRegisterLowLevelOperandUsage, SourceExprLowLevelOperandUsage);
+	case LLIL_SET_REG_SPLIT:
+		return OperandUsages(
+		    HighRegisterLowLevelOperandUsage, LowRegisterLowLevelOperandUsage, SourceExprLowLevelOperandUsage);
+	case LLIL_SET_REG_SSA:
+		return OperandUsages(DestSSARegisterLowLevelOperandUsage, SourceExprLowLevelOperandUsage);
+	case LLIL_SET_REG_SSA_PARTIAL:
+		return OperandUsages(
+		    DestSSARegisterLowLevelOperandUsage, PartialRegisterLowLevelOperandUsage, SourceExprLowLevelOperandUsage);
+	case LLIL_SET_REG_SPLIT_SSA:
+		return OperandUsages(
+		    HighSSARegisterLowLevelOperandUsage, LowSSARegisterLowLevelOperandUsage, SourceExprLowLevelOperandUsage);
+	case LLIL_SET_REG_STACK_REL:
+		return OperandUsages(
+		    DestRegisterStackLowLevelOperandUsage, DestExprLowLevelOperandUsage, SourceExprLowLevelOperandUsage);
+	case LLIL_REG_STACK_PUSH:
+		return OperandUsages(DestRegisterStackLowLevelOperandUsage, SourceExprLowLevelOperandUsage);
+	case LLIL_SET_REG_STACK_REL_SSA:
+		return OperandUsages(
+		    DestSSARegisterStackLowLevelOperandUsage, PartialSSARegisterStackSourceLowLevelOperandUsage,
+		    DestExprLowLevelOperandUsage, TopSSARegisterLowLevelOperandUsage, SourceExprLowLevelOperandUsage);
+	case LLIL_SET_REG_STACK_ABS_SSA:
+		return OperandUsages(
+		    DestSSARegisterStackLowLevelOperandUsage, PartialSSARegisterStackSourceLowLevelOperandUsage,
+		    DestRegisterLowLevelOperandUsage, SourceExprLowLevelOperandUsage);
+	case LLIL_SET_FLAG:
+		return OperandUsages(DestFlagLowLevelOperandUsage, SourceExprLowLevelOperandUsage);
+	case LLIL_SET_FLAG_SSA:
+		return OperandUsages(DestSSAFlagLowLevelOperandUsage, SourceExprLowLevelOperandUsage);
+	case LLIL_LOAD:
+	case LLIL_PUSH:
+	case LLIL_NEG:
+	case LLIL_NOT:
+	case LLIL_SX:
+	case LLIL_ZX:
+	case LLIL_LOW_PART:
+	case LLIL_BOOL_TO_INT:
+	case LLIL_UNIMPL_MEM:
+	case LLIL_FSQRT:
+	case LLIL_FNEG:
+	case LLIL_FABS:
+	case LLIL_FLOAT_TO_INT:
+	case LLIL_INT_TO_FLOAT:
+	case LLIL_FLOAT_CONV:
+	case LLIL_ROUND_TO_INT:
+	case LLIL_FLOOR:
+	case LLIL_CEIL:
+	case LLIL_FTRUNC:
+		return OperandUsages(SourceExprLowLevelOperandUsage);
+	case LLIL_LOAD_SSA:
+		return OperandUsages(SourceExprLowLevelOperandUsage, SourceMemoryVersionLowLevelOperandUsage);
+	case LLIL_STORE:
+		return OperandUsages(DestExprLowLevelOperandUsage, SourceExprLowLevelOperandUsage);
+	case LLIL_STORE_SSA:
+		return OperandUsages(
+		    DestExprLowLevelOperandUsage, DestMemoryVersionLowLevelOperandUsage,
+		    SourceMemoryVersionLowLevelOperandUsage, SourceExprLowLevelOperandUsage);
+	case LLIL_REG:
+		return OperandUsages(SourceRegisterLowLevelOperandUsage);
+	case LLIL_REG_SSA:
+		return OperandUsages(SourceSSARegisterLowLevelOperandUsage);
+	case LLIL_REG_SSA_PARTIAL:
+		return OperandUsages(SourceSSARegisterLowLevelOperandUsage, PartialRegisterLowLevelOperandUsage);
+	case LLIL_REG_SPLIT:
+		return OperandUsages(HighRegisterLowLevelOperandUsage, LowRegisterLowLevelOperandUsage);
+	case LLIL_REG_SPLIT_SSA:
+		return OperandUsages(HighSSARegisterLowLevelOperandUsage, LowSSARegisterLowLevelOperandUsage);
+	case LLIL_REG_STACK_REL:
+		return OperandUsages(SourceRegisterStackLowLevelOperandUsage, SourceExprLowLevelOperandUsage);
+	case LLIL_REG_STACK_POP:
+		return OperandUsages(SourceRegisterStackLowLevelOperandUsage);
+	case LLIL_REG_STACK_FREE_REG:
+		return OperandUsages(DestRegisterLowLevelOperandUsage);
+	case LLIL_REG_STACK_FREE_REL:
+		return OperandUsages(DestRegisterStackLowLevelOperandUsage, DestExprLowLevelOperandUsage);
+	case LLIL_REG_STACK_REL_SSA:
+		return OperandUsages(
+		    SourceSSARegisterStackLowLevelOperandUsage, TopSSARegisterLowLevelOperandUsage,
+		    SourceExprLowLevelOperandUsage);
+	case LLIL_REG_STACK_ABS_SSA:
+		return OperandUsages(SourceSSARegisterStackLowLevelOperandUsage, SourceRegisterLowLevelOperandUsage);
+	case LLIL_REG_STACK_FREE_REL_SSA:
+		return OperandUsages(
+		    DestSSARegisterStackLowLevelOperandUsage, PartialSSARegisterStackSourceLowLevelOperandUsage,
+		    DestExprLowLevelOperandUsage, TopSSARegisterLowLevelOperandUsage);
+	case LLIL_REG_STACK_FREE_ABS_SSA:
+		return OperandUsages(
+		    DestSSARegisterStackLowLevelOperandUsage, PartialSSARegisterStackSourceLowLevelOperandUsage,
+		    DestRegisterLowLevelOperandUsage);
+	case LLIL_FLAG:
+		return OperandUsages(SourceFlagLowLevelOperandUsage);
+	case LLIL_FLAG_BIT:
+		return OperandUsages(SourceFlagLowLevelOperandUsage, BitIndexLowLevelOperandUsage);
+	case LLIL_FLAG_SSA:
+		return OperandUsages(SourceSSAFlagLowLevelOperandUsage);
+	case LLIL_FLAG_BIT_SSA:
+		return OperandUsages(SourceSSAFlagLowLevelOperandUsage, BitIndexLowLevelOperandUsage);
+	case LLIL_JUMP:
+	case LLIL_CALL:
+	case LLIL_TAILCALL:
+	case LLIL_RET:
+		return OperandUsages(DestExprLowLevelOperandUsage);
+	case LLIL_JUMP_TO:
+		return OperandUsages(DestExprLowLevelOperandUsage, TargetsLowLevelOperandUsage);
+	case LLIL_CALL_STACK_ADJUST:
+		return OperandUsages(
+		    DestExprLowLevelOperandUsage, StackAdjustmentLowLevelOperandUsage,
+		    RegisterStackAdjustmentsLowLevelOperandUsage);
+	case LLIL_IF:
+		return OperandUsages(
+		    ConditionExprLowLevelOperandUsage, TrueTargetLowLevelOperandUsage, FalseTargetLowLevelOperandUsage);
+	case LLIL_GOTO:
+		return OperandUsages(TargetLowLevelOperandUsage);
+	case LLIL_FLAG_COND:
+		return OperandUsages(FlagConditionLowLevelOperandUsage, SemanticFlagClassLowLevelOperandUsage);
+	case LLIL_FLAG_GROUP:
+		return OperandUsages(SemanticFlagGroupLowLevelOperandUsage);
+	case LLIL_TRAP:
+		return OperandUsages(VectorLowLevelOperandUsage);
+	case LLIL_CALL_SSA:
+	case LLIL_TAILCALL_SSA:
+		return OperandUsages(
+		    OutputSSARegistersLowLevelOperandUsage, OutputMemoryVersionLowLevelOperandUsage,
+		    DestExprLowLevelOperandUsage, StackSSARegisterLowLevelOperandUsage, StackMemoryVersionLowLevelOperandUsage,
+		    ParameterExprsLowLevelOperandUsage);
+	case LLIL_SYSCALL_SSA:
+		return OperandUsages(
+		    OutputSSARegistersLowLevelOperandUsage, OutputMemoryVersionLowLevelOperandUsage,
+		    StackSSARegisterLowLevelOperandUsage, StackMemoryVersionLowLevelOperandUsage,
+		    ParameterExprsLowLevelOperandUsage);
+	case LLIL_SEPARATE_PARAM_LIST_SSA:
+	case LLIL_SHARED_PARAM_SLOT_SSA:
+		return OperandUsages(ParameterExprsLowLevelOperandUsage);
+	case LLIL_REG_PHI:
+		return OperandUsages(DestSSARegisterLowLevelOperandUsage, SourceSSARegistersLowLevelOperandUsage);
+	case LLIL_REG_STACK_PHI:
+		return OperandUsages(DestSSARegisterStackLowLevelOperandUsage, SourceSSARegisterStacksLowLevelOperandUsage);
+	case LLIL_FLAG_PHI:
+		return OperandUsages(DestSSAFlagLowLevelOperandUsage, SourceSSAFlagsLowLevelOperandUsage);
+	case LLIL_MEM_PHI:
+		return OperandUsages(DestMemoryVersionLowLevelOperandUsage, SourceMemoryVersionsLowLevelOperandUsage);
+	case LLIL_CONST:
+	case LLIL_CONST_PTR:
+	case LLIL_FLOAT_CONST:
+		return OperandUsages(ConstantLowLevelOperandUsage);
+	case LLIL_EXTERN_PTR:
+		return OperandUsages(ConstantLowLevelOperandUsage, OffsetLowLevelOperandUsage);
+	case LLIL_ADD:
+	case LLIL_SUB:
+	case LLIL_AND:
+	case LLIL_OR:
+	case LLIL_XOR:
+	case LLIL_LSL:
+	case LLIL_LSR:
+	case LLIL_ASR:
+	case LLIL_ROL:
+	case LLIL_ROR:
+	case LLIL_MUL:
+	case LLIL_MULU_DP:
+	case LLIL_MULS_DP:
+	case LLIL_DIVU:
+	case LLIL_DIVS:
+	case LLIL_MODU:
+	case LLIL_MODS:
+	case LLIL_CMP_E:
+	case LLIL_CMP_NE:
+	case LLIL_CMP_SLT:
+	case LLIL_CMP_ULT:
+	case LLIL_CMP_SLE:
+	case LLIL_CMP_ULE:
+	case LLIL_CMP_SGE:
+	case LLIL_CMP_UGE:
+	case LLIL_CMP_SGT:
+	case LLIL_CMP_UGT:
+	case LLIL_TEST_BIT:
+	case LLIL_ADD_OVERFLOW:
+	case LLIL_DIVU_DP:
+	case LLIL_DIVS_DP:
+	case LLIL_MODU_DP:
+	case LLIL_MODS_DP:
+	case LLIL_FADD:
+	case LLIL_FSUB:
+	case LLIL_FMUL:
+	case LLIL_FDIV:
+	case LLIL_FCMP_E:
+	case LLIL_FCMP_NE:
+	case LLIL_FCMP_LT:
+	case LLIL_FCMP_LE:
+	case LLIL_FCMP_GE:
+	case LLIL_FCMP_GT:
+	case LLIL_FCMP_O:
+	case LLIL_FCMP_UO:
+		return OperandUsages(LeftExprLowLevelOperandUsage, RightExprLowLevelOperandUsage);
+	case LLIL_ADC:
+	case LLIL_SBB:
+	case LLIL_RLC:
+	case LLIL_RRC:
+		return OperandUsages(
+		    LeftExprLowLevelOperandUsage, RightExprLowLevelOperandUsage, CarryExprLowLevelOperandUsage);
+	case LLIL_INTRINSIC:
+		return OperandUsages(
+		    OutputRegisterOrFlagListLowLevelOperandUsage, IntrinsicLowLevelOperandUsage,
+		    ParameterExprsLowLevelOperandUsage);
+	case LLIL_INTRINSIC_SSA:
+		return OperandUsages(
+		    OutputSSARegisterOrFlagListLowLevelOperandUsage, IntrinsicLowLevelOperandUsage,
+		    ParameterExprsLowLevelOperandUsage);
+	case LLIL_MEMORY_INTRINSIC_SSA:
+		return OperandUsages(
+		    OutputMemoryIntrinsicLowLevelOperandUsage, OutputMemoryVersionLowLevelOperandUsage,
+		    IntrinsicLowLevelOperandUsage, ParameterExprsLowLevelOperandUsage, SourceMemoryVersionLowLevelOperandUsage);
+	default:
+		return LowLevelILOperationOperands {};
+	}
+}
+
+
+static constexpr LowLevelILOperandType OperandTypeForUsage(LowLevelILOperandUsage usage)
+{
+	switch (usage)
+	{
+	case SourceExprLowLevelOperandUsage:
+	case DestExprLowLevelOperandUsage:
+	case LeftExprLowLevelOperandUsage:
+	case RightExprLowLevelOperandUsage:
+	case CarryExprLowLevelOperandUsage:
+	case ConditionExprLowLevelOperandUsage:
+		return ExprLowLevelOperand;
+	case SourceRegisterLowLevelOperandUsage:
+	case DestRegisterLowLevelOperandUsage:
+	case PartialRegisterLowLevelOperandUsage:
+	case HighRegisterLowLevelOperandUsage:
+	case LowRegisterLowLevelOperandUsage:
+		return RegisterLowLevelOperand;
+	case SourceRegisterStackLowLevelOperandUsage:
+	case DestRegisterStackLowLevelOperandUsage:
+		return RegisterStackLowLevelOperand;
+	case SourceFlagLowLevelOperandUsage:
+	case DestFlagLowLevelOperandUsage:
+		return FlagLowLevelOperand;
+	case SourceSSARegisterLowLevelOperandUsage:
+	case DestSSARegisterLowLevelOperandUsage:
+	case StackSSARegisterLowLevelOperandUsage:
+	case TopSSARegisterLowLevelOperandUsage:
+	case HighSSARegisterLowLevelOperandUsage:
+	case LowSSARegisterLowLevelOperandUsage:
+		return SSARegisterLowLevelOperand;
+	case SourceSSARegisterStackLowLevelOperandUsage:
+	case DestSSARegisterStackLowLevelOperandUsage:
+	case PartialSSARegisterStackSourceLowLevelOperandUsage:
+		return SSARegisterStackLowLevelOperand;
+	case SourceSSAFlagLowLevelOperandUsage:
+	case DestSSAFlagLowLevelOperandUsage:
+		return SSAFlagLowLevelOperand;
+	case SemanticFlagClassLowLevelOperandUsage:
+		return SemanticFlagClassLowLevelOperand;
+	case SemanticFlagGroupLowLevelOperandUsage:
+		return SemanticFlagGroupLowLevelOperand;
+	case StackMemoryVersionLowLevelOperandUsage:
+	case TargetLowLevelOperandUsage:
+	case TrueTargetLowLevelOperandUsage:
+	case FalseTargetLowLevelOperandUsage:
+	case BitIndexLowLevelOperandUsage:
+	case SourceMemoryVersionLowLevelOperandUsage:
+	case DestMemoryVersionLowLevelOperandUsage:
+	case OutputMemoryVersionLowLevelOperandUsage:
+		return IndexLowLevelOperand;
+	case IntrinsicLowLevelOperandUsage:
+		return IntrinsicLowLevelOperand;
+	case ConstantLowLevelOperandUsage:
+	case VectorLowLevelOperandUsage:
+	case StackAdjustmentLowLevelOperandUsage:
+	case OffsetLowLevelOperandUsage:
+		return IntegerLowLevelOperand;
+	case FlagConditionLowLevelOperandUsage:
+		return FlagConditionLowLevelOperand;
+	case OutputSSARegistersLowLevelOperandUsage:
+	case SourceSSARegistersLowLevelOperandUsage:
+		return SSARegisterListLowLevelOperand;
+	case ParameterExprsLowLevelOperandUsage:
+		return ExprListLowLevelOperand;
+	case SourceSSARegisterStacksLowLevelOperandUsage:
+		return SSARegisterStackListLowLevelOperand;
+	case SourceSSAFlagsLowLevelOperandUsage:
+		return SSAFlagListLowLevelOperand;
+	case OutputRegisterOrFlagListLowLevelOperandUsage:
+		return RegisterOrFlagListLowLevelOperand;
+	case OutputSSARegisterOrFlagListLowLevelOperandUsage:
+	case OutputMemoryIntrinsicLowLevelOperandUsage:
+		return SSARegisterOrFlagListLowLevelOperand;
+	case SourceMemoryVersionsLowLevelOperandUsage:
+		return IndexListLowLevelOperand;
+	case TargetsLowLevelOperandUsage:
+		return IndexMapLowLevelOperand;
+	case RegisterStackAdjustmentsLowLevelOperandUsage:
+		return RegisterStackAdjustmentsLowLevelOperand;
+	}
+	throw LowLevelILInstructionAccessException();
+}
+
 
-		size_t operand = 0;
-		result[operation.first].reserve(operation.second.size());
-		for (auto usage : operation.second)
+static constexpr LowLevelILOperationOperands ComputeOperationOperands(BNLowLevelILOperation operation)
+{
+	LowLevelILOperationOperands result = OperandUsagesForOperation(operation);
+	size_t operand = 0;
+	for (size_t i = 0; i < result.count; i++)
+	{
+		LowLevelILOperandUsage usage = result.usages[i];
+		result.operandIndices[i] = (uint8_t)operand;
+		switch (usage)
 		{
-			result[operation.first][usage] = operand;
-			switch (usage)
+		case HighSSARegisterLowLevelOperandUsage:
+		case LowSSARegisterLowLevelOperandUsage:
+		case PartialSSARegisterStackSourceLowLevelOperandUsage:
+		case TopSSARegisterLowLevelOperandUsage:
+			// Represented as subexpression, so only takes one slot even though it is an SSA register
+			operand++;
+			break;
+		case ParameterExprsLowLevelOperandUsage:
+			if (operand == 0)
 			{
-			case HighSSARegisterLowLevelOperandUsage:
-			case LowSSARegisterLowLevelOperandUsage:
-			case PartialSSARegisterStackSourceLowLevelOperandUsage:
-			case TopSSARegisterLowLevelOperandUsage:
-				// Represented as subexpression, so only takes one slot even though it is an SSA register
+				// Represented as a counted list
+				operand += 2;
+			}
+			else
+			{
+				// Represented as subexpression, so only takes one slot even though it is a list
 				operand++;
-				break;
-			case ParameterExprsLowLevelOperandUsage:
-				if (operand == 0)
-				{
-					// Represented as a counted list
-					operand += 2;
-				}
-				else
-				{
-					// Represented as subexpression, so only takes one slot even though it is a list
-					operand++;
-				}
-				break;
-			case OutputSSARegistersLowLevelOperandUsage:
-				// OutputMemoryVersionLowLevelOperandUsage follows at same operand
-				break;
-			case StackSSARegisterLowLevelOperandUsage:
-				// StackMemoryVersionLowLevelOperandUsage follows at same operand
-				break;
-			case DestSSARegisterStackLowLevelOperandUsage:
-				// PartialSSARegisterStackSourceLowLevelOperandUsage follows at same operand
-				break;
-			case OutputMemoryIntrinsicLowLevelOperandUsage:
-				// OutputMemoryVersionLowLevelOperandUsage follows at same operand
+			}
+			break;
+		case OutputSSARegistersLowLevelOperandUsage:
+			// OutputMemoryVersionLowLevelOperandUsage follows at same operand
+			break;
+		case StackSSARegisterLowLevelOperandUsage:
+			// StackMemoryVersionLowLevelOperandUsage follows at same operand
+			break;
+		case DestSSARegisterStackLowLevelOperandUsage:
+			// PartialSSARegisterStackSourceLowLevelOperandUsage follows at same operand
+			break;
+		case OutputMemoryIntrinsicLowLevelOperandUsage:
+			// OutputMemoryVersionLowLevelOperandUsage follows at same operand
+			break;
+		default:
+			switch (OperandTypeForUsage(usage))
+			{
+			case SSARegisterLowLevelOperand:
+			case SSARegisterStackLowLevelOperand:
+			case SSAFlagLowLevelOperand:
+			case IndexListLowLevelOperand:
+			case IndexMapLowLevelOperand:
+			case SSARegisterListLowLevelOperand:
+			case SSARegisterStackListLowLevelOperand:
+			case SSAFlagListLowLevelOperand:
+			case RegisterStackAdjustmentsLowLevelOperand:
+			case RegisterOrFlagListLowLevelOperand:
+			case SSARegisterOrFlagListLowLevelOperand:
+				// SSA registers/flags and lists take two operand slots
+				operand += 2;
 				break;
 			default:
-				switch (LowLevelILInstructionBase::operandTypeForUsage[usage])
-				{
-				case SSARegisterLowLevelOperand:
-				case SSARegisterStackLowLevelOperand:
-				case SSAFlagLowLevelOperand:
-				case IndexListLowLevelOperand:
-				case IndexMapLowLevelOperand:
-				case SSARegisterListLowLevelOperand:
-				case SSARegisterStackListLowLevelOperand:
-				case SSAFlagListLowLevelOperand:
-				case RegisterStackAdjustmentsLowLevelOperand:
-				case RegisterOrFlagListLowLevelOperand:
-				case SSARegisterOrFlagListLowLevelOperand:
-					// SSA registers/flags and lists take two operand slots
-					operand += 2;
-					break;
-				default:
-					operand++;
-					break;
-				}
+				operand++;
 				break;
 			}
+			break;
 		}
 	}
 	return result;
 }
 
 
-unordered_map<BNLowLevelILOperation, unordered_map<LowLevelILOperandUsage, size_t>>
-    LowLevelILInstructionBase::operationOperandIndex = GetOperandIndexForOperandUsages();
+namespace
+{
+	constexpr size_t LowLevelILOperationCount = LLIL_MEM_PHI + 1;
+	constexpr size_t LowLevelILOperandUsageCount = OffsetLowLevelOperandUsage + 1;
+	constexpr uint8_t InvalidOperandIndex = 0xff;
+
+	struct LowLevelILOperandTables
+	{
+		LowLevelILOperationOperands operations[LowLevelILOperationCount];
+		uint8_t operandIndex[LowLevelILOperationCount][LowLevelILOperandUsageCount];
+	};
+}  // namespace
+
+
+static constexpr LowLevelILOperandTables BuildOperandTables()
+{
+	LowLevelILOperandTables result {};
+	for (size_t i = 0; i < LowLevelILOperationCount; i++)
+	{
+		result.operations[i] = ComputeOperationOperands((BNLowLevelILOperation)i);
+		for (size_t j = 0; j < LowLevelILOperandUsageCount; j++)
+			result.operandIndex[i][j] = InvalidOperandIndex;
+		for (size_t j = 0; j < result.operations[i].count; j++)
+			result.operandIndex[i][result.operations[i].usages[j]] = result.operations[i].operandIndices[j];
+	}
+	return result;
+}
+
+
+static constexpr LowLevelILOperandTables s_operandTables = BuildOperandTables();
+
+
+LowLevelILOperandType LowLevelILInstructionBase::GetOperandTypeForUsage(LowLevelILOperandUsage usage)
+{
+	return OperandTypeForUsage(usage);
+}
+
+
+const LowLevelILOperationOperands* LowLevelILInstructionBase::GetOperationOperands(BNLowLevelILOperation operation)
+{
+	if ((size_t)operation >= LowLevelILOperationCount || !s_operandTables.operations[operation].valid)
+		return nullptr;
+	return &s_operandTables.operations[operation];
+}
 
 
 RegisterOrFlag::RegisterOrFlag() : isFlag(false), index(BN_INVALID_REGISTER) {}
@@ -1104,10 +1273,7 @@ LowLevelILOperand::LowLevelILOperand(
     m_instr(instr),
     m_usage(usage), m_operandIndex(operandIndex)
 {
-	auto i = LowLevelILInstructionBase::operandTypeForUsage.find(m_usage);
-	if (i == LowLevelILInstructionBase::operandTypeForUsage.end())
-		throw LowLevelILInstructionAccessException();
-	m_type = i->second;
+	m_type = LowLevelILInstructionBase::GetOperandTypeForUsage(m_usage);
 }
 
 
@@ -1302,19 +1468,14 @@ map<uint32_t, int32_t> LowLevelILOperand::GetRegisterStackAdjustments() const
 
 const LowLevelILOperand LowLevelILOperandList::ListIterator::operator*()
 {
-	LowLevelILOperandUsage usage = *pos;
-	auto i = owner->m_operandIndexMap.find(usage);
-	if (i == owner->m_operandIndexMap.end())
-		throw LowLevelILInstructionAccessException();
-	return LowLevelILOperand(owner->m_instr, usage, i->second);
+	return LowLevelILOperand(owner->m_instr, owner->m_operands.usages[pos], owner->m_operands.operandIndices[pos]);
 }
 
 
-LowLevelILOperandList::LowLevelILOperandList(const LowLevelILInstruction& instr,
-    const vector<LowLevelILOperandUsage>& usageList,
-    const unordered_map<LowLevelILOperandUsage, size_t>& operandIndexMap) :
+LowLevelILOperandList::LowLevelILOperandList(
+    const LowLevelILInstruction& instr, const LowLevelILOperationOperands& operands) :
     m_instr(instr),
-    m_usageList(usageList), m_operandIndexMap(operandIndexMap)
+    m_operands(operands)
 {}
 
 
@@ -1322,7 +1483,7 @@ LowLevelILOperandList::const_iterator LowLevelILOperandList::begin() const
 {
 	const_iterator result;
 	result.owner = this;
-	result.pos = m_usageList.begin();
+	result.pos = 0;
 	return result;
 }
 
@@ -1331,24 +1492,22 @@ LowLevelILOperandList::const_iterator LowLevelILOperandList::end() const
 {
 	const_iterator result;
 	result.owner = this;
-	result.pos = m_usageList.end();
+	result.pos = m_operands.count;
 	return result;
 }
 
 
 size_t LowLevelILOperandList::size() const
 {
-	return m_usageList.size();
+	return m_operands.count;
 }
 
 
 const LowLevelILOperand LowLevelILOperandList::operator[](size_t i) const
 {
-	LowLevelILOperandUsage usage = m_usageList[i];
-	auto indexMap = m_operandIndexMap.find(usage);
-	if (indexMap == m_operandIndexMap.end())
+	if (i >= m_operands.count)
 		throw LowLevelILInstructionAccessException();
-	return LowLevelILOperand(m_instr, usage, indexMap->second);
+	return LowLevelILOperand(m_instr, m_operands.usages[i], m_operands.operandIndices[i]);
 }
 
 
@@ -1414,13 +1573,10 @@ LowLevelILInstruction::LowLevelILInstruction(const LowLevelILInstructionBase& in
 
 LowLevelILOperandList LowLevelILInstructionBase::GetOperands() const
 {
-	auto usage = operationOperandUsage.find(operation);
-	if (usage == operationOperandUsage.end())
-		throw LowLevelILInstructionAccessException();
-	auto operandIndex = operationOperandIndex.find(operation);
-	if (operandIndex == operationOperandIndex.end())
+	const LowLevelILOperationOperands* operands = GetOperationOperands(operation);
+	if (!operands)
 		throw LowLevelILInstructionAccessException();
-	return LowLevelILOperandList(*(const LowLevelILInstruction*)this, usage->second, operandIndex->second);
+	return LowLevelILOperandList(*(const LowLevelILInstruction*)this, *operands);
 }
 
 
@@ -1840,107 +1996,107 @@ void LowLevelILInstructionBase::ClearAttribute(BNILInstructionAttribute attribut
 }
 
 
-void LowLevelILInstruction::VisitExprs(const std::function<bool(const LowLevelILInstruction& expr)>& func) const
+void LowLevelILInstruction::CollectSubExprs(vector<LowLevelILInstruction>& toProcess) const
 {
-	if (!func(*this))
-		return;
+	// Sub-expressions are pushed in reverse so that the first operand is visited first
+	size_t start = toProcess.size();
 	switch (operation)
 	{
 	case LLIL_SET_REG:
-		GetSourceExpr<LLIL_SET_REG>().VisitExprs(func);
+		toProcess.push_back(GetSourceExpr<LLIL_SET_REG>());
 		break;
 	case LLIL_SET_REG_SPLIT:
-		GetSourceExpr<LLIL_SET_REG_SPLIT>().VisitExprs(func);
+		toProcess.push_back(GetSourceExpr<LLIL_SET_REG_SPLIT>());
 		break;
 	case LLIL_SET_REG_SSA:
-		GetSourceExpr<LLIL_SET_REG_SSA>().VisitExprs(func);
+		toProcess.push_back(GetSourceExpr<LLIL_SET_REG_SSA>());
 		break;
 	case LLIL_SET_REG_SSA_PARTIAL:
-		GetSourceExpr<LLIL_SET_REG_SSA_PARTIAL>().VisitExprs(func);
+		toProcess.push_back(GetSourceExpr<LLIL_SET_REG_SSA_PARTIAL>());
 		break;
 	case LLIL_SET_REG_SPLIT_SSA:
-		GetSourceExpr<LLIL_SET_REG_SPLIT_SSA>().VisitExprs(func);
+		toProcess.push_back(GetSourceExpr<LLIL_SET_REG_SPLIT_SSA>());
 		break;
 	case LLIL_SET_REG_STACK_REL:
-		GetDestExpr<LLIL_SET_REG_STACK_REL>().VisitExprs(func);
-		GetSourceExpr<LLIL_SET_REG_STACK_REL>().VisitExprs(func);
+		toProcess.push_back(GetDestExpr<LLIL_SET_REG_STACK_REL>());
+		toProcess.push_back(GetSourceExpr<LLIL_SET_REG_STACK_REL>());
 		break;
 	case LLIL_REG_STACK_PUSH:
-		GetSourceExpr<LLIL_REG_STACK_PUSH>().VisitExprs(func);
+		toProcess.push_back(GetSourceExpr<LLIL_REG_STACK_PUSH>());
 		break;
 	case LLIL_SET_REG_STACK_REL_SSA:
-		GetDestExpr<LLIL_SET_REG_STACK_REL_SSA>().VisitExprs(func);
-		GetSourceExpr<LLIL_SET_REG_STACK_REL_SSA>().VisitExprs(func);
+		toProcess.push_back(GetDestExpr<LLIL_SET_REG_STACK_REL_SSA>());
+		toProcess.push_back(GetSourceExpr<LLIL_SET_REG_STACK_REL_SSA>());
 		break;
 	case LLIL_SET_REG_STACK_ABS_SSA:
-		GetSourceExpr<LLIL_SET_REG_STACK_ABS_SSA>().VisitExprs(func);
+		toProcess.push_back(GetSourceExpr<LLIL_SET_REG_STACK_ABS_SSA>());
 		break;
 	case LLIL_SET_FLAG:
-		GetSourceExpr<LLIL_SET_FLAG>().VisitExprs(func);
+		toProcess.push_back(GetSourceExpr<LLIL_SET_FLAG>());
 		break;
 	case LLIL_SET_FLAG_SSA:
-		GetSourceExpr<LLIL_SET_FLAG_SSA>().VisitExprs(func);
+		toProcess.push_back(GetSourceExpr<LLIL_SET_FLAG_SSA>());
 		break;
 	case LLIL_REG_STACK_REL:
-		GetSourceExpr<LLIL_REG_STACK_REL>().VisitExprs(func);
+		toProcess.push_back(GetSourceExpr<LLIL_REG_STACK_REL>());
 		break;
 	case LLIL_REG_STACK_FREE_REL:
-		GetDestExpr<LLIL_REG_STACK_FREE_REL>().VisitExprs(func);
+		toProcess.push_back(GetDestExpr<LLIL_REG_STACK_FREE_REL>());
 		break;
 	case LLIL_REG_STACK_REL_SSA:
-		GetSourceExpr<LLIL_REG_STACK_REL_SSA>().VisitExprs(func);
+		toProcess.push_back(GetSourceExpr<LLIL_REG_STACK_REL_SSA>());
 		break;
 	case LLIL_REG_STACK_FREE_REL_SSA:
-		GetDestExpr<LLIL_REG_STACK_FREE_REL_SSA>().VisitExprs(func);
+		toProcess.push_back(GetDestExpr<LLIL_REG_STACK_FREE_REL_SSA>());
 		break;
 	case LLIL_LOAD:
-		GetSourceExpr<LLIL_LOAD>().VisitExprs(func);
+		toProcess.push_back(GetSourceExpr<LLIL_LOAD>());
 		break;
 	case LLIL_LOAD_SSA:
-		GetSourceExpr<LLIL_LOAD_SSA>().VisitExprs(func);
+		toProcess.push_back(GetSourceExpr<LLIL_LOAD_SSA>());
 		break;
 	case LLIL_STORE:
-		GetDestExpr<LLIL_STORE>().VisitExprs(func);
-		GetSourceExpr<LLIL_STORE>().VisitExprs(func);
+		toProcess.push_back(GetDestExpr<LLIL_STORE>());
+		toProcess.push_back(GetSourceExpr<LLIL_STORE>());
 		break;
 	case LLIL_STORE_SSA:
-		GetDestExpr<LLIL_STORE_SSA>().VisitExprs(func);
-		GetSourceExpr<LLIL_STORE_SSA>().VisitExprs(func);
+		toProcess.push_back(GetDestExpr<LLIL_STORE_SSA>());
+		toProcess.push_back(GetSourceExpr<LLIL_STORE_SSA>());
 		break;
 	case LLIL_JUMP:
-		GetDestExpr<LLIL_JUMP>().VisitExprs(func);
+		toProcess.push_back(GetDestExpr<LLIL_JUMP>());
 		break;
 	case LLIL_JUMP_TO:
-		GetDestExpr<LLIL_JUMP_TO>().VisitExprs(func);
+		toProcess.push_back(GetDestExpr<LLIL_JUMP_TO>());
 		break;
 	case LLIL_IF:
-		GetConditionExpr<LLIL_IF>().VisitExprs(func);
+		toProcess.push_back(GetConditionExpr<LLIL_IF>());
 		break;
 	case LLIL_CALL:
-		GetDestExpr<LLIL_CALL>().VisitExprs(func);
+		toProcess.push_back(GetDestExpr<LLIL_CALL>());
 		break;
 	case LLIL_CALL_STACK_ADJUST:
-		GetDestExpr<LLIL_CALL_STACK_ADJUST>().VisitExprs(func);
+		toProcess.push_back(GetDestExpr<LLIL_CALL_STACK_ADJUST>());
 		break;
 	case LLIL_TAILCALL:
-		GetDestExpr<LLIL_TAILCALL>().VisitExprs(func);
+		toProcess.push_back(GetDestExpr<LLIL_TAILCALL>());
 		break;
 	case LLIL_CALL_SSA:
-		GetDestExpr<LLIL_CALL_SSA>().VisitExprs(func);
+		toProcess.push_back(GetDestExpr<LLIL_CALL_SSA>());
 		for (auto i : GetParameterExprs<LLIL_CALL_SSA>())
-			i.VisitExprs(func);
+			toProcess.push_back(i);
 		break;
 	case LLIL_SYSCALL_SSA:
 		for (auto i : GetParameterExprs<LLIL_SYSCALL_SSA>())
-			i.VisitExprs(func);
+			toProcess.push_back(i);
 		break;
 	case LLIL_TAILCALL_SSA:
-		GetDestExpr<LLIL_TAILCALL_SSA>().VisitExprs(func);
+		toProcess.push_back(GetDestExpr<LLIL_TAILCALL_SSA>());
 		for (auto i : GetParameterExprs<LLIL_TAILCALL_SSA>())
-			i.VisitExprs(func);
+			toProcess.push_back(i);
 		break;
 	case LLIL_RET:
-		GetDestExpr<LLIL_RET>().VisitExprs(func);
+		toProcess.push_back(GetDestExpr<LLIL_RET>());
 		break;
 	case LLIL_PUSH:
 	case LLIL_NEG:
@@ -1960,7 +2116,7 @@ void LowLevelILInstruction::VisitExprs(const std::function<bool(const LowLevelIL
 	case LLIL_FLOOR:
 	case LLIL_CEIL:
 	case LLIL_FTRUNC:
-		AsOneOperand().GetSourceExpr().VisitExprs(func);
+		toProcess.push_back(AsOneOperand().GetSourceExpr());
 		break;
 	case LLIL_ADD:
 	case LLIL_SUB:
@@ -2007,40 +2163,47 @@ void LowLevelILInstruction::VisitExprs(const std::function<bool(const LowLevelIL
 	case LLIL_FCMP_GT:
 	case LLIL_FCMP_O:
 	case LLIL_FCMP_UO:
-		AsTwoOperand().GetLeftExpr().VisitExprs(func);
-		AsTwoOperand().GetRightExpr().VisitExprs(func);
+		toProcess.push_back(AsTwoOperand().GetLeftExpr());
+		toProcess.push_back(AsTwoOperand().GetRightExpr());
 		break;
 	case LLIL_ADC:
 	case LLIL_SBB:
 	case LLIL_RLC:
 	case LLIL_RRC:
-		AsTwoOperandWithCarry().GetLeftExpr().VisitExprs(func);
-		AsTwoOperandWithCarry().GetRightExpr().VisitExprs(func);
-		AsTwoOperandWithCarry().GetCarryExpr().VisitExprs(func);
+		toProcess.push_back(AsTwoOperandWithCarry().GetLeftExpr());
+		toProcess.push_back(AsTwoOperandWithCarry().GetRightExpr());
+		toProcess.push_back(AsTwoOperandWithCarry().GetCarryExpr());
 		break;
 	case LLIL_INTRINSIC:
 		for (auto i : GetParameterExprs<LLIL_INTRINSIC>())
-			i.VisitExprs(func);
+			toProcess.push_back(i);
 		break;
 	case LLIL_INTRINSIC_SSA:
 		for (auto i : GetParameterExprs<LLIL_INTRINSIC_SSA>())
-			i.VisitExprs(func);
+			toProcess.push_back(i);
 		break;
 	case LLIL_MEMORY_INTRINSIC_SSA:
 		for (auto i : GetParameterExprs<LLIL_MEMORY_INTRINSIC_SSA>())
-			i.VisitExprs(func);
+			toProcess.push_back(i);
 		break;
 	case LLIL_SEPARATE_PARAM_LIST_SSA:
 		for (auto i : GetParameterExprs<LLIL_SEPARATE_PARAM_LIST_SSA>())
-			i.VisitExprs(func);
+			toProcess.push_back(i);
 		break;
 	case LLIL_SHARED_PARAM_SLOT_SSA:
 		for (auto i : GetParameterExprs<LLIL_SHARED_PARAM_SLOT_SSA>())
-			i.VisitExprs(func);
+			toProcess.push_back(i);
 		break;
 	default:
 		break;
 	}
+	reverse(toProcess.begin() + start, toProcess.end());
+}
+
+
+void LowLevelILInstruction::VisitExprs(const std::function<bool(const LowLevelILInstruction& expr)>& func) const
+{
+	VisitExprs<const std::function<bool(const LowLevelILInstruction& expr)>&>(func);
 }
 
 
@@ -2353,13 +2516,12 @@ ExprId LowLevelILInstruction::CopyTo(
 
 bool LowLevelILInstruction::GetOperandIndexForUsage(LowLevelILOperandUsage usage, size_t& operandIndex) const
 {
-	auto operationIter = LowLevelILInstructionBase::operationOperandIndex.find(operation);
-	if (operationIter == LowLevelILInstructionBase::operationOperandIndex.end())
+	if ((size_t)operation >= LowLevelILOperationCount)
 		return false;
-	auto usageIter = operationIter->second.find(usage);
-	if (usageIter == operationIter->second.end())
+	uint8_t index = s_operandTables.operandIndex[operation][usage];
+	if (index == InvalidOperandIndex)
 		return false;
-	operandIndex = usageIter->second;
+	operandIndex = index;
 	return true;
 }
 
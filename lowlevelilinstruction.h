@@ -246,6 +246,21 @@ namespace BinaryNinja
 		RegisterStackAdjustmentsLowLevelOperandUsage,
 		OffsetLowLevelOperandUsage
 	};
+
+	/*!
+		Operand layout of an operation: the usage of each operand, in order, and the raw operand slot it starts at.
+
+		\ingroup lowlevelil
+	*/
+	struct LowLevelILOperationOperands
+	{
+		static constexpr size_t MaxUsages = 6;
+
+		bool valid;
+		uint8_t count;
+		LowLevelILOperandUsage usages[MaxUsages];
+		uint8_t operandIndices[MaxUsages];
+	};
 }  // namespace BinaryNinjaCore
 
 namespace std {
@@ -693,10 +708,8 @@ namespace BinaryNinja
 #endif
 		size_t exprIndex, instructionIndex;
 
-		static _STD_UNORDERED_MAP<LowLevelILOperandUsage, LowLevelILOperandType> operandTypeForUsage;
-		static _STD_UNORDERED_MAP<BNLowLevelILOperation, _STD_VECTOR<LowLevelILOperandUsage>> operationOperandUsage;
-		static _STD_UNORDERED_MAP<BNLowLevelILOperation, _STD_UNORDERED_MAP<LowLevelILOperandUsage, size_t>>
-		    operationOperandIndex;
+		static LowLevelILOperandType GetOperandTypeForUsage(LowLevelILOperandUsage usage);
+		static const LowLevelILOperationOperands* GetOperationOperands(BNLowLevelILOperation operation);
 
 		LowLevelILOperandList GetOperands() const;
 
@@ -813,8 +826,30 @@ namespace BinaryNinja
 		    LowLevelILFunction* func, const BNLowLevelILInstruction& instr, size_t expr, size_t instrIdx);
 		LowLevelILInstruction(const LowLevelILInstructionBase& instr);
 
+		void CollectSubExprs(_STD_VECTOR<LowLevelILInstruction>& toProcess) const;
 		void VisitExprs(const std::function<bool(const LowLevelILInstruction& expr)>& func) const;
 
+		/*! Visit this expression and all of its sub-expressions in pre-order. Returning false from the callback
+			skips the sub-expressions of the current expression. The callback is inlined and the traversal uses an
+			explicit stack, so deeply nested expressions do not grow the call stack.
+
+			\param func Callback taking a const LowLevelILInstruction& and returning whether to visit its sub-expressions
+		*/
+		template <typename T>
+		void VisitExprs(T&& func) const
+		{
+			_STD_VECTOR<LowLevelILInstruction> toProcess;
+			toProcess.push_back(*this);
+			while (!toProcess.empty())
+			{
+				LowLevelILInstruction cur = std::move(toProcess.back());
+				toProcess.pop_back();
+				if (!func(cur))
+					continue;
+				cur.CollectSubExprs(toProcess);
+			}
+		}
+
 		ExprId CopyTo(LowLevelILFunction* dest) const;
 		ExprId CopyTo(LowLevelILFunction* dest,
 		    const std::function<ExprId(const LowLevelILInstruction& subExpr)>& subExprHandler) const;
@@ -1220,7 +1255,7 @@ namespace BinaryNinja
 		struct ListIterator
 		{
 			const LowLevelILOperandList* owner;
-			_STD_VECTOR<LowLevelILOperandUsage>::const_iterator pos;
+			size_t pos;
 			bool operator==(const ListIterator& a) const { return pos == a.pos; }
 			bool operator!=(const ListIterator& a) const { return pos != a.pos; }
 			bool operator<(const ListIterator& a) const { return pos < a.pos; }
@@ -1233,14 +1268,12 @@ namespace BinaryNinja
 		};
 
 		LowLevelILInstruction m_instr;
-		const _STD_VECTOR<LowLevelILOperandUsage>& m_usageList;
-		const _STD_UNORDERED_MAP<LowLevelILOperandUsage, size_t>& m_operandIndexMap;
+		const LowLevelILOperationOperands& m_operands;
 
 	  public:
 		typedef ListIterator const_iterator;
 
-		LowLevelILOperandList(const LowLevelILInstruction& instr, const _STD_VECTOR<LowLevelILOperandUsage>& usageList,
-		    const _STD_UNORDERED_MAP<LowLevelILOperandUsage, size_t>& operandIndexMap);
+		LowLevelILOperandList(const LowLevelILInstruction& instr, const LowLevelILOperationOperands& operands);
 
 		const_iterator begin() const;
 		const_iterator end() const;
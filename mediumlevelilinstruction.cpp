@@ -18,6 +18,7 @@
 // FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
 // IN THE SOFTWARE.
 
+#include <algorithm>
 #include <cstring>
 #ifdef BINARYNINJACORE_LIBRARY
 	#include "mediumlevelilfunction.h"
@@ -36,270 +37,399 @@ using namespace std;
 #endif
 
 
-unordered_map<MediumLevelILOperandUsage, MediumLevelILOperandType> MediumLevelILInstructionBase::operandTypeForUsage = {
-    {SourceExprMediumLevelOperandUsage, ExprMediumLevelOperand},
-    {SourceVariableMediumLevelOperandUsage, VariableMediumLevelOperand},
-    {SourceSSAVariableMediumLevelOperandUsage, SSAVariableMediumLevelOperand},
-    {PartialSSAVariableSourceMediumLevelOperandUsage, SSAVariableMediumLevelOperand},
-    {DestExprMediumLevelOperandUsage, ExprMediumLevelOperand},
-    {DestVariableMediumLevelOperandUsage, VariableMediumLevelOperand},
-    {DestSSAVariableMediumLevelOperandUsage, SSAVariableMediumLevelOperand},
-    {LeftExprMediumLevelOperandUsage, ExprMediumLevelOperand},
-    {RightExprMediumLevelOperandUsage, ExprMediumLevelOperand},
-    {CarryExprMediumLevelOperandUsage, ExprMediumLevelOperand},
-    {StackExprMediumLevelOperandUsage, ExprMediumLevelOperand},
-    {ConditionExprMediumLevelOperandUsage, ExprMediumLevelOperand},
-    {HighVariableMediumLevelOperandUsage, VariableMediumLevelOperand},
-    {LowVariableMediumLevelOperandUsage, VariableMediumLevelOperand},
-    {HighSSAVariableMediumLevelOperandUsage, VariableMediumLevelOperand},
-    {LowSSAVariableMediumLevelOperandUsage, VariableMediumLevelOperand},
-    {OffsetMediumLevelOperandUsage, IntegerMediumLevelOperand},
-    {ConstantMediumLevelOperandUsage, IntegerMediumLevelOperand},
-	 {ConstantDataMediumLevelOperandUsage, ConstantDataMediumLevelOperand},
-    {VectorMediumLevelOperandUsage, IntegerMediumLevelOperand},
-    {IntrinsicMediumLevelOperandUsage, IntrinsicMediumLevelOperand},
-    {TargetMediumLevelOperandUsage, IndexMediumLevelOperand},
-    {TrueTargetMediumLevelOperandUsage, IndexMediumLevelOperand},
-    {FalseTargetMediumLevelOperandUsage, IndexMediumLevelOperand},
-    {DestMemoryVersionMediumLevelOperandUsage, IndexMediumLevelOperand},
-    {SourceMemoryVersionMediumLevelOperandUsage, IndexMediumLevelOperand},
-    {TargetsMediumLevelOperandUsage, IndexMapMediumLevelOperand},
-    {SourceMemoryVersionsMediumLevelOperandUsage, IndexListMediumLevelOperand},
-    {OutputVariablesMediumLevelOperandUsage, VariableListMediumLevelOperand},
-    {OutputVariablesSubExprMediumLevelOperandUsage, VariableListMediumLevelOperand},
-    {OutputSSAVariablesMediumLevelOperandUsage, SSAVariableListMediumLevelOperand},
-    {OutputSSAVariablesSubExprMediumLevelOperandUsage, SSAVariableListMediumLevelOperand},
-    {OutputSSAMemoryVersionMediumLevelOperandUsage, IndexMediumLevelOperand},
-    {ParameterExprsMediumLevelOperandUsage, ExprListMediumLevelOperand},
-    {SourceExprsMediumLevelOperandUsage, ExprListMediumLevelOperand},
-    {UntypedParameterExprsMediumLevelOperandUsage, ExprListMediumLevelOperand},
-    {UntypedParameterSSAExprsMediumLevelOperandUsage, ExprListMediumLevelOperand},
-    {ParameterSSAMemoryVersionMediumLevelOperandUsage, IndexMediumLevelOperand},
-    {SourceSSAVariablesMediumLevelOperandUsages, SSAVariableListMediumLevelOperand}};
-
-
-unordered_map<BNMediumLevelILOperation, vector<MediumLevelILOperandUsage>>
-    MediumLevelILInstructionBase::operationOperandUsage = {{MLIL_NOP, {}}, {MLIL_NORET, {}}, {MLIL_BP, {}},
-        {MLIL_UNDEF, {}}, {MLIL_UNIMPL, {}},
-        {MLIL_SET_VAR, {DestVariableMediumLevelOperandUsage, SourceExprMediumLevelOperandUsage}},
-        {MLIL_SET_VAR_FIELD,
-            {DestVariableMediumLevelOperandUsage, OffsetMediumLevelOperandUsage, SourceExprMediumLevelOperandUsage}},
-        {MLIL_SET_VAR_SPLIT, {HighVariableMediumLevelOperandUsage, LowVariableMediumLevelOperandUsage,
-                                 SourceExprMediumLevelOperandUsage}},
-        {MLIL_SET_VAR_SSA, {DestSSAVariableMediumLevelOperandUsage, SourceExprMediumLevelOperandUsage}},
-        {MLIL_SET_VAR_SSA_FIELD,
-            {DestSSAVariableMediumLevelOperandUsage, PartialSSAVariableSourceMediumLevelOperandUsage,
-                OffsetMediumLevelOperandUsage, SourceExprMediumLevelOperandUsage}},
-        {MLIL_SET_VAR_SPLIT_SSA, {HighSSAVariableMediumLevelOperandUsage, LowSSAVariableMediumLevelOperandUsage,
-                                     SourceExprMediumLevelOperandUsage}},
-        {MLIL_SET_VAR_ALIASED, {DestSSAVariableMediumLevelOperandUsage, PartialSSAVariableSourceMediumLevelOperandUsage,
-                                   SourceExprMediumLevelOperandUsage}},
-        {MLIL_SET_VAR_ALIASED_FIELD,
-            {DestSSAVariableMediumLevelOperandUsage, PartialSSAVariableSourceMediumLevelOperandUsage,
-                OffsetMediumLevelOperandUsage, SourceExprMediumLevelOperandUsage}},
-        {MLIL_LOAD, {SourceExprMediumLevelOperandUsage}},
-        {MLIL_LOAD_STRUCT, {SourceExprMediumLevelOperandUsage, OffsetMediumLevelOperandUsage}},
-        {MLIL_LOAD_SSA, {SourceExprMediumLevelOperandUsage, SourceMemoryVersionMediumLevelOperandUsage}},
-        {MLIL_LOAD_STRUCT_SSA, {SourceExprMediumLevelOperandUsage, OffsetMediumLevelOperandUsage,
-                                   SourceMemoryVersionMediumLevelOperandUsage}},
-        {MLIL_STORE, {DestExprMediumLevelOperandUsage, SourceExprMediumLevelOperandUsage}},
-        {MLIL_STORE_STRUCT,
-            {DestExprMediumLevelOperandUsage, OffsetMediumLevelOperandUsage, SourceExprMediumLevelOperandUsage}},
-        {MLIL_STORE_SSA, {DestExprMediumLevelOperandUsage, DestMemoryVersionMediumLevelOperandUsage,
-                             SourceMemoryVersionMediumLevelOperandUsage, SourceExprMediumLevelOperandUsage}},
-        {MLIL_STORE_STRUCT_SSA,
-            {DestExprMediumLevelOperandUsage, OffsetMediumLevelOperandUsage, DestMemoryVersionMediumLevelOperandUsage,
-                SourceMemoryVersionMediumLevelOperandUsage, SourceExprMediumLevelOperandUsage}},
-        {MLIL_VAR, {SourceVariableMediumLevelOperandUsage}},
-        {MLIL_VAR_FIELD, {SourceVariableMediumLevelOperandUsage, OffsetMediumLevelOperandUsage}},
-        {MLIL_VAR_SPLIT, {HighVariableMediumLevelOperandUsage, LowVariableMediumLevelOperandUsage}},
-        {MLIL_VAR_SSA, {SourceSSAVariableMediumLevelOperandUsage}},
-        {MLIL_VAR_SSA_FIELD, {SourceSSAVariableMediumLevelOperandUsage, OffsetMediumLevelOperandUsage}},
-        {MLIL_VAR_ALIASED, {SourceSSAVariableMediumLevelOperandUsage}},
-        {MLIL_VAR_ALIASED_FIELD, {SourceSSAVariableMediumLevelOperandUsage, OffsetMediumLevelOperandUsage}},
-        {MLIL_VAR_SPLIT_SSA, {HighSSAVariableMediumLevelOperandUsage, LowSSAVariableMediumLevelOperandUsage}},
-        {MLIL_ADDRESS_OF, {SourceVariableMediumLevelOperandUsage}},
-        {MLIL_ADDRESS_OF_FIELD, {SourceVariableMediumLevelOperandUsage, OffsetMediumLevelOperandUsage}},
-        {MLIL_JUMP, {DestExprMediumLevelOperandUsage}},
-        {MLIL_JUMP_TO, {DestExprMediumLevelOperandUsage, TargetsMediumLevelOperandUsage}},
-        {MLIL_RET_HINT, {DestExprMediumLevelOperandUsage}},
-        {MLIL_CALL, {OutputVariablesMediumLevelOperandUsage, DestExprMediumLevelOperandUsage,
-                        ParameterExprsMediumLevelOperandUsage}},
-        {MLIL_CALL_UNTYPED, {OutputVariablesSubExprMediumLevelOperandUsage, DestExprMediumLevelOperandUsage,
-                                UntypedParameterExprsMediumLevelOperandUsage}},
-        {MLIL_SYSCALL, {OutputVariablesMediumLevelOperandUsage, ParameterExprsMediumLevelOperandUsage}},
-        {MLIL_SYSCALL_UNTYPED, {OutputVariablesSubExprMediumLevelOperandUsage,
-                                   UntypedParameterExprsMediumLevelOperandUsage, StackExprMediumLevelOperandUsage}},
-        {MLIL_TAILCALL, {OutputVariablesMediumLevelOperandUsage, DestExprMediumLevelOperandUsage,
-                            ParameterExprsMediumLevelOperandUsage}},
-        {MLIL_TAILCALL_UNTYPED, {OutputVariablesSubExprMediumLevelOperandUsage, DestExprMediumLevelOperandUsage,
-                                    UntypedParameterExprsMediumLevelOperandUsage}},
-        {MLIL_CALL_SSA, {OutputSSAVariablesSubExprMediumLevelOperandUsage,
-                            OutputSSAMemoryVersionMediumLevelOperandUsage, DestExprMediumLevelOperandUsage,
-                            ParameterExprsMediumLevelOperandUsage, SourceMemoryVersionMediumLevelOperandUsage}},
-        {MLIL_CALL_UNTYPED_SSA,
-            {OutputSSAVariablesSubExprMediumLevelOperandUsage, OutputSSAMemoryVersionMediumLevelOperandUsage,
-                DestExprMediumLevelOperandUsage, UntypedParameterSSAExprsMediumLevelOperandUsage,
-                ParameterSSAMemoryVersionMediumLevelOperandUsage, StackExprMediumLevelOperandUsage}},
-        {MLIL_SYSCALL_SSA,
-            {OutputSSAVariablesSubExprMediumLevelOperandUsage, OutputSSAMemoryVersionMediumLevelOperandUsage,
-                ParameterExprsMediumLevelOperandUsage, SourceMemoryVersionMediumLevelOperandUsage}},
-        {MLIL_SYSCALL_UNTYPED_SSA,
-            {OutputSSAVariablesSubExprMediumLevelOperandUsage, OutputSSAMemoryVersionMediumLevelOperandUsage,
-                UntypedParameterSSAExprsMediumLevelOperandUsage, ParameterSSAMemoryVersionMediumLevelOperandUsage,
-                StackExprMediumLevelOperandUsage}},
-        {MLIL_TAILCALL_SSA, {OutputSSAVariablesSubExprMediumLevelOperandUsage,
-                                OutputSSAMemoryVersionMediumLevelOperandUsage, DestExprMediumLevelOperandUsage,
-                                ParameterExprsMediumLevelOperandUsage, SourceMemoryVersionMediumLevelOperandUsage}},
-        {MLIL_TAILCALL_UNTYPED_SSA,
-            {OutputSSAVariablesSubExprMediumLevelOperandUsage, OutputSSAMemoryVersionMediumLevelOperandUsage,
-                DestExprMediumLevelOperandUsage, UntypedParameterSSAExprsMediumLevelOperandUsage,
-                ParameterSSAMemoryVersionMediumLevelOperandUsage, StackExprMediumLevelOperandUsage}},
-		{MLIL_SEPARATE_PARAM_LIST, {ParameterExprsMediumLevelOperandUsage}},
-		{MLIL_SHARED_PARAM_SLOT, {ParameterExprsMediumLevelOperandUsage}},
-        {MLIL_RET, {SourceExprsMediumLevelOperandUsage}},
-        {MLIL_IF, {ConditionExprMediumLevelOperandUsage, TrueTargetMediumLevelOperandUsage,
-                      FalseTargetMediumLevelOperandUsage}},
-        {MLIL_GOTO, {TargetMediumLevelOperandUsage}},
-        {MLIL_INTRINSIC, {OutputVariablesMediumLevelOperandUsage, IntrinsicMediumLevelOperandUsage,
-                             ParameterExprsMediumLevelOperandUsage}},
-        {MLIL_INTRINSIC_SSA, {OutputSSAVariablesMediumLevelOperandUsage, IntrinsicMediumLevelOperandUsage,
-                                 ParameterExprsMediumLevelOperandUsage}},
-        {MLIL_MEMORY_INTRINSIC_SSA, {OutputSSAVariablesSubExprMediumLevelOperandUsage, OutputSSAMemoryVersionMediumLevelOperandUsage, IntrinsicMediumLevelOperandUsage,
-													 ParameterExprsMediumLevelOperandUsage, SourceMemoryVersionMediumLevelOperandUsage}},
-        {MLIL_FREE_VAR_SLOT, {DestVariableMediumLevelOperandUsage}},
-        {MLIL_FREE_VAR_SLOT_SSA,
-            {DestSSAVariableMediumLevelOperandUsage, PartialSSAVariableSourceMediumLevelOperandUsage}},
-        {MLIL_TRAP, {VectorMediumLevelOperandUsage}},
-        {MLIL_VAR_PHI, {DestSSAVariableMediumLevelOperandUsage, SourceSSAVariablesMediumLevelOperandUsages}},
-        {MLIL_MEM_PHI, {DestMemoryVersionMediumLevelOperandUsage, SourceMemoryVersionsMediumLevelOperandUsage}},
-        {MLIL_CONST, {ConstantMediumLevelOperandUsage}},
-        {MLIL_CONST_PTR, {ConstantMediumLevelOperandUsage}},
-        {MLIL_EXTERN_PTR, {ConstantMediumLevelOperandUsage, OffsetMediumLevelOperandUsage}},
-        {MLIL_FLOAT_CONST, {ConstantMediumLevelOperandUsage}}, {MLIL_IMPORT, {ConstantMediumLevelOperandUsage}},
-        {MLIL_CONST_DATA, {ConstantDataMediumLevelOperandUsage}},
-        {MLIL_ADD, {LeftExprMediumLevelOperandUsage, RightExprMediumLevelOperandUsage}},
-        {MLIL_SUB, {LeftExprMediumLevelOperandUsage, RightExprMediumLevelOperandUsage}},
-        {MLIL_AND, {LeftExprMediumLevelOperandUsage, RightExprMediumLevelOperandUsage}},
-        {MLIL_OR, {LeftExprMediumLevelOperandUsage, RightExprMediumLevelOperandUsage}},
-        {MLIL_XOR, {LeftExprMediumLevelOperandUsage, RightExprMediumLevelOperandUsage}},
-        {MLIL_LSL, {LeftExprMediumLevelOperandUsage, RightExprMediumLevelOperandUsage}},
-        {MLIL_LSR, {LeftExprMediumLevelOperandUsage, RightExprMediumLevelOperandUsage}},
-        {MLIL_ASR, {LeftExprMediumLevelOperandUsage, RightExprMediumLevelOperandUsage}},
-        {MLIL_ROL, {LeftExprMediumLevelOperandUsage, RightExprMediumLevelOperandUsage}},
-        {MLIL_ROR, {LeftExprMediumLevelOperandUsage, RightExprMediumLevelOperandUsage}},
-        {MLIL_MUL, {LeftExprMediumLevelOperandUsage, RightExprMediumLevelOperandUsage}},
-        {MLIL_MULU_DP, {LeftExprMediumLevelOperandUsage, RightExprMediumLevelOperandUsage}},
-        {MLIL_MULS_DP, {LeftExprMediumLevelOperandUsage, RightExprMediumLevelOperandUsage}},
-        {MLIL_DIVU, {LeftExprMediumLevelOperandUsage, RightExprMediumLevelOperandUsage}},
-        {MLIL_DIVS, {LeftExprMediumLevelOperandUsage, RightExprMediumLevelOperandUsage}},
-        {MLIL_MODU, {LeftExprMediumLevelOperandUsage, RightExprMediumLevelOperandUsage}},
-        {MLIL_MODS, {LeftExprMediumLevelOperandUsage, RightExprMediumLevelOperandUsage}},
-        {MLIL_CMP_E, {LeftExprMediumLevelOperandUsage, RightExprMediumLevelOperandUsage}},
-        {MLIL_CMP_NE, {LeftExprMediumLevelOperandUsage, RightExprMediumLevelOperandUsage}},
-        {MLIL_CMP_SLT, {LeftExprMediumLevelOperandUsage, RightExprMediumLevelOperandUsage}},
-        {MLIL_CMP_ULT, {LeftExprMediumLevelOperandUsage, RightExprMediumLevelOperandUsage}},
-        {MLIL_CMP_SLE, {LeftExprMediumLevelOperandUsage, RightExprMediumLevelOperandUsage}},
-        {MLIL_CMP_ULE, {LeftExprMediumLevelOperandUsage, RightExprMediumLevelOperandUsage}},
-        {MLIL_CMP_SGE, {LeftExprMediumLevelOperandUsage, RightExprMediumLevelOperandUsage}},
-        {MLIL_CMP_UGE, {LeftExprMediumLevelOperandUsage, RightExprMediumLevelOperandUsage}},
-        {MLIL_CMP_SGT, {LeftExprMediumLevelOperandUsage, RightExprMediumLevelOperandUsage}},
-        {MLIL_CMP_UGT, {LeftExprMediumLevelOperandUsage, RightExprMediumLevelOperandUsage}},
-        {MLIL_TEST_BIT, {LeftExprMediumLevelOperandUsage, RightExprMediumLevelOperandUsage}},
-        {MLIL_ADD_OVERFLOW, {LeftExprMediumLevelOperandUsage, RightExprMediumLevelOperandUsage}},
-        {MLIL_ADC,
-            {LeftExprMediumLevelOperandUsage, RightExprMediumLevelOperandUsage, CarryExprMediumLevelOperandUsage}},
-        {MLIL_SBB,
-            {LeftExprMediumLevelOperandUsage, RightExprMediumLevelOperandUsage, CarryExprMediumLevelOperandUsage}},
-        {MLIL_RLC,
-            {LeftExprMediumLevelOperandUsage, RightExprMediumLevelOperandUsage, CarryExprMediumLevelOperandUsage}},
-        {MLIL_RRC,
-            {LeftExprMediumLevelOperandUsage, RightExprMediumLevelOperandUsage, CarryExprMediumLevelOperandUsage}},
-        {MLIL_DIVU_DP, {LeftExprMediumLevelOperandUsage, RightExprMediumLevelOperandUsage}},
-        {MLIL_DIVS_DP, {LeftExprMediumLevelOperandUsage, RightExprMediumLevelOperandUsage}},
-        {MLIL_MODU_DP, {LeftExprMediumLevelOperandUsage, RightExprMediumLevelOperandUsage}},
-        {MLIL_MODS_DP, {LeftExprMediumLevelOperandUsage, RightExprMediumLevelOperandUsage}},
-        {MLIL_NEG, {SourceExprMediumLevelOperandUsage}}, {MLIL_NOT, {SourceExprMediumLevelOperandUsage}},
-        {MLIL_SX, {SourceExprMediumLevelOperandUsage}}, {MLIL_ZX, {SourceExprMediumLevelOperandUsage}},
-        {MLIL_LOW_PART, {SourceExprMediumLevelOperandUsage}}, {MLIL_BOOL_TO_INT, {SourceExprMediumLevelOperandUsage}},
-        {MLIL_UNIMPL_MEM, {SourceExprMediumLevelOperandUsage}},
-        {MLIL_FADD, {LeftExprMediumLevelOperandUsage, RightExprMediumLevelOperandUsage}},
-        {MLIL_FSUB, {LeftExprMediumLevelOperandUsage, RightExprMediumLevelOperandUsage}},
-        {MLIL_FMUL, {LeftExprMediumLevelOperandUsage, RightExprMediumLevelOperandUsage}},
-        {MLIL_FDIV, {LeftExprMediumLevelOperandUsage, RightExprMediumLevelOperandUsage}},
-        {MLIL_FSQRT, {SourceExprMediumLevelOperandUsage}}, {MLIL_FNEG, {SourceExprMediumLevelOperandUsage}},
-        {MLIL_FABS, {SourceExprMediumLevelOperandUsage}}, {MLIL_FLOAT_TO_INT, {SourceExprMediumLevelOperandUsage}},
-        {MLIL_INT_TO_FLOAT, {SourceExprMediumLevelOperandUsage}},
-        {MLIL_FLOAT_CONV, {SourceExprMediumLevelOperandUsage}},
-        {MLIL_ROUND_TO_INT, {SourceExprMediumLevelOperandUsage}}, {MLIL_FLOOR, {SourceExprMediumLevelOperandUsage}},
-        {MLIL_CEIL, {SourceExprMediumLevelOperandUsage}}, {MLIL_FTRUNC, {SourceExprMediumLevelOperandUsage}},
-        {MLIL_FCMP_E, {LeftExprMediumLevelOperandUsage, RightExprMediumLevelOperandUsage}},
-        {MLIL_FCMP_NE, {LeftExprMediumLevelOperandUsage, RightExprMediumLevelOperandUsage}},
-        {MLIL_FCMP_LT, {LeftExprMediumLevelOperandUsage, RightExprMediumLevelOperandUsage}},
-        {MLIL_FCMP_LE, {LeftExprMediumLevelOperandUsage, RightExprMediumLevelOperandUsage}},
-        {MLIL_FCMP_GE, {LeftExprMediumLevelOperandUsage, RightExprMediumLevelOperandUsage}},
-        {MLIL_FCMP_GT, {LeftExprMediumLevelOperandUsage, RightExprMediumLevelOperandUsage}},
-        {MLIL_FCMP_O, {LeftExprMediumLevelOperandUsage, RightExprMediumLevelOperandUsage}},
-        {MLIL_FCMP_UO, {LeftExprMediumLevelOperandUsage, RightExprMediumLevelOperandUsage}}};
-
-
-static unordered_map<BNMediumLevelILOperation, unordered_map<MediumLevelILOperandUsage, size_t>>
-    GetOperandIndexForOperandUsages()
-{
-	unordered_map<BNMediumLevelILOperation, unordered_map<MediumLevelILOperandUsage, size_t>> result;
-	result.reserve(MediumLevelILInstructionBase::operationOperandUsage.size());
-	for (auto& operation : MediumLevelILInstructionBase::operationOperandUsage)
+template <typename... Usages>
+static constexpr MediumLevelILOperationOperands OperandUsages(Usages... usages)
+{
+	return MediumLevelILOperationOperands {true, sizeof...(usages), {usages...}, {}};
+}
+
+
+// Operand usages of each operation, in operand order. This is the single source of truth for operand layout; the
+// lookup tables below are generated from it at compile time.
+static constexpr MediumLevelILOperationOperands OperandUsagesForOperation(BNMediumLevelILOperation operation)
+{
+	switch (operation)
+	{
+	case MLIL_NOP:
+	case MLIL_NORET:
+	case MLIL_BP:
+	case MLIL_UNDEF:
+	case MLIL_UNIMPL:
+		return OperandUsages();
+	case MLIL_SET_VAR:
+		return OperandUsages(DestVariableMediumLevelOperandUsage, SourceExprMediumLevelOperandUsage);
+	case MLIL_SET_VAR_FIELD:
+		return OperandUsages(
+		    DestVariableMediumLevelOperandUsage, OffsetMediumLevelOperandUsage, SourceExprMediumLevelOperandUsage);
+	case MLIL_SET_VAR_SPLIT:
+		return OperandUsages(
+		    HighVariableMediumLevelOperandUsage, LowVariableMediumLevelOperandUsage, SourceExprMediumLevelOperandUsage);
+	case MLIL_SET_VAR_SSA:
+		return OperandUsages(DestSSAVariableMediumLevelOperandUsage, SourceExprMediumLevelOperandUsage);
+	case MLIL_SET_VAR_SSA_FIELD:
+	case MLIL_SET_VAR_ALIASED_FIELD:
+		return OperandUsages(
+		    DestSSAVariableMediumLevelOperandUsage, PartialSSAVariableSourceMediumLevelOperandUsage,
+		    OffsetMediumLevelOperandUsage, SourceExprMediumLevelOperandUsage);
+	case MLIL_SET_VAR_SPLIT_SSA:
+		return OperandUsages(
+		    HighSSAVariableMediumLevelOperandUsage, LowSSAVariableMediumLevelOperandUsage,
+		    SourceExprMediumLevelOperandUsage);
+	case MLIL_SET_VAR_ALIASED:
+		return OperandUsages(
+		    DestSSAVariableMediumLevelOperandUsage, PartialSSAVariableSourceMediumLevelOperandUsage,
+		    SourceExprMediumLevelOperandUsage);
+	case MLIL_LOAD:
+	case MLIL_NEG:
+	case MLIL_NOT:
+	case MLIL_SX:
+	case MLIL_ZX:
+	case MLIL_LOW_PART:
+	case MLIL_BOOL_TO_INT:
+	case MLIL_UNIMPL_MEM:
+	case MLIL_FSQRT:
+	case MLIL_FNEG:
+	case MLIL_FABS:
+	case MLIL_FLOAT_TO_INT:
+	case MLIL_INT_TO_FLOAT:
+	case MLIL_FLOAT_CONV:
+	case MLIL_ROUND_TO_INT:
+	case MLIL_FLOOR:
+	case MLIL_CEIL:
+	case MLIL_FTRUNC:
+		return OperandUsages(SourceExprMediumLevelOperandUsage);
+	case MLIL_LOAD_STRUCT:
+		return OperandUsages(SourceExprMediumLevelOperandUsage, OffsetMediumLevelOperandUsage);
+	case MLIL_LOAD_SSA:
+		return OperandUsages(SourceExprMediumLevelOperandUsage, SourceMemoryVersionMediumLevelOperandUsage);
+	case MLIL_LOAD_STRUCT_SSA:
+		return OperandUsages(
+		    SourceExprMediumLevelOperandUsage, OffsetMediumLevelOperandUsage,
+		    SourceMemoryVersionMediumLevelOperandUsage);
+	case MLIL_STORE:
+		return OperandUsages(DestExprMediumLevelOperandUsage, SourceExprMediumLevelOperandUsage);
+	case MLIL_STORE_STRUCT:
+		return OperandUsages(
+		    DestExprMediumLevelOperandUsage, OffsetMediumLevelOperandUsage, SourceExprMediumLevelOperandUsage);
+	case MLIL_STORE_SSA:
+		return OperandUsages(
+		    DestExprMediumLevelOperandUsage, DestMemoryVersionMediumLevelOperandUsage,
+		    SourceMemoryVersionMediumLevelOperandUsage, SourceExprMediumLevelOperandUsage);
+	case MLIL_STORE_STRUCT_SSA:
+		return OperandUsages(
+		    DestExprMediumLevelOperandUsage, OffsetMediumLevelOperandUsage, DestMemoryVersionMediumLevelOperandUsage,
+		    SourceMemoryVersionMediumLevelOperandUsage, SourceExprMediumLevelOperandUsage);
+	case MLIL_VAR:
+	case MLIL_ADDRESS_OF:
+		return OperandUsages(SourceVariableMediumLevelOperandUsage);
+	case MLIL_VAR_FIELD:
+	case MLIL_ADDRESS_OF_FIELD:
+		return OperandUsages(SourceVariableMediumLevelOperandUsage, OffsetMediumLevelOperandUsage);
+	case MLIL_VAR_SPLIT:
+		return OperandUsages(HighVariableMediumLevelOperandUsage, LowVariableMediumLevelOperandUsage);
+	case MLIL_VAR_SSA:
+	case MLIL_VAR_ALIASED:
+		return OperandUsages(SourceSSAVariableMediumLevelOperandUsage);
+	case MLIL_VAR_SSA_FIELD:
+	case MLIL_VAR_ALIASED_FIELD:
+		return OperandUsages(SourceSSAVariableMediumLevelOperandUsage, OffsetMediumLevelOperandUsage);
+	case MLIL_VAR_SPLIT_SSA:
+		return OperandUsages(HighSSAVariableMediumLevelOperandUsage, LowSSAVariableMediumLevelOperandUsage);
+	case MLIL_JUMP:
+	case MLIL_RET_HINT:
+		return OperandUsages(DestExprMediumLevelOperandUsage);
+	case MLIL_JUMP_TO:
+		return OperandUsages(DestExprMediumLevelOperandUsage, TargetsMediumLevelOperandUsage);
+	case MLIL_CALL:
+	case MLIL_TAILCALL:
+		return OperandUsages(
+		    OutputVariablesMediumLevelOperandUsage, DestExprMediumLevelOperandUsage,
+		    ParameterExprsMediumLevelOperandUsage);
+	case MLIL_CALL_UNTYPED:
+	case MLIL_TAILCALL_UNTYPED:
+		return OperandUsages(
+		    OutputVariablesSubExprMediumLevelOperandUsage, DestExprMediumLevelOperandUsage,
+		    UntypedParameterExprsMediumLevelOperandUsage);
+	case MLIL_SYSCALL:
+		return OperandUsages(OutputVariablesMediumLevelOperandUsage, ParameterExprsMediumLevelOperandUsage);
+	case MLIL_SYSCALL_UNTYPED:
+		return OperandUsages(
+		    OutputVariablesSubExprMediumLevelOperandUsage, UntypedParameterExprsMediumLevelOperandUsage,
+		    StackExprMediumLevelOperandUsage);
+	case MLIL_CALL_SSA:
+	case MLIL_TAILCALL_SSA:
+		return OperandUsages(
+		    OutputSSAVariablesSubExprMediumLevelOperandUsage, OutputSSAMemoryVersionMediumLevelOperandUsage,
+		    DestExprMediumLevelOperandUsage, ParameterExprsMediumLevelOperandUsage,
+		    SourceMemoryVersionMediumLevelOperandUsage);
+	case MLIL_CALL_UNTYPED_SSA:
+	case MLIL_TAILCALL_UNTYPED_SSA:
+		return OperandUsages(
+		    OutputSSAVariablesSubExprMediumLevelOperandUsage, OutputSSAMemoryVersionMediumLevelOperandUsage,
+		    DestExprMediumLevelOperandUsage, UntypedParameterSSAExprsMediumLevelOperandUsage,
+		    ParameterSSAMemoryVersionMediumLevelOperandUsage, StackExprMediumLevelOperandUsage);
+	case MLIL_SYSCALL_SSA:
+		return OperandUsages(
+		    OutputSSAVariablesSubExprMediumLevelOperandUsage, OutputSSAMemoryVersionMediumLevelOperandUsage,
+		    ParameterExprsMediumLevelOperandUsage, SourceMemoryVersionMediumLevelOperandUsage);
+	case MLIL_SYSCALL_UNTYPED_SSA:
+		return OperandUsages(
+		    OutputSSAVariablesSubExprMediumLevelOperandUsage, OutputSSAMemoryVersionMediumLevelOperandUsage,
+		    UntypedParameterSSAExprsMediumLevelOperandUsage, ParameterSSAMemoryVersionMediumLevelOperandUsage,
+		    StackExprMediumLevelOperandUsage);
+	case MLIL_SEPARATE_PARAM_LIST:
+	case MLIL_SHARED_PARAM_SLOT:
+		return OperandUsages(ParameterExprsMediumLevelOperandUsage);
+	case MLIL_RET:
+		return OperandUsages(SourceExprsMediumLevelOperandUsage);
+	case MLIL_IF:
+		return OperandUsages(
+		    ConditionExprMediumLevelOperandUsage, TrueTargetMediumLevelOperandUsage, FalseTargetMediumLevelOperandUsage);
+	case MLIL_GOTO:
+		return OperandUsages(TargetMediumLevelOperandUsage);
+	case MLIL_INTRINSIC:
+		return OperandUsages(
+		    OutputVariablesMediumLevelOperandUsage, IntrinsicMediumLevelOperandUsage,
+		    ParameterExprsMediumLevelOperandUsage);
+	case MLIL_INTRINSIC_SSA:
+		return OperandUsages(
+		    OutputSSAVariablesMediumLevelOperandUsage, IntrinsicMediumLevelOperandUsage,
+		    ParameterExprsMediumLevelOperandUsage);
+	case MLIL_MEMORY_INTRINSIC_SSA:
+		return OperandUsages(
+		    OutputSSAVariablesSubExprMediumLevelOperandUsage, OutputSSAMemoryVersionMediumLevelOperandUsage,
+		    IntrinsicMediumLevelOperandUsage, ParameterExprsMediumLevelOperandUsage,
+		    SourceMemoryVersionMediumLevelOperandUsage);
+	case MLIL_FREE_VAR_SLOT:
+		return OperandUsages(DestVariableMediumLevelOperandUsage);
+	case MLIL_FREE_VAR_SLOT_SSA:
+		return OperandUsages(DestSSAVariableMediumLevelOperandUsage, PartialSSAVariableSourceMediumLevelOperandUsage);
+	case MLIL_TRAP:
+		return OperandUsages(VectorMediumLevelOperandUsage);
+	case MLIL_VAR_PHI:
+		return OperandUsages(DestSSAVariableMediumLevelOperandUsage, SourceSSAVariablesMediumLevelOperandUsages);
+	case MLIL_MEM_PHI:
+		return OperandUsages(DestMemoryVersionMediumLevelOperandUsage, SourceMemoryVersionsMediumLevelOperandUsage);
+	case MLIL_CONST:
+	case MLIL_CONST_PTR:
+	case MLIL_FLOAT_CONST:
+	case MLIL_IMPORT:
+		return OperandUsages(ConstantMediumLevelOperandUsage);
+	case MLIL_EXTERN_PTR:
+		return OperandUsages(ConstantMediumLevelOperandUsage, OffsetMediumLevelOperandUsage);
+	case MLIL_CONST_DATA:
+		return OperandUsages(ConstantDataMediumLevelOperandUsage);
+	case MLIL_ADD:
+	case MLIL_SUB:
+	case MLIL_AND:
+	case MLIL_OR:
+	case MLIL_XOR:
+	case MLIL_LSL:
+	case MLIL_LSR:
+	case MLIL_ASR:
+	case MLIL_ROL:
+	case MLIL_ROR:
+	case MLIL_MUL:
+	case MLIL_MULU_DP:
+	case MLIL_MULS_DP:
+	case MLIL_DIVU:
+	case MLIL_DIVS:
+	case MLIL_MODU:
+	case MLIL_MODS:
+	case MLIL_CMP_E:
+	case MLIL_CMP_NE:
+	case MLIL_CMP_SLT:
+	case MLIL_CMP_ULT:
+	case MLIL_CMP_SLE:
+	case MLIL_CMP_ULE:
+	case MLIL_CMP_SGE:
+	case MLIL_CMP_UGE:
+	case MLIL_CMP_SGT:
+	case MLIL_CMP_UGT:
+	case MLIL_TEST_BIT:
+	case MLIL_ADD_OVERFLOW:
+	case MLIL_DIVU_DP:
+	case MLIL_DIVS_DP:
+	case MLIL_MODU_DP:
+	case MLIL_MODS_DP:
+	case MLIL_FADD:
+	case MLIL_FSUB:
+	case MLIL_FMUL:
+	case MLIL_FDIV:
+	case MLIL_FCMP_E:
+	case MLIL_FCMP_NE:
+	case MLIL_FCMP_LT:
+	case MLIL_FCMP_LE:
+	case MLIL_FCMP_GE:
+	case MLIL_FCMP_GT:
+	case MLIL_FCMP_O:
+	case MLIL_FCMP_UO:
+		return OperandUsages(LeftExprMediumLevelOperandUsage, RightExprMediumLevelOperandUsage);
+	case MLIL_ADC:
+	case MLIL_SBB:
+	case MLIL_RLC:
+	case MLIL_RRC:
+		return OperandUsages(
+		    LeftExprMediumLevelOperandUsage, RightExprMediumLevelOperandUsage, CarryExprMediumLevelOperandUsage);
+	default:
+		return MediumLevelILOperationOperands {};
+	}
+}
+
+
+static constexpr MediumLevelILOperandType OperandTypeForUsage(MediumLevelILOperandUsage usage)
+{
+	switch (usage)
 	{
-		result[operation.first] = unordered_map<MediumLevelILOperandUsage, size_t>();
-		result[operation.first].reserve(operation.second.size());
-		size_t operand = 0;
-		for (auto usage : operation.second)
+	case SourceExprMediumLevelOperandUsage:
+	case DestExprMediumLevelOperandUsage:
+	case LeftExprMediumLevelOperandUsage:
+	case RightExprMediumLevelOperandUsage:
+	case CarryExprMediumLevelOperandUsage:
+	case StackExprMediumLevelOperandUsage:
+	case ConditionExprMediumLevelOperandUsage:
+		return ExprMediumLevelOperand;
+	case SourceVariableMediumLevelOperandUsage:
+	case DestVariableMediumLevelOperandUsage:
+	case HighVariableMediumLevelOperandUsage:
+	case LowVariableMediumLevelOperandUsage:
+	case HighSSAVariableMediumLevelOperandUsage:
+	case LowSSAVariableMediumLevelOperandUsage:
+		return VariableMediumLevelOperand;
+	case SourceSSAVariableMediumLevelOperandUsage:
+	case PartialSSAVariableSourceMediumLevelOperandUsage:
+	case DestSSAVariableMediumLevelOperandUsage:
+		return SSAVariableMediumLevelOperand;
+	case OffsetMediumLevelOperandUsage:
+	case ConstantMediumLevelOperandUsage:
+	case VectorMediumLevelOperandUsage:
+		return IntegerMediumLevelOperand;
+	case ConstantDataMediumLevelOperandUsage:
+		return ConstantDataMediumLevelOperand;
+	case IntrinsicMediumLevelOperandUsage:
+		return IntrinsicMediumLevelOperand;
+	case TargetMediumLevelOperandUsage:
+	case TrueTargetMediumLevelOperandUsage:
+	case FalseTargetMediumLevelOperandUsage:
+	case DestMemoryVersionMediumLevelOperandUsage:
+	case SourceMemoryVersionMediumLevelOperandUsage:
+	case OutputSSAMemoryVersionMediumLevelOperandUsage:
+	case ParameterSSAMemoryVersionMediumLevelOperandUsage:
+		return IndexMediumLevelOperand;
+	case TargetsMediumLevelOperandUsage:
+		return IndexMapMediumLevelOperand;
+	case SourceMemoryVersionsMediumLevelOperandUsage:
+		return IndexListMediumLevelOperand;
+	case OutputVariablesMediumLevelOperandUsage:
+	case OutputVariablesSubExprMediumLevelOperandUsage:
+		return VariableListMediumLevelOperand;
+	case OutputSSAVariablesMediumLevelOperandUsage:
+	case OutputSSAVariablesSubExprMediumLevelOperandUsage:
+	case SourceSSAVariablesMediumLevelOperandUsages:
+		return SSAVariableListMediumLevelOperand;
+	case ParameterExprsMediumLevelOperandUsage:
+	case SourceExprsMediumLevelOperandUsage:
+	case UntypedParameterExprsMediumLevelOperandUsage:
+	case UntypedParameterSSAExprsMediumLevelOperandUsage:
+		return ExprListMediumLevelOperand;
+	}
+	throw MediumLevelILInstructionAccessException();
+}
+
+
+static constexpr MediumLevelILOperationOperands ComputeOperationOperands(BNMediumLevelILOperation operation)
+{
+	MediumLevelILOperationOperands result = OperandUsagesForOperation(operation);
+	size_t operand = 0;
+	for (size_t i = 0; i < result.count; i++)
+	{
+		MediumLevelILOperandUsage usage = result.usages[i];
+		result.operandIndices[i] = (uint8_t)operand;
+		switch (usage)
 		{
-			result[operation.first][usage] = operand;
-			switch (usage)
+		case PartialSSAVariableSourceMediumLevelOperandUsage:
+			// SSA variables are usually two slots, but this one has a previously defined
+			// variables and thus only takes one slot
+			operand++;
+			break;
+		case OutputVariablesSubExprMediumLevelOperandUsage:
+		case UntypedParameterExprsMediumLevelOperandUsage:
+			// Represented as subexpression, so only takes one slot even though it is a list
+			operand++;
+			break;
+		case OutputSSAVariablesSubExprMediumLevelOperandUsage:
+			// OutputSSAMemoryVersionMediumLevelOperandUsage follows at same operand
+			break;
+		case UntypedParameterSSAExprsMediumLevelOperandUsage:
+			// ParameterSSAMemoryVersionMediumLevelOperandUsage follows at same operand
+			break;
+		default:
+			switch (OperandTypeForUsage(usage))
 			{
-			case PartialSSAVariableSourceMediumLevelOperandUsage:
-				// SSA variables are usually two slots, but this one has a previously defined
-				// variables and thus only takes one slot
-				operand++;
-				break;
-			case OutputVariablesSubExprMediumLevelOperandUsage:
-			case UntypedParameterExprsMediumLevelOperandUsage:
-				// Represented as subexpression, so only takes one slot even though it is a list
-				operand++;
-				break;
-			case OutputSSAVariablesSubExprMediumLevelOperandUsage:
-				// OutputSSAMemoryVersionMediumLevelOperandUsage follows at same operand
-				break;
-			case UntypedParameterSSAExprsMediumLevelOperandUsage:
-				// ParameterSSAMemoryVersionMediumLevelOperandUsage follows at same operand
+			case SSAVariableMediumLevelOperand:
+			case IndexListMediumLevelOperand:
+			case IndexMapMediumLevelOperand:
+			case VariableListMediumLevelOperand:
+			case SSAVariableListMediumLevelOperand:
+			case ExprListMediumLevelOperand:
+				// SSA variables and lists take two operand slots
+				operand += 2;
 				break;
 			default:
-				switch (MediumLevelILInstructionBase::operandTypeForUsage[usage])
-				{
-				case SSAVariableMediumLevelOperand:
-				case IndexListMediumLevelOperand:
-				case IndexMapMediumLevelOperand:
-				case VariableListMediumLevelOperand:
-				case SSAVariableListMediumLevelOperand:
-				case ExprListMediumLevelOperand:
-					// SSA variables and lists take two operand slots
-					operand += 2;
-					break;
-				default:
-					operand++;
-					break;
-				}
+				operand++;
 				break;
 			}
+			break;
 		}
 	}
 	return result;
 }
 
 
-unordered_map<BNMediumLevelILOperation, unordered_map<MediumLevelILOperandUsage, size_t>>
-    MediumLevelILInstructionBase::operationOperandIndex = GetOperandIndexForOperandUsages();
+namespace
+{
+	constexpr size_t MediumLevelILOperationCount = MLIL_MEM_PHI + 1;
+	constexpr size_t MediumLevelILOperandUsageCount = SourceSSAVariablesMediumLevelOperandUsages + 1;
+	constexpr uint8_t InvalidOperandIndex = 0xff;
+
+	struct MediumLevelILOperandTables
+	{
+		MediumLevelILOperationOperands operations[MediumLevelILOperationCount];
+		uint8_t operandIndex[MediumLevelILOperationCount][MediumLevelILOperandUsageCount];
+	};
+}  // namespace
+
+
+static constexpr MediumLevelILOperandTables BuildOperandTables()
+{
+	MediumLevelILOperandTables result {};
+	for (size_t i = 0; i < MediumLevelILOperationCount; i++)
+	{
+		result.operations[i] = ComputeOperationOperands((BNMediumLevelILOperation)i);
+		for (size_t j = 0; j < MediumLevelILOperandUsageCount; j++)
+			result.operandIndex[i][j] = InvalidOperandIndex;
+		for (size_t j = 0; j < result.operations[i].count; j++)
+			result.operandIndex[i][result.operations[i].usages[j]] = result.operations[i].operandIndices[j];
+	}
+	return result;
+}
+
+
+static constexpr MediumLevelILOperandTables s_operandTables = BuildOperandTables();
+
+
+MediumLevelILOperandType MediumLevelILInstructionBase::GetOperandTypeForUsage(MediumLevelILOperandUsage usage)
+{
+	return OperandTypeForUsage(usage);
+}
+
+
+const MediumLevelILOperationOperands* MediumLevelILInstructionBase::GetOperationOperands(BNMediumLevelILOperation operation)
+{
+	if ((size_t)operation >= MediumLevelILOperationCount || !s_operandTables.operations[operation].valid)
+		return nullptr;
+	return &s_operandTables.operations[operation];
+}
 
 
 SSAVariable::SSAVariable() : version(0) {}
@@ -722,10 +852,7 @@ MediumLevelILOperand::MediumLevelILOperand(
     m_instr(instr),
     m_usage(usage), m_operandIndex(operandIndex)
 {
-	auto i = MediumLevelILInstructionBase::operandTypeForUsage.find(m_usage);
-	if (i == MediumLevelILInstructionBase::operandTypeForUsage.end())
-		throw MediumLevelILInstructionAccessException();
-	m_type = i->second;
+	m_type = MediumLevelILInstructionBase::GetOperandTypeForUsage(m_usage);
 }
 
 
@@ -840,19 +967,14 @@ MediumLevelILInstructionList MediumLevelILOperand::GetExprList() const
 
 const MediumLevelILOperand MediumLevelILOperandList::ListIterator::operator*()
 {
-	MediumLevelILOperandUsage usage = *pos;
-	auto i = owner->m_operandIndexMap.find(usage);
-	if (i == owner->m_operandIndexMap.end())
-		throw MediumLevelILInstructionAccessException();
-	return MediumLevelILOperand(owner->m_instr, usage, i->second);
+	return MediumLevelILOperand(owner->m_instr, owner->m_operands.usages[pos], owner->m_operands.operandIndices[pos]);
 }
 
 
-MediumLevelILOperandList::MediumLevelILOperandList(const MediumLevelILInstruction& instr,
-    const vector<MediumLevelILOperandUsage>& usageList,
-    const unordered_map<MediumLevelILOperandUsage, size_t>& operandIndexMap) :
+MediumLevelILOperandList::MediumLevelILOperandList(
+    const MediumLevelILInstruction& instr, const MediumLevelILOperationOperands& operands) :
     m_instr(instr),
-    m_usageList(usageList), m_operandIndexMap(operandIndexMap)
+    m_operands(operands)
 {}
 
 
@@ -860,7 +982,7 @@ MediumLevelILOperandList::const_iterator MediumLevelILOperandList::begin() const
 {
 	const_iterator result;
 	result.owner = this;
-	result.pos = m_usageList.begin();
+	result.pos = 0;
 	return result;
 }
 
@@ -869,24 +991,22 @@ MediumLevelILOperandList::const_iterator MediumLevelILOperandList::end() const
 {
 	const_iterator result;
 	result.owner = this;
-	result.pos = m_usageList.end();
+	result.pos = m_operands.count;
 	return result;
 }
 
 
 size_t MediumLevelILOperandList::size() const
 {
-	return m_usageList.size();
+	return m_operands.count;
 }
 
 
 const MediumLevelILOperand MediumLevelILOperandList::operator[](size_t i) const
 {
-	MediumLevelILOperandUsage usage = m_usageList[i];
-	auto indexMap = m_operandIndexMap.find(usage);
-	if (indexMap == m_operandIndexMap.end())
+	if (i >= m_operands.count)
 		throw MediumLevelILInstructionAccessException();
-	return MediumLevelILOperand(m_instr, usage, indexMap->second);
+	return MediumLevelILOperand(m_instr, m_operands.usages[i], m_operands.operandIndices[i]);
 }
 
 
@@ -951,13 +1071,10 @@ MediumLevelILInstruction::MediumLevelILInstruction(const MediumLevelILInstructio
 
 MediumLevelILOperandList MediumLevelILInstructionBase::GetOperands() const
 {
-	auto usage = operationOperandUsage.find(operation);
-	if (usage == operationOperandUsage.end())
-		throw MediumLevelILInstructionAccessException();
-	auto operandIndex = operationOperandIndex.find(operation);
-	if (operandIndex == operationOperandIndex.end())
+	const MediumLevelILOperationOperands* operands = GetOperationOperands(operation);
+	if (!operands)
 		throw MediumLevelILInstructionAccessException();
-	return MediumLevelILOperandList(*(const MediumLevelILInstruction*)this, usage->second, operandIndex->second);
+	return MediumLevelILOperandList(*(const MediumLevelILInstruction*)this, *operands);
 }
 
 
@@ -1390,119 +1507,119 @@ void MediumLevelILInstructionBase::ClearAttribute(BNILInstructionAttribute attri
 }
 
 
-void MediumLevelILInstruction::VisitExprs(const std::function<bool(const MediumLevelILInstruction& expr)>& func) const
+void MediumLevelILInstruction::CollectSubExprs(vector<MediumLevelILInstruction>& toProcess) const
 {
-	if (!func(*this))
-		return;
+	// Sub-expressions are pushed in reverse so that the first operand is visited first
+	size_t start = toProcess.size();
 	switch (operation)
 	{
 	case MLIL_SET_VAR:
-		GetSourceExpr<MLIL_SET_VAR>().VisitExprs(func);
+		toProcess.push_back(GetSourceExpr<MLIL_SET_VAR>());
 		break;
 	case MLIL_SET_VAR_SSA:
-		GetSourceExpr<MLIL_SET_VAR_SSA>().VisitExprs(func);
+		toProcess.push_back(GetSourceExpr<MLIL_SET_VAR_SSA>());
 		break;
 	case MLIL_SET_VAR_ALIASED:
-		GetSourceExpr<MLIL_SET_VAR_ALIASED>().VisitExprs(func);
+		toProcess.push_back(GetSourceExpr<MLIL_SET_VAR_ALIASED>());
 		break;
 	case MLIL_SET_VAR_SPLIT:
-		GetSourceExpr<MLIL_SET_VAR_SPLIT>().VisitExprs(func);
+		toProcess.push_back(GetSourceExpr<MLIL_SET_VAR_SPLIT>());
 		break;
 	case MLIL_SET_VAR_SPLIT_SSA:
-		GetSourceExpr<MLIL_SET_VAR_SPLIT_SSA>().VisitExprs(func);
+		toProcess.push_back(GetSourceExpr<MLIL_SET_VAR_SPLIT_SSA>());
 		break;
 	case MLIL_SET_VAR_FIELD:
-		GetSourceExpr<MLIL_SET_VAR_FIELD>().VisitExprs(func);
+		toProcess.push_back(GetSourceExpr<MLIL_SET_VAR_FIELD>());
 		break;
 	case MLIL_SET_VAR_SSA_FIELD:
-		GetSourceExpr<MLIL_SET_VAR_SSA_FIELD>().VisitExprs(func);
+		toProcess.push_back(GetSourceExpr<MLIL_SET_VAR_SSA_FIELD>());
 		break;
 	case MLIL_SET_VAR_ALIASED_FIELD:
-		GetSourceExpr<MLIL_SET_VAR_ALIASED_FIELD>().VisitExprs(func);
+		toProcess.push_back(GetSourceExpr<MLIL_SET_VAR_ALIASED_FIELD>());
 		break;
 	case MLIL_CALL:
-		GetDestExpr<MLIL_CALL>().VisitExprs(func);
+		toProcess.push_back(GetDestExpr<MLIL_CALL>());
 		for (auto i : GetParameterExprs<MLIL_CALL>())
-			i.VisitExprs(func);
+			toProcess.push_back(i);
 		break;
 	case MLIL_CALL_UNTYPED:
-		GetDestExpr<MLIL_CALL_UNTYPED>().VisitExprs(func);
+		toProcess.push_back(GetDestExpr<MLIL_CALL_UNTYPED>());
 		for (auto i : GetParameterExprs<MLIL_CALL_UNTYPED>())
-			i.VisitExprs(func);
+			toProcess.push_back(i);
 		break;
 	case MLIL_CALL_SSA:
-		GetDestExpr<MLIL_CALL_SSA>().VisitExprs(func);
+		toProcess.push_back(GetDestExpr<MLIL_CALL_SSA>());
 		for (auto i : GetParameterExprs<MLIL_CALL_SSA>())
-			i.VisitExprs(func);
+			toProcess.push_back(i);
 		break;
 	case MLIL_CALL_UNTYPED_SSA:
-		GetDestExpr<MLIL_CALL_UNTYPED_SSA>().VisitExprs(func);
+		toProcess.push_back(GetDestExpr<MLIL_CALL_UNTYPED_SSA>());
 		for (auto i : GetParameterExprs<MLIL_CALL_UNTYPED_SSA>())
-			i.VisitExprs(func);
+			toProcess.push_back(i);
 		break;
 	case MLIL_SYSCALL:
 		for (auto i : GetParameterExprs<MLIL_SYSCALL>())
-			i.VisitExprs(func);
+			toProcess.push_back(i);
 		break;
 	case MLIL_SYSCALL_UNTYPED:
 		for (auto i : GetParameterExprs<MLIL_SYSCALL_UNTYPED>())
-			i.VisitExprs(func);
+			toProcess.push_back(i);
 		break;
 	case MLIL_SYSCALL_SSA:
 		for (auto i : GetParameterExprs<MLIL_SYSCALL_SSA>())
-			i.VisitExprs(func);
+			toProcess.push_back(i);
 		break;
 	case MLIL_SYSCALL_UNTYPED_SSA:
 		for (auto i : GetParameterExprs<MLIL_SYSCALL_UNTYPED_SSA>())
-			i.VisitExprs(func);
+			toProcess.push_back(i);
 		break;
 	case MLIL_TAILCALL:
-		GetDestExpr<MLIL_TAILCALL>().VisitExprs(func);
+		toProcess.push_back(GetDestExpr<MLIL_TAILCALL>());
 		for (auto i : GetParameterExprs<MLIL_TAILCALL>())
-			i.VisitExprs(func);
+			toProcess.push_back(i);
 		break;
 	case MLIL_TAILCALL_UNTYPED:
-		GetDestExpr<MLIL_TAILCALL_UNTYPED>().VisitExprs(func);
+		toProcess.push_back(GetDestExpr<MLIL_TAILCALL_UNTYPED>());
 		for (auto i : GetParameterExprs<MLIL_TAILCALL_UNTYPED>())
-			i.VisitExprs(func);
+			toProcess.push_back(i);
 		break;
 	case MLIL_TAILCALL_SSA:
-		GetDestExpr<MLIL_TAILCALL_SSA>().VisitExprs(func);
+		toProcess.push_back(GetDestExpr<MLIL_TAILCALL_SSA>());
 		for (auto i : GetParameterExprs<MLIL_TAILCALL_SSA>())
-			i.VisitExprs(func);
+			toProcess.push_back(i);
 		break;
 	case MLIL_TAILCALL_UNTYPED_SSA:
-		GetDestExpr<MLIL_TAILCALL_UNTYPED_SSA>().VisitExprs(func);
+		toProcess.push_back(GetDestExpr<MLIL_TAILCALL_UNTYPED_SSA>());
 		for (auto i : GetParameterExprs<MLIL_TAILCALL_UNTYPED_SSA>())
-			i.VisitExprs(func);
+			toProcess.push_back(i);
 		break;
 	case MLIL_SEPARATE_PARAM_LIST:
 		for (auto i : GetParameterExprs<MLIL_SEPARATE_PARAM_LIST>())
-			i.VisitExprs(func);
+			toProcess.push_back(i);
 		break;
 	case MLIL_SHARED_PARAM_SLOT:
 		for (auto i : GetParameterExprs<MLIL_SHARED_PARAM_SLOT>())
-			i.VisitExprs(func);
+			toProcess.push_back(i);
 		break;
 	case MLIL_RET:
 		for (auto i : GetSourceExprs<MLIL_RET>())
-			i.VisitExprs(func);
+			toProcess.push_back(i);
 		break;
 	case MLIL_STORE:
-		GetDestExpr<MLIL_STORE>().VisitExprs(func);
-		GetSourceExpr<MLIL_STORE>().VisitExprs(func);
+		toProcess.push_back(GetDestExpr<MLIL_STORE>());
+		toProcess.push_back(GetSourceExpr<MLIL_STORE>());
 		break;
 	case MLIL_STORE_STRUCT:
-		GetDestExpr<MLIL_STORE_STRUCT>().VisitExprs(func);
-		GetSourceExpr<MLIL_STORE_STRUCT>().VisitExprs(func);
+		toProcess.push_back(GetDestExpr<MLIL_STORE_STRUCT>());
+		toProcess.push_back(GetSourceExpr<MLIL_STORE_STRUCT>());
 		break;
 	case MLIL_STORE_SSA:
-		GetDestExpr<MLIL_STORE_SSA>().VisitExprs(func);
-		GetSourceExpr<MLIL_STORE_SSA>().VisitExprs(func);
+		toProcess.push_back(GetDestExpr<MLIL_STORE_SSA>());
+		toProcess.push_back(GetSourceExpr<MLIL_STORE_SSA>());
 		break;
 	case MLIL_STORE_STRUCT_SSA:
-		GetDestExpr<MLIL_STORE_STRUCT_SSA>().VisitExprs(func);
-		GetSourceExpr<MLIL_STORE_STRUCT_SSA>().VisitExprs(func);
+		toProcess.push_back(GetDestExpr<MLIL_STORE_STRUCT_SSA>());
+		toProcess.push_back(GetSourceExpr<MLIL_STORE_STRUCT_SSA>());
 		break;
 	case MLIL_NEG:
 	case MLIL_NOT:
@@ -1529,7 +1646,7 @@ void MediumLevelILInstruction::VisitExprs(const std::function<bool(const MediumL
 	case MLIL_FLOOR:
 	case MLIL_CEIL:
 	case MLIL_FTRUNC:
-		AsOneOperand().GetSourceExpr().VisitExprs(func);
+		toProcess.push_back(AsOneOperand().GetSourceExpr());
 		break;
 	case MLIL_ADD:
 	case MLIL_SUB:
@@ -1576,29 +1693,36 @@ void MediumLevelILInstruction::VisitExprs(const std::function<bool(const MediumL
 	case MLIL_FCMP_GT:
 	case MLIL_FCMP_O:
 	case MLIL_FCMP_UO:
-		AsTwoOperand().GetLeftExpr().VisitExprs(func);
-		AsTwoOperand().GetRightExpr().VisitExprs(func);
+		toProcess.push_back(AsTwoOperand().GetLeftExpr());
+		toProcess.push_back(AsTwoOperand().GetRightExpr());
 		break;
 	case MLIL_ADC:
 	case MLIL_SBB:
 	case MLIL_RLC:
 	case MLIL_RRC:
-		AsTwoOperandWithCarry().GetLeftExpr().VisitExprs(func);
-		AsTwoOperandWithCarry().GetRightExpr().VisitExprs(func);
-		AsTwoOperandWithCarry().GetCarryExpr().VisitExprs(func);
+		toProcess.push_back(AsTwoOperandWithCarry().GetLeftExpr());
+		toProcess.push_back(AsTwoOperandWithCarry().GetRightExpr());
+		toProcess.push_back(AsTwoOperandWithCarry().GetCarryExpr());
 		break;
 	case MLIL_INTRINSIC:
 		for (auto i : GetParameterExprs<MLIL_INTRINSIC>())
-			i.VisitExprs(func);
+			toProcess.push_back(i);
 		break;
 	case MLIL_INTRINSIC_SSA:
 	case MLIL_MEMORY_INTRINSIC_SSA:
 		for (auto i : GetParameterExprs())
-			i.VisitExprs(func);
+			toProcess.push_back(i);
 		break;
 	default:
 		break;
 	}
+	reverse(toProcess.begin() + start, toProcess.end());
+}
+
+
+void MediumLevelILInstruction::VisitExprs(const std::function<bool(const MediumLevelILInstruction& expr)>& func) const
+{
+	VisitExprs<const std::function<bool(const MediumLevelILInstruction& expr)>&>(func);
 }
 
 
@@ -1931,13 +2055,12 @@ ExprId MediumLevelILInstruction::CopyTo(MediumLevelILFunction* dest,
 
 bool MediumLevelILInstruction::GetOperandIndexForUsage(MediumLevelILOperandUsage usage, size_t& operandIndex) const
 {
-	auto operationIter = MediumLevelILInstructionBase::operationOperandIndex.find(operation);
-	if (operationIter == MediumLevelILInstructionBase::operationOperandIndex.end())
+	if ((size_t)operation >= MediumLevelILOperationCount)
 		return false;
-	auto usageIter = operationIter->second.find(usage);
-	if (usageIter == operationIter->second.end())
+	uint8_t index = s_operandTables.operandIndex[operation][usage];
+	if (index == InvalidOperandIndex)
 		return false;
-	operandIndex = usageIter->second;
+	operandIndex = index;
 	return true;
 }
 
@@ -136,6 +136,21 @@ namespace BinaryNinja
 		ParameterSSAMemoryVersionMediumLevelOperandUsage,
 		SourceSSAVariablesMediumLevelOperandUsages
 	};
+
+	/*!
+		Operand layout of an operation: the usage of each operand, in order, and the raw operand slot it starts at.
+
+		\ingroup mediumlevelil
+	*/
+	struct MediumLevelILOperationOperands
+	{
+		static constexpr size_t MaxUsages = 6;
+
+		bool valid;
+		uint8_t count;
+		MediumLevelILOperandUsage usages[MaxUsages];
+		uint8_t operandIndices[MaxUsages];
+	};
 }  // namespace BinaryNinjaCore
 
 namespace std {
@@ -437,11 +452,8 @@ namespace BinaryNinja
 #endif
 		size_t exprIndex, instructionIndex;
 
-		static _STD_UNORDERED_MAP<MediumLevelILOperandUsage, MediumLevelILOperandType> operandTypeForUsage;
-		static _STD_UNORDERED_MAP<BNMediumLevelILOperation, _STD_VECTOR<MediumLevelILOperandUsage>>
-		    operationOperandUsage;
-		static _STD_UNORDERED_MAP<BNMediumLevelILOperation, _STD_UNORDERED_MAP<MediumLevelILOperandUsage, size_t>>
-		    operationOperandIndex;
+		static MediumLevelILOperandType GetOperandTypeForUsage(MediumLevelILOperandUsage usage);
+		static const MediumLevelILOperationOperands* GetOperationOperands(BNMediumLevelILOperation operation);
 
 		MediumLevelILOperandList GetOperands() const;
 
@@ -570,8 +582,30 @@ namespace BinaryNinja
 		    MediumLevelILFunction* func, const BNMediumLevelILInstruction& instr, size_t expr, size_t instrIdx);
 		MediumLevelILInstruction(const MediumLevelILInstructionBase& instr);
 
+		void CollectSubExprs(_STD_VECTOR<MediumLevelILInstruction>& toProcess) const;
 		void VisitExprs(const std::function<bool(const MediumLevelILInstruction& expr)>& func) const;
 
+		/*! Visit this expression and all of its sub-expressions in pre-order. Returning false from the callback
+			skips the sub-expressions of the current expression. The callback is inlined and the traversal uses an
+			explicit stack, so deeply nested expressions do not grow the call stack.
+
+			\param func Callback taking a const MediumLevelILInstruction& and returning whether to visit its sub-expressions
+		*/
+		template <typename T>
+		void VisitExprs(T&& func) const
+		{
+			_STD_VECTOR<MediumLevelILInstruction> toProcess;
+			toProcess.push_back(*this);
+			while (!toProcess.empty())
+			{
+				MediumLevelILInstruction cur = std::move(toProcess.back());
+				toProcess.pop_back();
+				if (!func(cur))
+					continue;
+				cur.CollectSubExprs(toProcess);
+			}
+		}
+
 		ExprId CopyTo(MediumLevelILFunction* dest) const;
 		ExprId CopyTo(MediumLevelILFunction* dest,
 		    const std::function<ExprId(const MediumLevelILInstruction& subExpr)>& subExprHandler) const;
@@ -871,7 +905,7 @@ namespace BinaryNinja
 		struct ListIterator
 		{
 			const MediumLevelILOperandList* owner;
-			_STD_VECTOR<MediumLevelILOperandUsage>::const_iterator pos;
+			size_t pos;
 			bool operator==(const ListIterator& a) const { return pos == a.pos; }
 			bool operator!=(const ListIterator& a) const { return pos != a.pos; }
 			bool operator<(const ListIterator& a) const { return pos < a.pos; }
@@ -884,15 +918,12 @@ namespace BinaryNinja
 		};
 
 		MediumLevelILInstruction m_instr;
-		const _STD_VECTOR<MediumLevelILOperandUsage>& m_usageList;
-		const _STD_UNORDERED_MAP<MediumLevelILOperandUsage, size_t>& m_operandIndexMap;
+		const MediumLevelILOperationOperands& m_operands;
 
 	  public:
 		typedef ListIterator const_iterator;
 
-		MediumLevelILOperandList(const MediumLevelILInstruction& instr,
-		    const _STD_VECTOR<MediumLevelILOperandUsage>& usageList,
-		    const _STD_UNORDERED_MAP<MediumLevelILOperandUsage, size_t>& operandIndexMap);
+		MediumLevelILOperandList(const MediumLevelILInstruction& instr, const MediumLevelILOperationOperands& operands);
 
 		const_iterator begin() const;
 		const_iterator end() const;
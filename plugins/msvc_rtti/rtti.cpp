@@ -53,28 +53,39 @@ TypeDescriptor::TypeDescriptor(BinaryView *view, uint64_t address)
 
 
 CompleteObjectLocator::CompleteObjectLocator(BinaryView *view, uint64_t address)
+{
+    auto coLocator = TryRead(view, address);
+    if (!coLocator.has_value())
+        throw ReadException();
+    *this = coLocator.value();
+}
+
+
+std::optional<CompleteObjectLocator> CompleteObjectLocator::TryRead(BinaryView *view, uint64_t address)
 {
     BinaryReader reader = BinaryReader(view);
     reader.Seek(address);
-    signature = reader.Read32();
-    offset = reader.Read32();
-    cdOffset = reader.Read32();
-    pTypeDescriptor = static_cast<int32_t>(reader.Read32());
-    pClassHeirarchyDescriptor = static_cast<int32_t>(reader.Read32());
-    if (signature == COL_SIG_REV1)
-    {
-        pSelf = static_cast<int32_t>(reader.Read32());
-    }
-    else
-    {
-        pSelf = 0;
-    }
+    CompleteObjectLocator coLocator;
+    uint32_t typeDescriptor, classHeirarchyDescriptor, self = 0;
+    if (!reader.TryRead32(coLocator.signature) || !reader.TryRead32(coLocator.offset)
+        || !reader.TryRead32(coLocator.cdOffset) || !reader.TryRead32(typeDescriptor)
+        || !reader.TryRead32(classHeirarchyDescriptor))
+        return std::nullopt;
+    if (coLocator.signature == COL_SIG_REV1 && !reader.TryRead32(self))
+        return std::nullopt;
+    coLocator.pTypeDescriptor = static_cast<int32_t>(typeDescriptor);
+    coLocator.pClassHeirarchyDescriptor = static_cast<int32_t>(classHeirarchyDescriptor);
+    coLocator.pSelf = static_cast<int32_t>(self);
+    return coLocator;
 }
 
 
 std::optional<CompleteObjectLocator> ReadCompleteObjectorLocator(BinaryView *view, uint64_t address)
 {
-    auto coLocator = CompleteObjectLocator(view, address);
+    auto readLocator = CompleteObjectLocator::TryRead(view, address);
+    if (!readLocator.has_value())
+        return std::nullopt;
+    auto coLocator = readLocator.value();
     uint64_t startAddr = view->GetOriginalImageBase();
 
     auto outsideSection = [&](uint64_t addr) {
@@ -524,7 +535,9 @@ std::optional<VirtualFunctionTableInfo> MicrosoftRTTIProcessor::ProcessVFT(uint6
     std::vector<std::pair<uint64_t, std::optional<Ref<Function>>>> virtualFunctions = {};
     while (true)
     {
-        uint64_t vFuncAddr = reader.ReadPointer();
+        uint64_t vFuncAddr;
+        if (!reader.TryReadPointer(vFuncAddr))
+            break;
         auto funcs = m_view->GetAnalysisFunctionsForAddress(vFuncAddr);
         if (funcs.empty())
         {
@@ -666,12 +679,15 @@ void MicrosoftRTTIProcessor::ProcessRTTI()
              coLocatorAddr += addrSize)
         {
             optReader.Seek(coLocatorAddr);
-            uint32_t sigVal = optReader.Read32();
+            uint32_t sigVal;
+            if (!optReader.TryRead32(sigVal))
+                continue;
             if (sigVal == COL_SIG_REV1)
             {
                 // Check for self reference
                 optReader.SeekRelative(16);
-                if (optReader.Read32() == coLocatorAddr - startAddr)
+                uint32_t selfVal;
+                if (optReader.TryRead32(selfVal) && selfVal == coLocatorAddr - startAddr)
                 {
                     if (auto classInfo = ProcessRTTI(coLocatorAddr))
                         m_classInfo[coLocatorAddr] = classInfo.value();
@@ -681,7 +697,10 @@ void MicrosoftRTTIProcessor::ProcessRTTI()
             {
                 // Check ?AV
                 optReader.SeekRelative(8);
-                uint64_t typeDescNameAddr = optReader.Read32() + 8;
+                uint32_t typeDescAddr;
+                if (!optReader.TryRead32(typeDescAddr))
+                    continue;
+                uint64_t typeDescNameAddr = typeDescAddr + 8;
                 if (typeDescNameAddr > startAddr && typeDescNameAddr < endAddr)
                 {
                     // Make sure we do not read across segment boundary.
@@ -689,7 +708,9 @@ void MicrosoftRTTIProcessor::ProcessRTTI()
                     if (typeDescSegment != nullptr && typeDescSegment->GetEnd() - typeDescNameAddr > 4)
                     {
                         optReader.Seek(typeDescNameAddr);
-                        auto typeDescNameStart = optReader.ReadString(4);
+                        std::string typeDescNameStart;
+                        if (!optReader.TryReadString(typeDescNameStart, 4))
+                            continue;
                         if (typeDescNameStart == ".?AV" || typeDescNameStart == ".?AU" || typeDescNameStart == ".?AW")
                         {
                             if (auto classInfo = ProcessRTTI(coLocatorAddr))
@@ -731,11 +752,11 @@ void MicrosoftRTTIProcessor::ProcessVFT()
     auto start_time = std::chrono::high_resolution_clock::now();
     for (auto &[coLocatorAddr, classInfo]: m_classInfo)
     {
-        for (auto &ref: m_view->GetDataReferences(coLocatorAddr))
-        {
+        m_view->ForEachDataReference(coLocatorAddr, [&](uint64_t ref) {
             auto vftAddr = ref + m_view->GetAddressSize();
             vftMap[coLocatorAddr] = vftAddr;
-        }
+            return true;
+        });
     }
 
     if (virtualFunctionTableSweep)
@@ -748,7 +769,9 @@ void MicrosoftRTTIProcessor::ProcessVFT()
             for (uint64_t vtableAddr = startAddr; vtableAddr < endAddr - 0x18; vtableAddr += addrSize)
             {
                 optReader.Seek(vtableAddr);
-                uint64_t coLocatorAddr = optReader.ReadPointer();
+                uint64_t coLocatorAddr;
+                if (!optReader.TryReadPointer(coLocatorAddr))
+                    continue;
                 auto coLocator = m_classInfo.find(coLocatorAddr);
                 if (coLocator == m_classInfo.end())
                     continue;
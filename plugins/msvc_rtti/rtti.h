@@ -55,7 +55,10 @@ namespace BinaryNinja {
 		// Only on 64 bit
 		int32_t pSelf;
 
+		CompleteObjectLocator() = default;
 		CompleteObjectLocator(BinaryView *view, uint64_t address);
+
+		static std::optional<CompleteObjectLocator> TryRead(BinaryView *view, uint64_t address);
 	};
 
 	struct VirtualFunctionInfo
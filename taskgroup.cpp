@@ -0,0 +1,295 @@
+#include "binaryninjaapi.h"
+#include <condition_variable>
+#include <deque>
+#include <exception>
+
+using namespace BinaryNinja;
+using namespace std;
+
+
+namespace BinaryNinja
+{
+	struct TaskGroupState
+	{
+		struct TaskQueue
+		{
+			mutex queueMutex;
+			deque<function<void()>> tasks;
+		};
+
+		// Queue 0 belongs to threads calling Wait, the rest to the worker threads helping the group
+		vector<unique_ptr<TaskQueue>> queues;
+		atomic<size_t> nextQueue = 0;
+		atomic<size_t> queued = 0;
+		atomic<size_t> pending = 0;
+		atomic<size_t> helpers = 0;
+		size_t maxHelpers = 0;
+
+		mutex waitMutex;
+		condition_variable waitCondition;
+		size_t waiters = 0;
+		exception_ptr error;
+
+		atomic<bool> cancelled = false;
+		Ref<BackgroundTask> task;
+		string progressText;
+		atomic<uint64_t> progressCompleted = 0;
+		atomic<uint64_t> progressTotal = 0;
+
+		bool IsCancelled();
+		bool RunOne(size_t queue);
+		void Finish();
+		void Notify();
+		void Help(size_t queue);
+		void UpdateProgressText(uint64_t completed, uint64_t total);
+	};
+}
+
+
+namespace
+{
+	struct TaskGroupContext
+	{
+		TaskGroupState* state;
+		size_t queue;
+	};
+}
+
+
+// The group and queue of the task running on this thread, so that subtasks are queued locally
+static thread_local TaskGroupContext g_currentTaskGroup = {nullptr, 0};
+
+
+bool TaskGroupState::IsCancelled()
+{
+	if (cancelled.load(memory_order_relaxed))
+		return true;
+	if (task && task->IsCancelled())
+	{
+		cancelled = true;
+		return true;
+	}
+	return false;
+}
+
+
+bool TaskGroupState::RunOne(size_t queue)
+{
+	// Take from the back of our own queue, then steal from the front of the others
+	function<void()> action;
+	for (size_t i = 0; i < queues.size(); i++)
+	{
+		TaskQueue& source = *queues[(queue + i) % queues.size()];
+		unique_lock<mutex> lock(source.queueMutex);
+		if (source.tasks.empty())
+			continue;
+		if (i == 0)
+		{
+			action = std::move(source.tasks.back());
+			source.tasks.pop_back();
+		}
+		else
+		{
+			action = std::move(source.tasks.front());
+			source.tasks.pop_front();
+		}
+		break;
+	}
+	if (!action)
+		return false;
+	queued.fetch_sub(1);
+
+	if (!IsCancelled())
+	{
+		TaskGroupContext previous = g_currentTaskGroup;
+		g_currentTaskGroup = {this, queue};
+		try
+		{
+			action();
+		}
+		catch (...)
+		{
+			unique_lock<mutex> lock(waitMutex);
+			if (!error)
+				error = current_exception();
+			cancelled = true;
+		}
+		g_currentTaskGroup = previous;
+	}
+
+	Finish();
+	return true;
+}
+
+
+void TaskGroupState::Finish()
+{
+	if (pending.fetch_sub(1) == 1)
+		Notify();
+}
+
+
+void TaskGroupState::Notify()
+{
+	unique_lock<mutex> lock(waitMutex);
+	if (waiters != 0)
+		waitCondition.notify_all();
+}
+
+
+void TaskGroupState::Help(size_t queue)
+{
+	while (true)
+	{
+		while (RunOne(queue))
+			;
+
+		// Tasks queued after the last check would otherwise have no helper to run them
+		helpers.fetch_sub(1);
+		if (queued.load() == 0)
+			return;
+		if (helpers.fetch_add(1) >= maxHelpers)
+		{
+			helpers.fetch_sub(1);
+			return;
+		}
+	}
+}
+
+
+void TaskGroupState::UpdateProgressText(uint64_t completed, uint64_t total)
+{
+	if (!task)
+		return;
+	string text = progressText.empty() ? string() : progressText + " ";
+	text += "(" + to_string(completed) + "/" + to_string(total) + ")";
+	task->SetProgressText(text);
+}
+
+
+TaskGroup::TaskGroup(BackgroundTask* task, const string& progressText) : m_state(make_shared<TaskGroupState>())
+{
+	size_t workers = max<size_t>(1, GetWorkerThreadCount());
+	m_state->maxHelpers = workers;
+	for (size_t i = 0; i <= workers; i++)
+		m_state->queues.push_back(make_unique<TaskGroupState::TaskQueue>());
+	m_state->task = task;
+	m_state->progressText = progressText;
+}
+
+
+TaskGroup::~TaskGroup()
+{
+	try
+	{
+		Wait();
+	}
+	catch (...)
+	{
+	}
+}
+
+
+void TaskGroup::Run(const function<void()>& task)
+{
+	TaskGroupState* state = m_state.get();
+	size_t queue;
+	if (g_currentTaskGroup.state == state)
+		queue = g_currentTaskGroup.queue;
+	else
+		queue = state->nextQueue.fetch_add(1) % state->queues.size();
+
+	state->pending.fetch_add(1);
+	{
+		TaskGroupState::TaskQueue& target = *state->queues[queue];
+		unique_lock<mutex> lock(target.queueMutex);
+		target.tasks.push_back(task);
+	}
+	size_t queued = state->queued.fetch_add(1) + 1;
+
+	size_t helpers = state->helpers.load();
+	while (helpers < state->maxHelpers && helpers < queued)
+	{
+		if (!state->helpers.compare_exchange_weak(helpers, helpers + 1))
+			continue;
+		// Helpers keep the state alive in case the group is destroyed before they are scheduled
+		shared_ptr<TaskGroupState> owner = m_state;
+		size_t helperQueue = 1 + (helpers % state->maxHelpers);
+		WorkerEnqueue([owner, helperQueue]() { owner->Help(helperQueue); }, "TaskGroup");
+		break;
+	}
+
+	// Waiting threads sleep only while nothing is queued, so wake them to help
+	state->Notify();
+}
+
+
+void TaskGroup::Wait()
+{
+	TaskGroupState* state = m_state.get();
+	while (true)
+	{
+		while (state->RunOne(0))
+			;
+
+		unique_lock<mutex> lock(state->waitMutex);
+		if (state->pending.load() == 0)
+			break;
+		if (state->queued.load() != 0)
+			continue;
+		state->waiters++;
+		// Poll occasionally so that cancelling the background task is noticed while tasks are running
+		state->waitCondition.wait_for(lock, chrono::milliseconds(100),
+		    [&]() { return state->pending.load() == 0 || state->queued.load() != 0; });
+		state->waiters--;
+		if (state->pending.load() == 0)
+			break;
+		lock.unlock();
+		state->IsCancelled();
+	}
+
+	exception_ptr error;
+	{
+		unique_lock<mutex> lock(state->waitMutex);
+		swap(error, state->error);
+	}
+	if (error)
+		rethrow_exception(error);
+}
+
+
+void TaskGroup::Cancel()
+{
+	m_state->cancelled = true;
+}
+
+
+bool TaskGroup::IsCancelled() const
+{
+	return m_state->IsCancelled();
+}
+
+
+void TaskGroup::SetProgressTotal(uint64_t total)
+{
+	m_state->progressTotal = total;
+	m_state->UpdateProgressText(m_state->progressCompleted.load(), total);
+}
+
+
+void TaskGroup::AddProgress(uint64_t completed)
+{
+	uint64_t total = m_state->progressTotal.load(memory_order_relaxed);
+	uint64_t before = m_state->progressCompleted.fetch_add(completed, memory_order_relaxed);
+	uint64_t after = before + completed;
+
+	// Only the caller that crosses a percentage boundary updates the text, to keep the core calls rare
+	if (total != 0 && ((before * 100) / total != (after * 100) / total || after == total))
+		m_state->UpdateProgressText(after, total);
+}
+
+
+pair<uint64_t, uint64_t> TaskGroup::GetProgress() const
+{
+	return {m_state->progressCompleted.load(), m_state->progressTotal.load()};
+}
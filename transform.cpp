@@ -18,12 +18,55 @@
 // FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
 // IN THE SOFTWARE.
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cctype>
+#include <condition_variable>
+#include <cstring>
+#include <memory>
+#include <mutex>
 #include "binaryninjaapi.h"
 
 using namespace BinaryNinja;
 using namespace std;
 
 
+namespace
+{
+	class BufferedTransformContext : public TransformContext
+	{
+		Ref<Transform> m_transform;
+		bool m_decode;
+		map<string, DataBuffer> m_params;
+		DataBuffer m_input;
+
+	  public:
+		BufferedTransformContext(Transform* xform, bool decode, const map<string, DataBuffer>& params) :
+		    m_transform(xform), m_decode(decode), m_params(params)
+		{}
+
+		virtual bool Update(const void* data, size_t len, DataBuffer&) override
+		{
+			m_input.Append(data, len);
+			return true;
+		}
+
+		virtual bool Finish(DataBuffer& output) override
+		{
+			DataBuffer result;
+			bool ok = m_decode ? m_transform->Decode(m_input, result, m_params) :
+			                     m_transform->Encode(m_input, result, m_params);
+			m_input.Clear();
+			if (!ok)
+				return false;
+			output.Append(result);
+			return true;
+		}
+	};
+}
+
+
 Transform::Transform(BNTransform* xform)
 {
 	m_object = xform;
@@ -219,9 +262,31 @@ bool Transform::Encode(const DataBuffer&, DataBuffer&, const map<string, DataBuf
 }
 
 
+unique_ptr<TransformContext> Transform::BeginDecode(const map<string, DataBuffer>& params)
+{
+	return make_unique<BufferedTransformContext>(this, true, params);
+}
+
+
+unique_ptr<TransformContext> Transform::BeginEncode(const map<string, DataBuffer>& params)
+{
+	return make_unique<BufferedTransformContext>(this, false, params);
+}
+
+
 CoreTransform::CoreTransform(BNTransform* xform) : Transform(xform) {}
 
 
+unique_ptr<TransformContext> CoreTransform::BeginDecode(const map<string, DataBuffer>& params)
+{
+	// The core's xz transform takes no parameters and its container can be split into independent blocks
+	string name = GetName();
+	if (params.empty() && name.size() == 2 && tolower(name[0]) == 'x' && tolower(name[1]) == 'z')
+		return make_unique<XzDecodeContext>();
+	return Transform::BeginDecode(params);
+}
+
+
 vector<TransformParameter> CoreTransform::GetParameters() const
 {
 	size_t count;
@@ -275,3 +340,513 @@ bool CoreTransform::Encode(const DataBuffer& input, DataBuffer& output, const ma
 	delete[] list;
 	return result;
 }
+
+
+static constexpr uint8_t XzStreamMagic[6] = {0xfd, '7', 'z', 'X', 'Z', 0};
+static constexpr size_t XzStreamHeaderSize = 12;
+static constexpr size_t XzStreamFooterSize = 12;
+static constexpr size_t XzMaxVliSize = 9;
+// Upper bound on the decompressed size of one parallel batch
+static constexpr uint64_t XzMaxBatchOutput = 0x10000000;
+
+
+static uint32_t XzCrc32(const uint8_t* data, size_t len)
+{
+	static const auto table = []() {
+		array<uint32_t, 256> result;
+		for (uint32_t i = 0; i < 256; i++)
+		{
+			uint32_t crc = i;
+			for (int bit = 0; bit < 8; bit++)
+				crc = (crc & 1) ? ((crc >> 1) ^ 0xedb88320) : (crc >> 1);
+			result[i] = crc;
+		}
+		return result;
+	}();
+
+	uint32_t crc = 0xffffffff;
+	for (size_t i = 0; i < len; i++)
+		crc = table[(crc ^ data[i]) & 0xff] ^ (crc >> 8);
+	return crc ^ 0xffffffff;
+}
+
+
+static size_t XzCheckSize(uint8_t checkType)
+{
+	// Check sizes are assigned in groups of three check IDs
+	if (checkType == 0)
+		return 0;
+	return (size_t)4 << ((checkType - 1) / 3);
+}
+
+
+// Returns the number of bytes consumed, or zero if the value is incomplete or invalid
+static size_t ReadXzVli(const uint8_t* data, size_t avail, uint64_t& value)
+{
+	value = 0;
+	for (size_t i = 0; i < avail && i < XzMaxVliSize; i++)
+	{
+		value |= (uint64_t)(data[i] & 0x7f) << (i * 7);
+		if (!(data[i] & 0x80))
+			return i + 1;
+	}
+	return 0;
+}
+
+
+static void WriteXzVli(vector<uint8_t>& out, uint64_t value)
+{
+	while (value >= 0x80)
+	{
+		out.push_back((uint8_t)(value | 0x80));
+		value >>= 7;
+	}
+	out.push_back((uint8_t)value);
+}
+
+
+static void WriteXzLE32(vector<uint8_t>& out, uint32_t value)
+{
+	for (int i = 0; i < 4; i++)
+		out.push_back((uint8_t)(value >> (i * 8)));
+}
+
+
+static uint32_t ReadXzLE32(const uint8_t* data)
+{
+	return data[0] | (data[1] << 8) | (data[2] << 16) | ((uint32_t)data[3] << 24);
+}
+
+
+// Appends an index listing the given (unpadded size, uncompressed size) records and the stream footer
+static void WriteXzIndexAndFooter(
+    vector<uint8_t>& out, const vector<pair<uint64_t, uint64_t>>& records, const uint8_t* streamFlags)
+{
+	vector<uint8_t> index;
+	index.push_back(0);
+	WriteXzVli(index, records.size());
+	for (auto& [unpaddedSize, uncompressedSize] : records)
+	{
+		WriteXzVli(index, unpaddedSize);
+		WriteXzVli(index, uncompressedSize);
+	}
+	while (index.size() % 4)
+		index.push_back(0);
+	WriteXzLE32(index, XzCrc32(index.data(), index.size()));
+
+	vector<uint8_t> footer;
+	WriteXzLE32(footer, 0);
+	WriteXzLE32(footer, (uint32_t)(index.size() / 4 - 1));
+	footer.push_back(streamFlags[0]);
+	footer.push_back(streamFlags[1]);
+	uint32_t footerCrc = XzCrc32(footer.data() + 4, 6);
+	for (int i = 0; i < 4; i++)
+		footer[i] = (uint8_t)(footerCrc >> (i * 8));
+	footer.push_back('Y');
+	footer.push_back('Z');
+
+	out.insert(out.end(), index.begin(), index.end());
+	out.insert(out.end(), footer.begin(), footer.end());
+}
+
+
+struct XzDecodeContext::DecoderState
+{
+	enum ParseState
+	{
+		StreamHeader,
+		Block,
+		Index,
+		StreamPadding,
+		Unsplittable,
+		Failed
+	};
+
+	struct BlockJob
+	{
+		size_t offset;
+		size_t size;
+		uint64_t unpaddedSize;
+		uint64_t uncompressedSize;
+	};
+
+	size_t batchSize;
+	ParseState state = StreamHeader;
+	bool sawStream = false;
+
+	// Header of the current stream followed by the input that has not been decoded yet. Blocks are dropped once
+	// they have been decoded, so only the header and the blocks of the pending batch are kept.
+	vector<uint8_t> stream;
+	size_t pos = 0;
+	uint8_t checkType = 0;
+	uint64_t paddingSize = 0;
+
+	vector<BlockJob> jobs;
+	uint64_t jobsOutputSize = 0;
+	vector<pair<uint64_t, uint64_t>> blockSizes;
+
+	// Index parsing resumes where it stopped when more input is needed
+	size_t indexCursor = 0;
+	uint64_t indexRecordsLeft = 0;
+	size_t indexRecord = 0;
+
+	bool Fail()
+	{
+		state = Failed;
+		stream.clear();
+		jobs.clear();
+		return false;
+	}
+
+	DataBuffer SynthesizeStream(const BlockJob& job) const
+	{
+		// Wrap the block in a stream of its own: the original header, the block, a one entry index and a footer
+		vector<uint8_t> trailer;
+		WriteXzIndexAndFooter(trailer, {{job.unpaddedSize, job.uncompressedSize}}, stream.data() + 6);
+
+		DataBuffer result;
+		result.Append(stream.data(), XzStreamHeaderSize);
+		result.Append(stream.data() + job.offset, job.size);
+		result.Append(trailer.data(), trailer.size());
+		return result;
+	}
+
+	bool FlushJobs(DataBuffer& output)
+	{
+		if (jobs.empty())
+			return true;
+
+		// Blocks are decoded by the calling thread and by workers from the pool, each claiming the next block. Workers
+		// that only start once every block has been claimed return without touching the results, so only workers
+		// that did start are waited for.
+		struct FlushState
+		{
+			mutex lock;
+			condition_variable done;
+			bool closed = false;
+			size_t active = 0;
+			atomic<size_t> next {0};
+		};
+
+		vector<DataBuffer> results(jobs.size());
+		vector<uint8_t> decoded(jobs.size(), 0);
+		auto state = make_shared<FlushState>();
+		auto work = [this, &results, &decoded](FlushState& state) {
+			for (size_t i = state.next.fetch_add(1); i < jobs.size(); i = state.next.fetch_add(1))
+			{
+				DataBuffer input = SynthesizeStream(jobs[i]);
+				decoded[i] = input.XzDecompress(results[i]) && results[i].GetLength() == jobs[i].uncompressedSize;
+			}
+		};
+
+		size_t workers = min(GetWorkerThreadCount(), jobs.size() - 1);
+		for (size_t i = 0; i < workers; i++)
+		{
+			WorkerEnqueue([state, work]() {
+				{
+					unique_lock<mutex> lock(state->lock);
+					if (state->closed)
+						return;
+					state->active++;
+				}
+				work(*state);
+				unique_lock<mutex> lock(state->lock);
+				if (--state->active == 0)
+					state->done.notify_all();
+			}, "XzDecompress");
+		}
+
+		work(*state);
+		{
+			unique_lock<mutex> lock(state->lock);
+			state->closed = true;
+			state->done.wait(lock, [&]() { return state->active == 0; });
+		}
+
+		for (size_t i = 0; i < jobs.size(); i++)
+		{
+			if (!decoded[i])
+				return Fail();
+		}
+		for (auto& i : results)
+			output.Append(i);
+
+		// Only the stream header is needed to wrap the blocks that follow
+		stream.erase(stream.begin() + XzStreamHeaderSize, stream.begin() + pos);
+		pos = XzStreamHeaderSize;
+		jobs.clear();
+		jobsOutputSize = 0;
+		return true;
+	}
+
+	bool DecodeRemainder(DataBuffer& output)
+	{
+		// The rest of the input starts at a block without recorded sizes. If no blocks of this stream were decoded
+		// yet, the stream is still complete and the core can decode it as is.
+		if (blockSizes.empty())
+		{
+			DataBuffer input(stream.data(), stream.size());
+			DataBuffer result;
+			if (!input.XzDecompress(result))
+				return false;
+			output.Append(result);
+			return true;
+		}
+
+		// Otherwise the decoded blocks are gone, so the stream is rebuilt with an index that leaves them out. The
+		// footer is recognized by its own check and by the check of the index it points at.
+		for (size_t end = pos + XzStreamFooterSize; end <= stream.size(); end++)
+		{
+			const uint8_t* footer = stream.data() + end - XzStreamFooterSize;
+			if (footer[10] != 'Y' || footer[11] != 'Z' || footer[8] != stream[6] || footer[9] != stream[7]
+			    || XzCrc32(footer + 4, 6) != ReadXzLE32(footer))
+				continue;
+			uint64_t indexSize = ((uint64_t)ReadXzLE32(footer + 4) + 1) * 4;
+			if (indexSize > (uint64_t)(end - XzStreamFooterSize - pos))
+				continue;
+			size_t indexStart = end - XzStreamFooterSize - (size_t)indexSize;
+			const uint8_t* index = stream.data() + indexStart;
+			if (index[0] != 0 || XzCrc32(index, (size_t)indexSize - 4) != ReadXzLE32(index + indexSize - 4))
+				continue;
+
+			uint64_t recordCount;
+			size_t avail = (size_t)indexSize - 4;
+			size_t cursor = 1;
+			size_t n = ReadXzVli(index + cursor, avail - cursor, recordCount);
+			if (!n || recordCount < blockSizes.size())
+				return false;
+			cursor += n;
+
+			vector<pair<uint64_t, uint64_t>> records;
+			for (uint64_t i = 0; i < recordCount; i++)
+			{
+				uint64_t unpadded, uncompressed;
+				n = ReadXzVli(index + cursor, avail - cursor, unpadded);
+				size_t m = n ? ReadXzVli(index + cursor + n, avail - cursor - n, uncompressed) : 0;
+				if (!n || !m)
+					return false;
+				cursor += n + m;
+				if (i < blockSizes.size())
+				{
+					if (blockSizes[i].first != unpadded || blockSizes[i].second != uncompressed)
+						return false;
+				}
+				else
+				{
+					records.emplace_back(unpadded, uncompressed);
+				}
+			}
+
+			vector<uint8_t> trailer;
+			WriteXzIndexAndFooter(trailer, records, stream.data() + 6);
+
+			// Anything after this stream is padding or further streams, which the core decodes along with it
+			DataBuffer input;
+			input.Append(stream.data(), XzStreamHeaderSize);
+			input.Append(stream.data() + pos, indexStart - pos);
+			input.Append(trailer.data(), trailer.size());
+			input.Append(stream.data() + end, stream.size() - end);
+			DataBuffer result;
+			if (!input.XzDecompress(result))
+				return false;
+			output.Append(result);
+			return true;
+		}
+		return false;
+	}
+
+	bool ParseIndex()
+	{
+		// Returns false when more input is needed, sets the Failed state on invalid input
+		if (indexCursor == 0)
+		{
+			uint64_t records;
+			size_t n = ReadXzVli(stream.data() + pos + 1, stream.size() - pos - 1, records);
+			if (!n)
+			{
+				if (stream.size() - pos - 1 >= XzMaxVliSize)
+					Fail();
+				return false;
+			}
+			if (records != blockSizes.size())
+				return Fail();
+			indexCursor = pos + 1 + n;
+			indexRecordsLeft = records;
+			indexRecord = 0;
+		}
+
+		while (indexRecordsLeft)
+		{
+			uint64_t unpadded, uncompressed;
+			size_t avail = stream.size() - indexCursor;
+			size_t n = ReadXzVli(stream.data() + indexCursor, avail, unpadded);
+			size_t m = n ? ReadXzVli(stream.data() + indexCursor + n, avail - n, uncompressed) : 0;
+			if (!n || !m)
+			{
+				if (avail >= XzMaxVliSize * 2)
+					Fail();
+				return false;
+			}
+			if (blockSizes[indexRecord].first != unpadded || blockSizes[indexRecord].second != uncompressed)
+				return Fail();
+			indexCursor += n + m;
+			indexRecord++;
+			indexRecordsLeft--;
+		}
+
+		size_t indexSize = ((indexCursor - pos + 3) & ~(size_t)3) + 4;
+		if (stream.size() - pos < indexSize + XzStreamFooterSize)
+			return false;
+		const uint8_t* index = stream.data() + pos;
+		const uint8_t* footer = index + indexSize;
+		if (XzCrc32(index, indexSize - 4) != ReadXzLE32(footer - 4) || ReadXzLE32(footer + 4) != indexSize / 4 - 1
+		    || footer[8] != stream[6] || footer[9] != stream[7] || footer[10] != 'Y' || footer[11] != 'Z')
+			return Fail();
+
+		stream.erase(stream.begin(), stream.begin() + pos + indexSize + XzStreamFooterSize);
+		pos = 0;
+		paddingSize = 0;
+		blockSizes.clear();
+		indexCursor = 0;
+		state = StreamPadding;
+		return true;
+	}
+
+	bool Process(DataBuffer& output)
+	{
+		while (true)
+		{
+			switch (state)
+			{
+			case StreamHeader:
+				if (stream.size() - pos < XzStreamHeaderSize)
+					return true;
+				if (memcmp(stream.data() + pos, XzStreamMagic, sizeof(XzStreamMagic)) != 0 || stream[pos + 6] != 0
+				    || (stream[pos + 7] & 0xf0) != 0
+				    || XzCrc32(stream.data() + pos + 6, 2) != ReadXzLE32(stream.data() + pos + 8))
+					return Fail();
+				checkType = stream[pos + 7];
+				sawStream = true;
+				pos += XzStreamHeaderSize;
+				state = Block;
+				break;
+
+			case Block:
+			{
+				if (pos >= stream.size())
+					return true;
+				if (stream[pos] == 0)
+				{
+					if (!FlushJobs(output))
+						return false;
+					state = Index;
+					break;
+				}
+
+				size_t headerSize = ((size_t)stream[pos] + 1) * 4;
+				if (stream.size() - pos < headerSize)
+					return true;
+				if ((stream[pos + 1] & 0xc0) != 0xc0)
+				{
+					// Without sizes in the header the end of the block can only be found by decompressing it
+					if (!FlushJobs(output))
+						return false;
+					state = Unsplittable;
+					return true;
+				}
+
+				uint64_t compressedSize, uncompressedSize;
+				size_t n = ReadXzVli(stream.data() + pos + 2, headerSize - 2, compressedSize);
+				size_t m = n ? ReadXzVli(stream.data() + pos + 2 + n, headerSize - 2 - n, uncompressedSize) : 0;
+				if (!n || !m || compressedSize == 0 || compressedSize > (1ull << 62))
+					return Fail();
+
+				uint64_t unpaddedSize = headerSize + compressedSize + XzCheckSize(checkType);
+				uint64_t blockSize = headerSize + ((compressedSize + 3) & ~3ull) + XzCheckSize(checkType);
+				if (stream.size() - pos < blockSize)
+					return true;
+
+				jobs.push_back({pos, (size_t)blockSize, unpaddedSize, uncompressedSize});
+				blockSizes.emplace_back(unpaddedSize, uncompressedSize);
+				jobsOutputSize += uncompressedSize;
+				pos += (size_t)blockSize;
+				if (jobs.size() >= batchSize || jobsOutputSize >= XzMaxBatchOutput)
+				{
+					if (!FlushJobs(output))
+						return false;
+				}
+				break;
+			}
+
+			case Index:
+				if (!ParseIndex())
+					return state != Failed;
+				break;
+
+			case StreamPadding:
+			{
+				size_t start = pos;
+				while (pos < stream.size() && stream[pos] == 0)
+					pos++;
+				paddingSize += pos - start;
+				stream.erase(stream.begin(), stream.begin() + pos);
+				pos = 0;
+				if (stream.empty())
+					return true;
+				if (paddingSize % 4)
+					return Fail();
+				state = StreamHeader;
+				break;
+			}
+
+			case Unsplittable:
+				return true;
+
+			case Failed:
+				return false;
+			}
+		}
+	}
+};
+
+
+XzDecodeContext::XzDecodeContext(size_t batchSize) : m_state(make_unique<DecoderState>())
+{
+	if (batchSize == 0)
+		batchSize = max<size_t>(GetWorkerThreadCount(), 1);
+	m_state->batchSize = batchSize;
+}
+
+
+XzDecodeContext::~XzDecodeContext() {}
+
+
+bool XzDecodeContext::Update(const void* data, size_t len, DataBuffer& output)
+{
+	if (m_state->state == DecoderState::Failed)
+		return false;
+	m_state->stream.insert(m_state->stream.end(), (const uint8_t*)data, (const uint8_t*)data + len);
+	return m_state->Process(output);
+}
+
+
+bool XzDecodeContext::Finish(DataBuffer& output)
+{
+	DecoderState& state = *m_state;
+	if (state.state == DecoderState::Failed)
+		return false;
+
+	if (state.state == DecoderState::Unsplittable)
+	{
+		if (!state.DecodeRemainder(output))
+			return state.Fail();
+		state.stream.clear();
+		state.state = DecoderState::StreamPadding;
+		return true;
+	}
+
+	// Anything other than complete streams followed by valid padding is truncated input
+	if (!state.sawStream || state.state != DecoderState::StreamPadding || (state.paddingSize % 4) != 0)
+		return state.Fail();
+	return true;
+}
@@ -1189,9 +1189,9 @@ bool ElfView::Init()
 		m_logger->LogError("ELF symbol table invalid");
 	}
 
-	// No longer need to look up symbols during creation, start a parallelized queue for
-	// demangling and preparing symbols.
-	m_symbolQueue = new SymbolQueue();
+	// No longer need to look up symbols during creation, collect symbols so that they can be
+	// demangled in parallel and defined in bulk.
+	m_symbolTable.Defer();
 
 	// Now define symbols and resolve relocations
 	vector<ElfSymbolTableEntry> combinedSymbolTable;
@@ -1368,12 +1368,10 @@ bool ElfView::Init()
 		}
 	}
 
-	ParseMiniDebugInfo();
+	ParseMiniDebugInfo(imageBaseAdjustment);
 
-	// Process the queued symbols
-	m_symbolQueue->Process();
-	delete m_symbolQueue;
-	m_symbolQueue = nullptr;
+	// Define the collected symbols
+	m_symbolTable.Define(m_arch, m_extractMangledTypes);
 
 	EndBulkModifySymbols();
 
@@ -2476,59 +2474,14 @@ void ElfView::DefineElfSymbol(BNSymbolType type, const string& incomingName, uin
 	if (gotEntry)
 		m_gotEntryLocations.emplace(addr);
 
-	auto process = [=]() {
-		NameSpace nameSpace = GetInternalNameSpace();
-		if (type == ExternalSymbol)
-		{
-			nameSpace = GetExternalNameSpace();
-		}
-
-		// If name does not start with alphabetic character or symbol, prepend an underscore
-		string rawName = name;
-		if (!(((name[0] >= 'A') && (name[0] <= 'Z')) || ((name[0] >= 'a') && (name[0] <= 'z')) || (name[0] == '_')
-				|| (name[0] == '?') || (name[0] == '$') || (name[0] == '@') || (name[0] == '.')))
-			rawName = "_" + name;
-
-		// Try to demangle any C++ symbols
-		string shortName = rawName;
-		string fullName = rawName;
-		Ref<Type> typeRef = symbolTypeRef;
-		if (m_arch)
-		{
-			QualifiedName demangledName;
-			Ref<Type> demangledType;
-			bool simplify = Settings::Instance()->Get<bool>("analysis.types.templateSimplifier", this);
-			if (DemangleGeneric(m_arch, rawName, demangledType, demangledName, this, simplify))
-			{
-				shortName = demangledName.GetString();
-				fullName = shortName;
-				if (demangledType)
-					fullName += demangledType->GetStringAfterName();
-				if (!typeRef && m_extractMangledTypes && !GetDefaultPlatform()->GetFunctionByName(rawName))
-					typeRef = demangledType;
-			}
-		}
-
-		if (!typeRef && (size > 0 && size <= 8))
-		{
-			typeRef = Type::IntegerType(size, false);
-		}
-
-		return std::pair<Ref<Symbol>, Ref<Type>>(
-			new Symbol(type, shortName, fullName, rawName, addr, binding, nameSpace), typeRef);
-	};
-
-	if (m_symbolQueue)
-	{
-		m_symbolQueue->Append(process, [this](Symbol* symbol, Type* type) {
-			DefineAutoSymbolAndVariableOrFunction(GetDefaultPlatform(), symbol, type);
-		});
-	}
-	else
-	{
-		auto result = process();
-		DefineAutoSymbolAndVariableOrFunction(GetDefaultPlatform(), result.first, result.second);
-	}
+	LoaderSymbol symbol;
+	symbol.type = type;
+	symbol.name = name;
+	symbol.address = addr;
+	symbol.binding = binding;
+	symbol.variableType = symbolTypeRef;
+	symbol.size = size;
+	m_symbolTable.Add(std::move(symbol), m_arch, m_extractMangledTypes);
 }
 
 
@@ -2652,40 +2605,127 @@ bool ElfView::DerefPpc64Descriptor(BinaryReader& reader, uint64_t addr, uint64_t
 }
 
 
-void ElfView::ParseMiniDebugInfo()
+void ElfView::ParseMiniDebugInfo(int64_t imageBaseAdjustment)
 {
+	// Size of the chunks of compressed data handed to the decoder
+	static constexpr size_t MiniDebugInfoChunkSize = 0x100000;
+
 	Ref<Section> gnuDebugdata = GetParentView()->GetSectionByName(".gnu_debugdata");
 	if (!gnuDebugdata)
 		return;
 
-	BinaryReader debugdataReader(GetParentView());
-	debugdataReader.Seek(gnuDebugdata->GetStart());
-
-	DataBuffer compressedDebug = debugdataReader.Read(gnuDebugdata->GetLength());
-
+	// Stream the section through the decoder, which decompresses independent xz blocks in parallel
+	XzDecodeContext decoder;
 	DataBuffer debugElf;
-	if (!compressedDebug.XzDecompress(debugElf))
+	vector<uint8_t> chunk;
+	for (uint64_t offset = 0; offset < gnuDebugdata->GetLength(); offset += chunk.size())
+	{
+		chunk.resize((size_t)min<uint64_t>(MiniDebugInfoChunkSize, gnuDebugdata->GetLength() - offset));
+		size_t len = GetParentView()->Read(chunk.data(), gnuDebugdata->GetStart() + offset, chunk.size());
+		if (len != chunk.size() || !decoder.Update(chunk.data(), len, debugElf))
+		{
+			m_logger->LogError("Invalid .gnu_debugdata contents: Failed to decompress");
+			return;
+		}
+	}
+	if (!decoder.Finish(debugElf))
 	{
 		m_logger->LogError("Invalid .gnu_debugdata contents: Failed to decompress");
 		return;
 	}
 
-	Ref<BinaryView> debugBv = Load(debugElf, false);
-	if (!debugBv)
+	// The embedded image is only used for its symbol table, so read .symtab and its string table directly instead
+	// of loading it as a BinaryView
+	const uint8_t* data = (const uint8_t*)debugElf.GetData();
+	size_t length = debugElf.GetLength();
+	auto readField = [&](uint64_t offset, size_t size) {
+		if (offset > length || size > length - offset)
+			throw ReadException();
+		uint64_t value = 0;
+		for (size_t i = 0; i < size; i++)
+		{
+			size_t byte = (m_endian == LittleEndian) ? (size - 1 - i) : i;
+			value = (value << 8) | data[offset + byte];
+		}
+		return value;
+	};
+
+	try
 	{
-		m_logger->LogError("Invalid .gnu_debugdata contents: Failed to create BinaryView");
-		return;
-	}
+		if (length < 0x34 || memcmp(data, "\x7f" "ELF", 4) != 0 || data[4] != (m_elf32 ? 1 : 2)
+			|| data[5] != ((m_endian == LittleEndian) ? 1 : 2))
+		{
+			m_logger->LogError("Invalid .gnu_debugdata contents: Embedded image does not match this ELF");
+			return;
+		}
+
+		size_t addrSize = m_elf32 ? 4 : 8;
+		uint64_t sectionTableOffset = readField(m_elf32 ? 0x20 : 0x28, addrSize);
+		uint64_t sectionEntrySize = readField(m_elf32 ? 0x2e : 0x3a, 2);
+		uint64_t sectionCount = readField(m_elf32 ? 0x30 : 0x3c, 2);
+		if (sectionEntrySize < (m_elf32 ? 0x28 : 0x40))
+			throw ReadException();
+
+		auto readSection = [&](uint64_t index) {
+			uint64_t base = sectionTableOffset + index * sectionEntrySize;
+			Elf64SectionHeader section;
+			section.name = (uint32_t)readField(base, 4);
+			section.type = (uint32_t)readField(base + 4, 4);
+			section.offset = readField(base + (m_elf32 ? 0x10 : 0x18), addrSize);
+			section.size = readField(base + (m_elf32 ? 0x14 : 0x20), addrSize);
+			section.link = (uint32_t)readField(base + (m_elf32 ? 0x18 : 0x28), 4);
+			return section;
+		};
+
+		for (uint64_t i = 0; i < sectionCount; i++)
+		{
+			Elf64SectionHeader symbolTable = readSection(i);
+			if (symbolTable.type != ELF_SHT_SYMTAB || symbolTable.link >= sectionCount)
+				continue;
+			Elf64SectionHeader stringTable = readSection(symbolTable.link);
+			if (stringTable.type != ELF_SHT_STRTAB || stringTable.offset > length
+				|| stringTable.size > length - stringTable.offset)
+				continue;
+
+			const char* strings = (const char*)data + stringTable.offset;
+			size_t symbolSize = m_elf32 ? 16 : 24;
+			for (uint64_t sym = 1; sym < symbolTable.size / symbolSize; sym++)
+			{
+				uint64_t base = symbolTable.offset + sym * symbolSize;
+				uint64_t nameOffset = readField(base, 4);
+				uint8_t info = (uint8_t)readField(base + (m_elf32 ? 12 : 4), 1);
+				uint64_t section = readField(base + (m_elf32 ? 14 : 6), 2);
+				uint64_t value = readField(base + (m_elf32 ? 4 : 8), addrSize);
+
+				if (section == ELF_SHN_UNDEF || nameOffset >= stringTable.size)
+					continue;
+				size_t nameLen = strnlen(strings + nameOffset, (size_t)(stringTable.size - nameOffset));
+				if (nameLen == 0 || nameLen == stringTable.size - nameOffset || strings[nameOffset] == '$')
+					continue;
+
+				BNSymbolType type;
+				switch (ELF_ST_TYPE(info))
+				{
+				case ELF_STT_FUNC:
+				case ELF_STT_GNU_IFUNC:
+					type = FunctionSymbol;
+					break;
+				case ELF_STT_OBJECT:
+				case ELF_STT_NOTYPE:
+					type = DataSymbol;
+					break;
+				default:
+					continue;
+				}
 
-	for (const auto& symbol : debugBv->GetSymbols())
+				DefineElfSymbol(type, string(strings + nameOffset, nameLen), value + imageBaseAdjustment, false,
+					TranslateELFBindingType(ELF_ST_BIND(info)));
+			}
+		}
+	}
+	catch (ReadException&)
 	{
-		DefineElfSymbol(
-			symbol->GetType(),
-			symbol->GetRawName(),
-			GetStart() + symbol->GetAddress(),
-			false,
-			symbol->GetBinding()
-		);
+		m_logger->LogError("Invalid .gnu_debugdata contents: Truncated embedded ELF");
 	}
 }
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "binaryninjaapi.h"
+#include "../loadersymboltable.h"
 #include <exception>
 
 #define ELF_PT_NULL    0
@@ -515,7 +516,7 @@ namespace BinaryNinja
 		uint64_t m_hashHeader = 0;
 		uint64_t m_gnuHashHeader = 0;
 
-		SymbolQueue* m_symbolQueue = nullptr;
+		LoaderSymbolTable m_symbolTable {this, "_?$@."};
 
 		void DefineElfSymbol(BNSymbolType type, const std::string& name, uint64_t addr, bool gotEntry,
 			BNSymbolBinding binding, size_t size=0, Ref<Type> typeObj=nullptr);
@@ -539,7 +540,7 @@ namespace BinaryNinja
 			bool implicit, std::vector<ELFRelocEntry>& result);
 		bool DerefPpc64Descriptor(BinaryReader& reader, uint64_t addr, uint64_t& result);
 
-		void ParseMiniDebugInfo();
+		void ParseMiniDebugInfo(int64_t imageBaseAdjustment);
 	public:
 		ElfView(BinaryView* data, bool parseOnly = false);
 		~ElfView();
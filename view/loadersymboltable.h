@@ -0,0 +1,136 @@
+#pragma once
+
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "binaryninjaapi.h"
+
+// Symbol table shared by the ELF, Mach-O and PE view plugins. The naming policy here (prefixing names that do not
+// start with a letter, falling back to an integer type of the symbol's size) belongs to these loaders rather than to
+// the API, so it is kept out of binaryninjaapi.h.
+namespace BinaryNinja
+{
+	// A symbol found by a loader, before its name has been demangled
+	struct LoaderSymbol
+	{
+		BNSymbolType type = DataSymbol;
+		std::string name;  // Name as found in the binary
+		uint64_t address = 0;
+		BNSymbolBinding binding = NoBinding;
+		uint64_t ordinal = 0;
+		std::optional<NameSpace> nameSpace;  // Namespace of a non-external symbol, the view's internal namespace when unset
+		Ref<Type> variableType;
+		size_t size = 0;  // Size of the data at the symbol, an unsigned integer type of this size is used when no other type is known
+	};
+
+	// Loaders add the symbols they find while parsing their symbol tables. Between Defer and Define they are
+	// collected, then their names are demangled on the worker thread pool and they are defined in the order they
+	// were added. Outside of that window each symbol is resolved and defined as soon as it is added.
+	class LoaderSymbolTable
+	{
+		BinaryView* m_view;
+		Ref<Logger> m_logger;
+		std::string m_nameStartCharacters;
+		std::vector<LoaderSymbol> m_pending;
+		bool m_deferring = false;
+
+	  public:
+		// nameStartCharacters are the characters besides letters that a name may start with, other names are
+		// prefixed with an underscore
+		LoaderSymbolTable(BinaryView* view, const std::string& nameStartCharacters = "_?$@") :
+		    m_view(view), m_nameStartCharacters(nameStartCharacters)
+		{}
+
+		// Logger for names that fail to demangle, or nullptr to not log failures
+		void SetLogger(Ref<Logger> logger) { m_logger = logger; }
+
+		// Collect symbols added from now on until Define is called
+		void Defer() { m_deferring = true; }
+		bool IsDeferring() const { return m_deferring; }
+
+		// Add a symbol, defining it immediately unless symbols are being collected
+		void Add(LoaderSymbol&& symbol, Architecture* arch, bool extractMangledTypes)
+		{
+			if (m_deferring)
+			{
+				m_pending.push_back(std::move(symbol));
+				return;
+			}
+
+			SymbolSpec result;
+			bool simplify = Settings::Instance()->Get<bool>("analysis.types.templateSimplifier", m_view);
+			Resolve(symbol, result, arch, extractMangledTypes, m_view->GetInternalNameSpace(),
+			    m_view->GetExternalNameSpace(), simplify);
+			m_view->DefineAutoSymbols({result}, m_view->GetDefaultPlatform());
+		}
+
+		// Demangle the name of a symbol and fill in the symbol to define
+		void Resolve(const LoaderSymbol& symbol, SymbolSpec& result, Architecture* arch, bool extractMangledTypes,
+		    const NameSpace& internalNameSpace, const NameSpace& externalNameSpace, bool simplify) const
+		{
+			const std::string& name = symbol.name;
+
+			// If name does not start with alphabetic character or symbol, prepend an underscore
+			std::string rawName = name;
+			if (!(((name[0] >= 'A') && (name[0] <= 'Z')) || ((name[0] >= 'a') && (name[0] <= 'z'))
+					|| ((name[0] != '\0') && (m_nameStartCharacters.find(name[0]) != std::string::npos))))
+				rawName = "_" + name;
+
+			// Try to demangle any C++ symbols
+			std::string shortName = rawName;
+			std::string fullName = rawName;
+			Ref<Type> typeRef = symbol.variableType;
+			if (arch && !name.empty())
+			{
+				QualifiedName demangledName;
+				Ref<Type> demangledType;
+				if (DemangleGeneric(arch, rawName, demangledType, demangledName, m_view, simplify))
+				{
+					shortName = demangledName.GetString();
+					fullName = shortName;
+					if (demangledType)
+						fullName += demangledType->GetStringAfterName();
+					if (!typeRef && extractMangledTypes && !m_view->GetDefaultPlatform()->GetFunctionByName(rawName))
+						typeRef = demangledType;
+				}
+				else if (m_logger)
+				{
+					m_logger->LogDebug("Failed to demangle name: '%s'", rawName.c_str());
+				}
+			}
+
+			if (!typeRef && (symbol.size > 0 && symbol.size <= 8))
+				typeRef = Type::IntegerType(symbol.size, false);
+
+			result.type = symbol.type;
+			result.shortName = std::move(shortName);
+			result.fullName = std::move(fullName);
+			result.rawName = std::move(rawName);
+			result.address = symbol.address;
+			result.binding = symbol.binding;
+			if (symbol.type == ExternalSymbol)
+				result.nameSpace = externalNameSpace;
+			else
+				result.nameSpace = symbol.nameSpace ? *symbol.nameSpace : internalNameSpace;
+			result.ordinal = symbol.ordinal;
+			result.variableType = typeRef;
+		}
+
+		// Demangle and define every collected symbol, then stop collecting
+		void Define(Architecture* arch, bool extractMangledTypes)
+		{
+			m_deferring = false;
+			std::vector<LoaderSymbol> pending = std::move(m_pending);
+			m_pending.clear();
+
+			NameSpace internalNameSpace = m_view->GetInternalNameSpace();
+			NameSpace externalNameSpace = m_view->GetExternalNameSpace();
+			bool simplify = Settings::Instance()->Get<bool>("analysis.types.templateSimplifier", m_view);
+			m_view->DefineAutoSymbols(pending.size(), [&](size_t i, SymbolSpec& symbol) {
+				Resolve(pending[i], symbol, arch, extractMangledTypes, internalNameSpace, externalNameSpace, simplify);
+				return true;
+			}, m_view->GetDefaultPlatform());
+		}
+	};
+}
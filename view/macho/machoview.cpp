@@ -204,6 +204,7 @@ MachoView::MachoView(const string& typeName, BinaryView* data, bool parseOnly):
 {
 	CreateLogger("BinaryView");
 	m_logger = CreateLogger("BinaryView.MachoView");
+	m_symbolTable.SetLogger(m_logger);
 
 	m_backedByDatabase = data->GetFile()->IsBackedByDatabase(typeName);
 
@@ -2031,7 +2032,7 @@ bool MachoView::InitializeHeader(MachOHeader& header, bool isMainHeader, uint64_
 	}
 
 	BeginBulkModifySymbols();
-	m_symbolQueue = new SymbolQueue();
+	m_symbolTable.Defer();
 
 	try
 	{
@@ -2044,9 +2045,7 @@ bool MachoView::InitializeHeader(MachOHeader& header, bool isMainHeader, uint64_
 		m_logger->LogError("Failed to parse symbol table!");
 	}
 
-	m_symbolQueue->Process();
-	delete m_symbolQueue;
-	m_symbolQueue = nullptr;
+	m_symbolTable.Define(m_arch, m_extractMangledTypes);
 
 	EndBulkModifySymbols();
 
@@ -2413,58 +2412,26 @@ Ref<Symbol> MachoView::DefineMachoSymbol(
 
 	}
 
-	auto process = [=]() {
-		// If name does not start with alphabetic character or symbol, prepend an underscore
-		string rawName = name;
-		if (!(((name[0] >= 'A') && (name[0] <= 'Z')) || ((name[0] >= 'a') && (name[0] <= 'z')) || (name[0] == '_')
-				|| (name[0] == '?') || (name[0] == '$') || (name[0] == '@')))
-			rawName = "_" + name;
-
-		NameSpace nameSpace = GetInternalNameSpace();
-		if (type == ExternalSymbol)
-		{
-			nameSpace = GetExternalNameSpace();
-		}
-
-		// Try to demangle any C++ symbols
-		string shortName = rawName;
-		string fullName = rawName;
-		Ref<Type> typeRef = symbolTypeRef;
-
-		if (m_arch)
-		{
-			QualifiedName demangledName;
-			Ref<Type> demangledType;
-			bool simplify = Settings::Instance()->Get<bool>("analysis.types.templateSimplifier", this);
-			if (DemangleGeneric(m_arch, rawName, demangledType, demangledName, this, simplify))
-			{
-				shortName = demangledName.GetString();
-				fullName = shortName;
-				if (demangledType)
-					fullName += demangledType->GetStringAfterName();
-				if (!typeRef && m_extractMangledTypes && !GetDefaultPlatform()->GetFunctionByName(rawName))
-					typeRef = demangledType;
-			}
-			else
-			{
-				m_logger->LogDebug("Failed to demangle name: '%s'\n", rawName.c_str());
-			}
-		}
-
-		return std::pair<Ref<Symbol>, Ref<Type>>(
-			new Symbol(type, shortName, fullName, rawName, addr, binding, nameSpace), typeRef);
-	};
-
-	if (deferred)
+	LoaderSymbol symbol;
+	symbol.type = type;
+	symbol.name = name;
+	symbol.address = addr;
+	symbol.binding = binding;
+	symbol.variableType = symbolTypeRef;
+	if (deferred && m_symbolTable.IsDeferring())
 	{
-		m_symbolQueue->Append(process, [this](Symbol* symbol, Type* type) {
-			DefineAutoSymbolAndVariableOrFunction(GetDefaultPlatform(), symbol, type);
-		});
+		m_symbolTable.Add(std::move(symbol), m_arch, m_extractMangledTypes);
 		return nullptr;
 	}
 
-	auto result = process();
-	return DefineAutoSymbolAndVariableOrFunction(GetDefaultPlatform(), result.first, result.second);
+	SymbolSpec resolved;
+	bool simplify = Settings::Instance()->Get<bool>("analysis.types.templateSimplifier", this);
+	m_symbolTable.Resolve(symbol, resolved, m_arch, m_extractMangledTypes, GetInternalNameSpace(),
+		GetExternalNameSpace(), simplify);
+	return DefineAutoSymbolAndVariableOrFunction(GetDefaultPlatform(),
+		new Symbol(resolved.type, resolved.shortName, resolved.fullName, resolved.rawName, resolved.address,
+			resolved.binding, resolved.nameSpace),
+		resolved.variableType);
 }
 
 bool MachoView::GetSegmentPermissions(MachOHeader& header, uint64_t address, uint32_t &flags)
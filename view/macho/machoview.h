@@ -5,6 +5,7 @@
 #include <string.h>
 
 #include "binaryninjaapi.h"
+#include "../loadersymboltable.h"
 #include "objc.h"
 
 //These are laready defined in one of the osx headers we want to override
@@ -1349,7 +1350,7 @@ namespace BinaryNinja
 		bool m_extractMangledTypes;
 		bool m_simplifyTemplates;
 
-		SymbolQueue* m_symbolQueue = nullptr;
+		LoaderSymbolTable m_symbolTable {this};
 		Ref<Logger> m_logger;
 
 		std::vector<segment_command_64> m_allSegments; //only three types of sections __TEXT, __DATA, __IMPORT
@@ -799,15 +799,25 @@ void ObjCProcessor::ReadMethodList(BinaryReader* reader, ClassBase& cls, std::st
 			// --
 			if (relativeOffsets)
 			{
-				meth.name = cursor + static_cast<int32_t>(reader->Read32());
-				meth.types = cursor + 4 + static_cast<int32_t>(reader->Read32());
-				meth.imp = cursor + 8 + static_cast<int32_t>(reader->Read32());
+				uint32_t nameOffset, typesOffset, impOffset;
+				if (!reader->TryRead32(nameOffset) || !reader->TryRead32(typesOffset) || !reader->TryRead32(impOffset))
+				{
+					m_logger->LogError("Failed to process a method at offset 0x%llx", cursor);
+					continue;
+				}
+				meth.name = cursor + static_cast<int32_t>(nameOffset);
+				meth.types = cursor + 4 + static_cast<int32_t>(typesOffset);
+				meth.imp = cursor + 8 + static_cast<int32_t>(impOffset);
 			}
 			else
 			{
-				meth.name = ReadPointerAccountingForRelocations(reader);
-				meth.types = ReadPointerAccountingForRelocations(reader);
-				meth.imp = ReadPointerAccountingForRelocations(reader);
+				if (!TryReadPointerAccountingForRelocations(reader, meth.name)
+					|| !TryReadPointerAccountingForRelocations(reader, meth.types)
+					|| !TryReadPointerAccountingForRelocations(reader, meth.imp))
+				{
+					m_logger->LogError("Failed to process a method at offset 0x%llx", cursor);
+					continue;
+				}
 			}
 			if (!relativeOffsets || directSelectors)
 			{
@@ -883,14 +893,21 @@ void ObjCProcessor::ReadIvarList(BinaryReader* reader, ClassBase& cls, std::stri
 			ivar_t ivarStruct;
 			uint64_t cursor = start + (sizeof(ivar_list_t)) + (i * ((addressSize * 3) + 8));
 			reader->Seek(cursor);
-			ivarStruct.offset = ReadPointerAccountingForRelocations(reader);
-			ivarStruct.name = ReadPointerAccountingForRelocations(reader);
-			ivarStruct.type = ReadPointerAccountingForRelocations(reader);
-			ivarStruct.alignmentRaw = reader->Read32();
-			ivarStruct.size = reader->Read32();
+			if (!TryReadPointerAccountingForRelocations(reader, ivarStruct.offset)
+				|| !TryReadPointerAccountingForRelocations(reader, ivarStruct.name)
+				|| !TryReadPointerAccountingForRelocations(reader, ivarStruct.type)
+				|| !reader->TryRead32(ivarStruct.alignmentRaw) || !reader->TryRead32(ivarStruct.size))
+			{
+				m_logger->LogError("Failed to process an ivar at offset 0x%llx", cursor);
+				continue;
+			}
 
 			reader->Seek(ivarStruct.offset);
-			ivar.offset = reader->Read32();
+			if (!reader->TryRead32(ivar.offset))
+			{
+				m_logger->LogError("Failed to process an ivar at offset 0x%llx", cursor);
+				continue;
+			}
 			reader->Seek(ivarStruct.name);
 			ivar.name = reader->ReadCString();
 			reader->Seek(ivarStruct.type);
@@ -1184,6 +1201,17 @@ uint64_t ObjCProcessor::ReadPointerAccountingForRelocations(BinaryReader* reader
 	return reader->ReadPointer();
 }
 
+bool ObjCProcessor::TryReadPointerAccountingForRelocations(BinaryReader* reader, uint64_t& result)
+{
+	if (auto it = m_relocationPointerRewrites.find(reader->GetOffset()); it != m_relocationPointerRewrites.end())
+	{
+		reader->SeekRelative(m_data->GetAddressSize());
+		result = it->second;
+		return true;
+	}
+	return reader->TryReadPointer(result);
+}
+
 
 ObjCProcessor::ObjCProcessor(BinaryNinja::BinaryView* data, bool isBackedByDatabase) :
 	m_isBackedByDatabase(isBackedByDatabase), m_data(data)
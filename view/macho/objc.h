@@ -190,6 +190,7 @@ namespace BinaryNinja {
 		// --
 
 		uint64_t ReadPointerAccountingForRelocations(BinaryReader* reader);
+		bool TryReadPointerAccountingForRelocations(BinaryReader* reader, uint64_t& result);
 		std::unordered_map<uint64_t, uint64_t> m_relocationPointerRewrites;
 
 		static Ref<Metadata> SerializeMethod(uint64_t loc, const Method& method);
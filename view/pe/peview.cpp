@@ -396,6 +396,7 @@ PEView::PEView(BinaryView* data, bool parseOnly) : BinaryView("PE", data->GetFil
 {
 	CreateLogger("BinaryView");
 	m_logger = CreateLogger("BinaryView.PEView");
+	m_symbolTable.SetLogger(m_logger);
 	m_backedByDatabase = data->GetFile()->IsBackedByDatabase("PE");
 }
 
@@ -1298,7 +1299,7 @@ bool PEView::Init()
 
 	vector<pair<BNRelocationInfo, string>> relocs;
 	BeginBulkModifySymbols();
-	m_symbolQueue = new SymbolQueue();
+	m_symbolTable.Defer();
 	m_symExternMappingMetadata = new Metadata(KeyValueDataType);
 
 	try
@@ -2568,9 +2569,7 @@ bool PEView::Init()
 		m_logger->LogWarn("Failed to parse export directory: %s\n", e.what());
 	}
 
-	m_symbolQueue->Process();
-	delete m_symbolQueue;
-	m_symbolQueue = nullptr;
+	m_symbolTable.Define(m_arch, m_extractMangledTypes);
 
 	EndBulkModifySymbols();
 
@@ -2955,49 +2954,15 @@ void PEView::AddPESymbol(BNSymbolType type, const string& dll, const string& nam
 		}
 	}
 
-	m_symbolQueue->Append(
-		[=]() {
-			// If name does not start with alphabetic character or symbol, prepend an underscore
-			string rawName = name;
-			if (!(((name[0] >= 'A') && (name[0] <= 'Z')) || ((name[0] >= 'a') && (name[0] <= 'z')) || (name[0] == '_')
-					|| (name[0] == '?') || (name[0] == '$') || (name[0] == '@')))
-				rawName = "_" + name;
-
-			string shortName = rawName;
-			string fullName = rawName;
-			Ref<Type> typeRef = symbolTypeRef;
-
-			if (m_arch && name.size() > 0)
-			{
-				QualifiedName demangledName;
-				Ref<Type> demangledType;
-				bool simplify = Settings::Instance()->Get<bool>("analysis.types.templateSimplifier", this);
-				if (DemangleGeneric(m_arch, rawName, demangledType, demangledName, this, simplify))
-				{
-					shortName = demangledName.GetString();
-					fullName = shortName;
-					if (demangledType)
-						fullName += demangledType->GetStringAfterName();
-					if (!typeRef && m_extractMangledTypes && !GetDefaultPlatform()->GetFunctionByName(rawName))
-						typeRef = demangledType;
-				}
-				else
-				{
-					m_logger->LogDebug("Failed to demangle: '%s'\n", name.c_str());
-				}
-			}
-
-			NameSpace ns(dll);
-			if (type == ExternalSymbol)
-				ns = GetExternalNameSpace();
-
-			return pair<Ref<Symbol>, Ref<Type>>(
-				new Symbol(type, shortName, fullName, rawName, address, binding, ns, ordinal),
-				typeRef);
-		},
-		[this](Symbol* symbol, Type* type) {
-			DefineAutoSymbolAndVariableOrFunction(GetDefaultPlatform(), symbol, type);
-		});
+	LoaderSymbol symbol;
+	symbol.type = type;
+	symbol.name = name;
+	symbol.address = address;
+	symbol.binding = binding;
+	symbol.ordinal = ordinal;
+	symbol.nameSpace = NameSpace(dll);
+	symbol.variableType = symbolTypeRef;
+	m_symbolTable.Add(std::move(symbol), m_arch, m_extractMangledTypes);
 }
 
 
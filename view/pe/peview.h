@@ -1,6 +1,7 @@
 #pragma once
 
 #include "binaryninjaapi.h"
+#include "../loadersymboltable.h"
 #include <exception>
 
 #ifdef WIN32
@@ -461,7 +462,7 @@ namespace BinaryNinja
 		Ref<Logger> m_logger;
 		bool m_relocatable = false;
 
-		SymbolQueue* m_symbolQueue = nullptr;
+		LoaderSymbolTable m_symbolTable {this};
 
 		Ref<Metadata> m_symExternMappingMetadata;
 
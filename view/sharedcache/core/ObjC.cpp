@@ -841,20 +841,36 @@ void DSCObjCProcessor::ReadMethodList(VMReader* reader, ClassBase& cls, std::str
 			// --
 			if (relativeOffsets)
 			{
-				auto selectorBaseOffset = reader->GetOffset();
+				auto selectorBaseOffset = cursor;
 				if (directSelectors && m_customRelativeMethodSelectorBase.has_value()) {
 					selectorBaseOffset = m_customRelativeMethodSelectorBase.value();
 				}
 
-				meth.name = selectorBaseOffset + reader->Read32();
-				meth.types = reader->GetOffset() + reader->ReadS32();
-				meth.imp = reader->GetOffset() + reader->ReadS32();
+				auto nameOffset = reader->TryRead32();
+				auto typesOffset = reader->TryReadS32();
+				auto impOffset = reader->TryReadS32();
+				if (!nameOffset || !typesOffset || !impOffset)
+				{
+					m_logger->LogError("Failed to process a method at offset 0x%llx", cursor);
+					continue;
+				}
+				meth.name = selectorBaseOffset + *nameOffset;
+				meth.types = cursor + 4 + *typesOffset;
+				meth.imp = cursor + 8 + *impOffset;
 			}
 			else
 			{
-				meth.name = ReadPointerAccountingForRelocations(reader);
-				meth.types = ReadPointerAccountingForRelocations(reader);
-				meth.imp = ReadPointerAccountingForRelocations(reader);
+				auto name = TryReadPointerAccountingForRelocations(reader);
+				auto types = TryReadPointerAccountingForRelocations(reader);
+				auto imp = TryReadPointerAccountingForRelocations(reader);
+				if (!name || !types || !imp)
+				{
+					m_logger->LogError("Failed to process a method at offset 0x%llx", cursor);
+					continue;
+				}
+				meth.name = *name;
+				meth.types = *types;
+				meth.imp = *imp;
 			}
 			if (!relativeOffsets || directSelectors)
 			{
@@ -933,14 +949,29 @@ void DSCObjCProcessor::ReadIvarList(VMReader* reader, ClassBase& cls, std::strin
 			ivar_t ivarStruct;
 			uint64_t cursor = start + (sizeof(ivar_list_t)) + (i * ((addressSize * 3) + 8));
 			reader->Seek(cursor);
-			ivarStruct.offset = ReadPointerAccountingForRelocations(reader);
-			ivarStruct.name = ReadPointerAccountingForRelocations(reader);
-			ivarStruct.type = ReadPointerAccountingForRelocations(reader);
-			ivarStruct.alignmentRaw = reader->Read32();
-			ivarStruct.size = reader->Read32();
-
-			reader->Seek(ivarStruct.offset);
-			ivar.offset = reader->Read32();
+			auto offsetPtr = TryReadPointerAccountingForRelocations(reader);
+			auto namePtr = TryReadPointerAccountingForRelocations(reader);
+			auto typePtr = TryReadPointerAccountingForRelocations(reader);
+			auto alignmentRaw = reader->TryRead32();
+			auto size = reader->TryRead32();
+			if (!offsetPtr || !namePtr || !typePtr || !alignmentRaw || !size)
+			{
+				m_logger->LogError("Failed to process an ivar at offset 0x%llx", cursor);
+				continue;
+			}
+			ivarStruct.offset = *offsetPtr;
+			ivarStruct.name = *namePtr;
+			ivarStruct.type = *typePtr;
+			ivarStruct.alignmentRaw = *alignmentRaw;
+			ivarStruct.size = *size;
+
+			auto offset = reader->TryReadUInt32(ivarStruct.offset);
+			if (!offset)
+			{
+				m_logger->LogError("Failed to process an ivar at offset 0x%llx", cursor);
+				continue;
+			}
+			ivar.offset = *offset;
 			reader->Seek(ivarStruct.name);
 			ivar.name = reader->ReadCString(ivarStruct.name);
 			reader->Seek(ivarStruct.type);
@@ -1233,6 +1264,16 @@ uint64_t DSCObjCProcessor::ReadPointerAccountingForRelocations(VMReader* reader)
 	return reader->ReadPointer();
 }
 
+std::optional<uint64_t> DSCObjCProcessor::TryReadPointerAccountingForRelocations(VMReader* reader)
+{
+	if (auto it = m_relocationPointerRewrites.find(reader->GetOffset()); it != m_relocationPointerRewrites.end())
+	{
+		reader->SeekRelative(m_data->GetAddressSize());
+		return it->second;
+	}
+	return reader->TryReadPointer();
+}
+
 
 DSCObjCProcessor::DSCObjCProcessor(BinaryNinja::BinaryView* data, SharedCache* cache, bool isBackedByDatabase) :
 	m_isBackedByDatabase(isBackedByDatabase), m_data(data), m_cache(cache)
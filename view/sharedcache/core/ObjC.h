@@ -209,6 +209,7 @@ namespace DSCObjC {
 		SharedCacheCore::SharedCache* m_cache;
 
 		uint64_t ReadPointerAccountingForRelocations(VMReader* reader);
+		std::optional<uint64_t> TryReadPointerAccountingForRelocations(VMReader* reader);
 		std::unordered_map<uint64_t, uint64_t> m_relocationPointerRewrites;
 
 		static Ref<Metadata> SerializeMethod(uint64_t loc, const Method& method);
@@ -175,7 +175,7 @@ static int64_t readSLEB128(DataBuffer& buffer, size_t length, size_t& offset)
 #pragma clang diagnostic pop
 
 
-static uint64_t readLEB128(DataBuffer& p, size_t end, size_t& offset)
+static uint64_t readLEB128(const DataBufferView& p, size_t end, size_t& offset)
 {
 	uint64_t result = 0;
 	int bit = 0;
@@ -198,7 +198,7 @@ static uint64_t readLEB128(DataBuffer& p, size_t end, size_t& offset)
 }
 
 
-uint64_t readValidULEB128(DataBuffer& buffer, size_t& cursor)
+uint64_t readValidULEB128(const DataBufferView& buffer, size_t& cursor)
 {
 	uint64_t value = readLEB128(buffer, buffer.GetLength(), cursor);
 	if ((int64_t)value == -1)
@@ -1127,7 +1127,7 @@ void SharedCache::ParseAndApplySlideInfoForFile(std::shared_ptr<MMappedFileAcces
 				m_logger->LogDebug("Filename: %s", file->Path().c_str());
 				m_logger->LogDebug("Slide Info Offset: 0x%llx", slideInfoOffset);
 				m_logger->LogDebug("Mapping Address: 0x%llx", map.mappingInfo.address);
-				m_logger->LogDebug("Slide Info v", map.slideInfoVersion);
+				m_logger->LogDebug("Slide Info v%d", map.slideInfoVersion);
 			}
 		}
 	}
@@ -2594,7 +2594,7 @@ void SharedCache::InitializeHeader(
 		auto funcStarts =
 			vm->MappingAtAddress(header.linkeditSegment.vmaddr)
 				.first.fileAccessor->lock()
-				->ReadBuffer(header.functionStarts.funcoff, header.functionStarts.funcsize);
+				->ReadView(header.functionStarts.funcoff, header.functionStarts.funcsize);
 		size_t i = 0;
 		uint64_t curfunc = header.textBase;
 		uint64_t curOffset;
@@ -2629,7 +2629,7 @@ void SharedCache::InitializeHeader(
 
 		auto reader = vm->MappingAtAddress(header.linkeditSegment.vmaddr).first.fileAccessor->lock();
 		// auto symtab = reader->ReadBuffer(header.symtab.symoff, header.symtab.nsyms * sizeof(nlist_64));
-		auto strtab = reader->ReadBuffer(header.symtab.stroff, header.symtab.strsize);
+		auto strtab = reader->ReadView(header.symtab.stroff, header.symtab.strsize);
 		nlist_64 sym;
 		memset(&sym, 0, sizeof(sym));
 		auto N_TYPE = 0xE;	// idk
@@ -2764,7 +2764,7 @@ struct ExportNode
 };
 
 
-void SharedCache::ReadExportNode(std::vector<Ref<Symbol>>& symbolList, SharedCacheMachOHeader& header, DataBuffer& buffer, uint64_t textBase,
+void SharedCache::ReadExportNode(std::vector<Ref<Symbol>>& symbolList, SharedCacheMachOHeader& header, const DataBufferView& buffer, uint64_t textBase,
 	const std::string& currentText, size_t cursor, uint32_t endGuard)
 {
 
@@ -2840,7 +2840,7 @@ std::vector<Ref<Symbol>> SharedCache::ParseExportTrie(std::shared_ptr<MMappedFil
 
 		std::vector<ExportNode> nodes;
 
-		DataBuffer buffer = reader->ReadBuffer(header.exportTrie.dataoff, header.exportTrie.datasize);
+		DataBufferView buffer = reader->ReadView(header.exportTrie.dataoff, header.exportTrie.datasize);
 		ReadExportNode(symbols, header, buffer, header.textBase, "", 0, header.exportTrie.datasize);
 	}
 	catch (std::exception& e)
@@ -457,21 +457,32 @@ int64_t MMappedFileAccessor::ReadLong(size_t address)
 
 BinaryNinja::DataBuffer MMappedFileAccessor::ReadBuffer(size_t address, size_t length)
 {
-	if (address > m_mmap.len)
-		throw MappingReadException();
-	if (address + length > m_mmap.len)
+	if ((length > m_mmap.len) | (address > m_mmap.len - length))
 		throw MappingReadException();
 	void* data = (void*)(&(((uint8_t*)m_mmap._mmap)[address]));
 	return BinaryNinja::DataBuffer(data, length);
 }
 
-void MMappedFileAccessor::Read(void* dest, size_t address, size_t length)
+BinaryNinja::DataBufferView MMappedFileAccessor::ReadView(size_t address, size_t length)
 {
-	if (address > m_mmap.len)
+	if ((length > m_mmap.len) | (address > m_mmap.len - length))
 		throw MappingReadException();
-	if (address + length > m_mmap.len)
+	return BinaryNinja::DataBufferView(shared_from_this(), &(((uint8_t*)m_mmap._mmap)[address]), length);
+}
+
+void MMappedFileAccessor::Read(void* dest, size_t address, size_t length)
+{
+	if (!TryRead(dest, address, length))
 		throw MappingReadException();
+}
+
+bool MMappedFileAccessor::TryRead(void* dest, size_t address, size_t length)
+{
+	// `len - length` is only evaluated once `length <= len` is known, so it cannot wrap
+	if (length > m_mmap.len || address > m_mmap.len - length)
+		return false;
 	memcpy(dest, (void*)&(((uint8_t*)m_mmap._mmap)[address]), length);
+	return true;
 }
 
 
@@ -641,6 +652,12 @@ BinaryNinja::DataBuffer VM::ReadBuffer(size_t addr, size_t length)
 	return mapping.first.fileAccessor->lock()->ReadBuffer(mapping.second, length);
 }
 
+BinaryNinja::DataBufferView VM::ReadView(size_t addr, size_t length)
+{
+	auto mapping = MappingAtAddress(addr);
+	return mapping.first.fileAccessor->lock()->ReadView(mapping.second, length);
+}
+
 
 void VM::Read(void* dest, size_t addr, size_t length)
 {
@@ -648,6 +665,17 @@ void VM::Read(void* dest, size_t addr, size_t length)
 	mapping.first.fileAccessor->lock()->Read(dest, mapping.second, length);
 }
 
+
+bool VM::TryRead(void* dest, size_t addr, size_t length)
+{
+	// Look the mapping up in place rather than through MappingAtAddress to avoid copying the PageMapping.
+	auto it = m_map.find(addr);
+	if (it == m_map.end())
+		return false;
+	auto& mapping = it->second;
+	return mapping.fileAccessor->lock()->TryRead(dest, mapping.fileOffset + (addr - it->first.start), length);
+}
+
 VMReader::VMReader(std::shared_ptr<VM> vm, size_t addressSize) : m_vm(vm), m_cursor(0), m_addressSize(addressSize) {}
 
 
@@ -830,3 +858,76 @@ int64_t VMReader::ReadS64()
 	m_cursor += 8;
 	return mapping.first.fileAccessor->lock()->ReadLong(mapping.second);
 }
+
+
+template <typename T>
+std::optional<T> VMReader::TryReadValue(size_t address)
+{
+	T result;
+	if (!m_vm->TryRead(&result, address, sizeof(T)))
+		return std::nullopt;
+	m_cursor = address + sizeof(T);
+	return result;
+}
+
+std::optional<uint8_t> VMReader::TryRead8()
+{
+	return TryReadValue<uint8_t>(m_cursor);
+}
+
+std::optional<uint16_t> VMReader::TryRead16()
+{
+	return TryReadValue<uint16_t>(m_cursor);
+}
+
+std::optional<uint32_t> VMReader::TryRead32()
+{
+	return TryReadValue<uint32_t>(m_cursor);
+}
+
+std::optional<int32_t> VMReader::TryReadS32()
+{
+	return TryReadValue<int32_t>(m_cursor);
+}
+
+std::optional<uint64_t> VMReader::TryRead64()
+{
+	return TryReadValue<uint64_t>(m_cursor);
+}
+
+std::optional<size_t> VMReader::TryReadPointer()
+{
+	return TryReadPointer(m_cursor);
+}
+
+std::optional<uint32_t> VMReader::TryReadUInt32(size_t address)
+{
+	return TryReadValue<uint32_t>(address);
+}
+
+std::optional<uint64_t> VMReader::TryReadULong(size_t address)
+{
+	return TryReadValue<uint64_t>(address);
+}
+
+std::optional<size_t> VMReader::TryReadPointer(size_t address)
+{
+	if (m_addressSize == 8)
+		return TryReadValue<uint64_t>(address);
+	else if (m_addressSize == 4)
+		return TryReadValue<uint32_t>(address);
+	return std::nullopt;
+}
+
+bool VMReader::TryRead(void* dest, size_t length)
+{
+	return TryRead(dest, m_cursor, length);
+}
+
+bool VMReader::TryRead(void* dest, size_t addr, size_t length)
+{
+	if (!m_vm->TryRead(dest, addr, length))
+		return false;
+	m_cursor = addr + length;
+	return true;
+}
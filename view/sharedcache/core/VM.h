@@ -127,7 +127,7 @@ static counting_semaphore fileAccessorSemaphore(0);
 
 static std::atomic<uint64_t> mmapCount = 0;
 
-class MMappedFileAccessor {
+class MMappedFileAccessor : public std::enable_shared_from_this<MMappedFileAccessor> {
     std::string m_path;
     MMAP m_mmap;
 	bool m_slideInfoWasApplied = false;
@@ -187,7 +187,12 @@ public:
 
     BinaryNinja::DataBuffer ReadBuffer(size_t addr, size_t length);
 
+    // Returns a view directly over the mapped file without copying. The view keeps this accessor alive.
+    BinaryNinja::DataBufferView ReadView(size_t addr, size_t length);
+
     void Read(void *dest, size_t addr, size_t length);
+
+    bool TryRead(void *dest, size_t addr, size_t length);
 };
 
 
@@ -287,7 +292,12 @@ public:
 
     BinaryNinja::DataBuffer ReadBuffer(size_t addr, size_t length);
 
+    // Returns a view directly over the mapped file without copying. The view keeps this accessor alive.
+    BinaryNinja::DataBufferView ReadView(size_t addr, size_t length);
+
     void Read(void *dest, size_t addr, size_t length);
+
+    bool TryRead(void *dest, size_t addr, size_t length);
 };
 
 
@@ -298,6 +308,9 @@ class VMReader {
 
 	BNEndianness m_endianness = LittleEndian;
 
+    template <typename T>
+    std::optional<T> TryReadValue(size_t address);
+
 public:
     VMReader(std::shared_ptr<VM> vm, size_t addressSize = 8);
 
@@ -360,6 +373,31 @@ public:
     void Read(void *dest, size_t length);
 
     void Read(void *dest, size_t addr, size_t length);
+
+    // Non-throwing variants for heuristic scanners that probe addresses which may not be mapped.
+    // On failure the cursor is left untouched.
+
+    std::optional<uint8_t> TryRead8();
+
+    std::optional<uint16_t> TryRead16();
+
+    std::optional<uint32_t> TryRead32();
+
+    std::optional<int32_t> TryReadS32();
+
+    std::optional<uint64_t> TryRead64();
+
+    std::optional<size_t> TryReadPointer();
+
+    std::optional<uint32_t> TryReadUInt32(size_t address);
+
+    std::optional<uint64_t> TryReadULong(size_t address);
+
+    std::optional<size_t> TryReadPointer(size_t address);
+
+    bool TryRead(void *dest, size_t length);
+
+    bool TryRead(void *dest, size_t addr, size_t length);
 };
 
 #endif //SHAREDCACHE_VM_H
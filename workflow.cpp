@@ -1,6 +1,8 @@
 #include "binaryninjaapi.h"
 #include "json/json.h"
 #include "rapidjsonwrapper.h"
+#include <cinttypes>
+#include <cstdio>
 #include <string>
 #include <variant>
 
@@ -110,6 +112,87 @@ bool AnalysisContext::Inform(const string& request)
 }
 
 
+static void AppendJsonString(string& out, string_view str)
+{
+	out.push_back('"');
+	for (char c : str)
+	{
+		switch (c)
+		{
+		case '"':
+			out.append("\\\"");
+			break;
+		case '\\':
+			out.append("\\\\");
+			break;
+		case '\n':
+			out.append("\\n");
+			break;
+		case '\r':
+			out.append("\\r");
+			break;
+		case '\t':
+			out.append("\\t");
+			break;
+		default:
+			if ((unsigned char)c < 0x20)
+			{
+				char escaped[8];
+				snprintf(escaped, sizeof(escaped), "\\u%04x", (unsigned char)c);
+				out.append(escaped);
+			}
+			else
+			{
+				out.push_back(c);
+			}
+			break;
+		}
+	}
+	out.push_back('"');
+}
+
+
+void AnalysisContext::SerializeInformRequest(const InformArgument* args, size_t count, string& request)
+{
+	request.clear();
+	request.push_back('[');
+	for (size_t i = 0; i < count; i++)
+	{
+		if (i != 0)
+			request.push_back(',');
+		switch (args[i].GetKind())
+		{
+		case InformArgument::StringArgument:
+			AppendJsonString(request, args[i].GetString());
+			break;
+		case InformArgument::IntegerArgument:
+		{
+			char value[24];
+			snprintf(value, sizeof(value), "%" PRIu64, args[i].GetInteger());
+			request.append(value);
+			break;
+		}
+		case InformArgument::ArchitectureArgument:
+			if (args[i].GetArchitecture())
+				AppendJsonString(request, args[i].GetArchitecture()->GetName());
+			else
+				request.append("null");
+			break;
+		}
+	}
+	request.push_back(']');
+}
+
+
+bool AnalysisContext::InformArguments(const InformArgument* args, size_t count)
+{
+	// Requests are small and frequent, so serialize them into a per-thread buffer that keeps its capacity
+	thread_local string request;
+	SerializeInformRequest(args, count, request);
+	return BNAnalysisContextInform(m_object, request.c_str());
+}
+
+
 WorkflowMachine::WorkflowMachine(Ref<BinaryView> view): m_view(view)
 {
 